@@ -74,6 +74,32 @@ int pippenger()
     return 0;
 }
 
+// Commit to four polynomials (e.g. the four wires) against the same monomials, one MSM at a time and all at once.
+int pippenger_multi()
+{
+    constexpr size_t NUM_VECTORS = 4;
+    std::vector<fr*> scalar_vectors;
+    for (size_t i = 0; i < NUM_VECTORS; ++i) {
+        scalar_vectors.push_back(&scalars[i * NUM_POINTS]);
+    }
+    scalar_multiplication::pippenger_runtime_state state(NUM_POINTS);
+
+    std::chrono::steady_clock::time_point time_start = std::chrono::steady_clock::now();
+    for (auto* vector_scalars : scalar_vectors) {
+        scalar_multiplication::pippenger_unsafe(vector_scalars, reference_string->get_monomials(), NUM_POINTS, state);
+    }
+    std::chrono::steady_clock::time_point time_end = std::chrono::steady_clock::now();
+    std::chrono::microseconds diff = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start);
+    std::cout << "separate run time: " << diff.count() << "us" << std::endl;
+
+    time_start = std::chrono::steady_clock::now();
+    scalar_multiplication::pippenger_unsafe_multi(scalar_vectors, reference_string->get_monomials(), NUM_POINTS, state);
+    time_end = std::chrono::steady_clock::now();
+    diff = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start);
+    std::cout << "multi-vector run time: " << diff.count() << "us" << std::endl;
+    return 0;
+}
+
 int coset_fft_split()
 {
     std::chrono::steady_clock::time_point time_start = std::chrono::steady_clock::now();
@@ -108,5 +134,7 @@ int main()
     pippenger();
     pippenger();
     pippenger();
+    std::cout << "executing multi-vector pippenger algorithm" << std::endl;
+    pippenger_multi();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+Compare two Google Benchmark JSON outputs, e.g. of prover_rounds_bench at two commits.
+
+Prints the change in time of every benchmark present in both, and exits with status 1 if any got slower by more than
+the threshold. Thresholds can be set per benchmark with --threshold <regex>=<fraction>; the last matching one wins.
+
+    compare_benchmarks.py [--threshold 0.1] [--threshold 'msm_.*=0.05'] baseline.json current.json
+"""
+import argparse
+import json
+import re
+import sys
+
+
+def load(filename):
+    with open(filename) as f:
+        benchmarks = json.load(f)["benchmarks"]
+    # Repetitions report their aggregates under the same name; compare the mean if there is one.
+    times = {}
+    for b in benchmarks:
+        if b.get("run_type") == "aggregate" and b.get("aggregate_name") != "mean":
+            continue
+        times[b.get("run_name", b["name"])] = (b["real_time"], b["time_unit"])
+    return times
+
+
+UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--threshold", action="append", default=[])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    args = parser.parse_args()
+
+    default_threshold = 0.1
+    thresholds = []
+    for t in args.threshold:
+        if "=" in t:
+            pattern, value = t.rsplit("=", 1)
+            thresholds.append((re.compile(pattern), float(value)))
+        else:
+            default_threshold = float(t)
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = []
+    width = max((len(name) for name in current), default=0)
+    for name, (time, unit) in current.items():
+        if name not in baseline:
+            print(f"{name:<{width}}  {time:>12.3f}{unit}  (new)")
+            continue
+        base_time, base_unit = baseline[name]
+        seconds = time * UNITS[unit]
+        base_seconds = base_time * UNITS[base_unit]
+        change = seconds / base_seconds - 1 if base_seconds > 0 else 0.0
+
+        threshold = default_threshold
+        for pattern, value in thresholds:
+            if pattern.fullmatch(name):
+                threshold = value
+        regressed = change > threshold
+        if regressed:
+            regressions.append(name)
+        print(f"{name:<{width}}  {base_time:>12.3f}{base_unit} -> {time:>12.3f}{unit}  {change:+8.1%}"
+              f"{'  REGRESSION' if regressed else ''}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) slower than their threshold.")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,376 @@
+/**
+ * Per-stage prover benchmarks.
+ *
+ * Breaks a proof down into proving key construction and loading, each `execute_*_round` (including processing the
+ * work queue it fills), each widget's quotient contribution and each scalar multiplication in the work queue, for the
+ * standard, turbo and plookup composers, across circuit sizes and thread counts. Every benchmark is named
+ * `<composer>/<stage>/log_n:<k>/threads:<t>`, and reports the time taken by its stage alone.
+ *
+ * Flags, on top of Google Benchmark's own:
+ *   --min_log_n=12 --max_log_n=22   Range of circuit sizes.
+ *   --threads=1,8                   Thread counts. Defaults to 1 and the maximum.
+ *
+ * Write machine readable results with `--benchmark_out=<file> --benchmark_out_format=json`, and compare two runs with
+ * `compare_benchmarks.py` (see `run_prover_rounds_bench` and `check_prover_rounds_bench`).
+ */
+#include <benchmark/benchmark.h>
+#include <common/timer.hpp>
+#include <ecc/curves/bn254/scalar_multiplication/scalar_multiplication.hpp>
+#include <plonk/composer/plookup_composer.hpp>
+#include <plonk/composer/standard_composer.hpp>
+#include <plonk/composer/turbo_composer.hpp>
+#include <plonk/proof_system/proving_key/mmap_file.hpp>
+#include <plonk/proof_system/proving_key/serialize.hpp>
+#include <stdlib/primitives/field/field.hpp>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <unistd.h>
+#ifndef NO_MULTITHREADING
+#include <omp.h>
+#endif
+
+using namespace benchmark;
+
+namespace {
+
+size_t min_log_n = 12;
+size_t max_log_n = 22;
+std::vector<size_t> thread_counts;
+
+// The number of rounds run by `construct_proof`, starting with the preamble round.
+constexpr size_t NUM_ROUNDS = 7;
+// The quotient is computed in the round at this index.
+constexpr size_t QUOTIENT_ROUND = 4;
+
+template <typename Composer> void generate_test_plonk_circuit(Composer& composer, size_t num_gates)
+{
+    plonk::stdlib::field_t a(plonk::stdlib::witness_t(&composer, barretenberg::fr::random_element()));
+    plonk::stdlib::field_t b(plonk::stdlib::witness_t(&composer, barretenberg::fr::random_element()));
+    plonk::stdlib::field_t c(&composer);
+    for (size_t i = 0; i < (num_gates / 4) - 4; ++i) {
+        c = a + b;
+        c = a * c;
+        a = b * b;
+        b = c * c;
+    }
+}
+
+void set_num_threads(const size_t num_threads)
+{
+#ifndef NO_MULTITHREADING
+    omp_set_num_threads(static_cast<int>(num_threads));
+#else
+    static_cast<void>(num_threads);
+#endif
+}
+
+// Frees the fixture kept by `prover_fixture::get`, whichever composer it is for.
+std::function<void()> release_fixture = []() {};
+
+/**
+ * A circuit of 2^log_n gates and a prover for it. Building one takes longer than most of the stages it is used to
+ * measure, so the last one is kept around for the benchmarks of the same composer and size that follow it.
+ */
+template <typename Composer> struct prover_fixture {
+    using Prover = decltype(std::declval<Composer>().create_prover());
+
+    prover_fixture(const size_t log_n)
+        : log_n(log_n)
+    {
+        generate_test_plonk_circuit(composer, 1UL << log_n);
+        prover = std::make_unique<Prover>(composer.create_prover());
+    }
+
+    static prover_fixture& get(const size_t log_n)
+    {
+        static std::unique_ptr<prover_fixture> fixture;
+        if (!fixture || fixture->log_n != log_n) {
+            // Free the old circuit first, the largest ones take most of the memory of a machine.
+            release_fixture();
+            fixture = std::make_unique<prover_fixture>(log_n);
+            release_fixture = []() { fixture.reset(); };
+        }
+        return *fixture;
+    }
+
+    void execute_round(const size_t round)
+    {
+        switch (round) {
+        case 0:
+            prover->execute_preamble_round();
+            break;
+        case 1:
+            prover->execute_first_round();
+            break;
+        case 2:
+            prover->execute_second_round();
+            break;
+        case 3:
+            prover->execute_third_round();
+            break;
+        case 4:
+            prover->execute_fourth_round();
+            break;
+        case 5:
+            prover->execute_fifth_round();
+            break;
+        default:
+            prover->execute_sixth_round();
+            break;
+        }
+    }
+
+    // Start a new proof, and run its rounds up to but not including `round`, as `construct_proof` does.
+    void run_rounds_before(const size_t round)
+    {
+        prover->reset();
+        for (size_t i = 0; i < round; ++i) {
+            execute_round(i);
+            prover->queue->process_queue();
+        }
+    }
+
+    // Run the quotient round up to the point where the widgets add their contributions.
+    void prepare_quotient()
+    {
+        run_rounds_before(QUOTIENT_ROUND);
+        prover->queue->flush_queue();
+        prover->transcript.apply_fiat_shamir("alpha");
+        prover->key->compute_missing_selector_ffts();
+    }
+
+    barretenberg::fr get_alpha() const
+    {
+        return barretenberg::fr::serialize_from_buffer(prover->transcript.get_challenge("alpha").begin());
+    }
+
+    size_t log_n;
+    Composer composer;
+    std::unique_ptr<Prover> prover;
+};
+
+template <typename Composer> void key_construct_bench(State& state, const size_t log_n, const size_t num_threads)
+{
+    set_num_threads(num_threads);
+    typename Composer::proving_key_timings key_timings;
+    for (auto _ : state) {
+        Composer composer;
+        generate_test_plonk_circuit(composer, 1UL << log_n);
+        Timer timer;
+        composer.compute_proving_key();
+        state.SetIterationTime(timer.seconds());
+        key_timings = composer.key_timings;
+    }
+    state.counters["selectors_s"] = key_timings.selectors;
+    state.counters["copy_cycles_s"] = key_timings.copy_cycles;
+    state.counters["sigma_permutations_s"] = key_timings.sigma_permutations;
+}
+
+template <typename Composer>
+void key_load_bench(State& state, const size_t log_n, const size_t num_threads, const bool mmap)
+{
+    set_num_threads(num_threads);
+    auto& fixture = prover_fixture<Composer>::get(log_n);
+    auto& key = *fixture.prover->key;
+    auto crs = fixture.composer.crs_factory_->get_prover_crs(key.n);
+
+    const std::string filename = "prover_rounds_bench." + std::to_string(getpid()) + ".pk";
+    std::string buffer;
+    if (mmap) {
+        waffle::write_mmap_file(filename, key);
+    } else {
+        std::ostringstream os;
+        write(os, key);
+        buffer = os.str();
+    }
+    for (auto _ : state) {
+        Timer timer;
+        waffle::proving_key_data data;
+        if (mmap) {
+            waffle::read_mmap_file(filename, data);
+        } else {
+            std::istringstream is(buffer);
+            read(static_cast<std::istream&>(is), data);
+        }
+        auto loaded = std::make_shared<waffle::proving_key>(std::move(data), crs);
+        state.SetIterationTime(timer.seconds());
+        DoNotOptimize(loaded);
+    }
+    std::remove(filename.c_str());
+}
+
+template <typename Composer> void round_bench(State& state, const size_t log_n, const size_t num_threads, size_t round)
+{
+    set_num_threads(num_threads);
+    auto& fixture = prover_fixture<Composer>::get(log_n);
+    for (auto _ : state) {
+        fixture.run_rounds_before(round);
+        Timer timer;
+        fixture.execute_round(round);
+        fixture.prover->queue->process_queue();
+        state.SetIterationTime(timer.seconds());
+    }
+}
+
+// `widget` indexes the prover's random widgets followed by its transition widgets.
+template <typename Composer>
+void widget_bench(State& state, const size_t log_n, const size_t num_threads, const size_t widget)
+{
+    set_num_threads(num_threads);
+    auto& fixture = prover_fixture<Composer>::get(log_n);
+    auto& prover = *fixture.prover;
+    const size_t end = prover.key->large_domain.size;
+    for (auto _ : state) {
+        fixture.prepare_quotient();
+        Timer timer;
+        if (widget < prover.random_widgets.size()) {
+            prover.random_widgets[widget]->compute_quotient_contribution(fixture.get_alpha(), prover.transcript, 0, end);
+        } else {
+            prover.transition_widgets[widget - prover.random_widgets.size()]->compute_quotient_contribution(
+                fixture.get_alpha(), prover.transcript, 0, end);
+        }
+        state.SetIterationTime(timer.seconds());
+    }
+}
+
+/**
+ * The work queue batches the scalar multiplications it can, so this runs the one tagged `tag` on its own, on the
+ * scalars the prover queued for it.
+ */
+template <typename Composer>
+void msm_bench(State& state, const size_t log_n, const size_t num_threads, std::string const& tag)
+{
+    set_num_threads(num_threads);
+    auto& fixture = prover_fixture<Composer>::get(log_n);
+    auto& prover = *fixture.prover;
+    for (auto _ : state) {
+        double seconds = 0;
+        prover.reset();
+        for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+            fixture.execute_round(round);
+            for (auto const& item : prover.queue->get_queue()) {
+                if (item.work_type != waffle::work_queue::WorkType::SCALAR_MULTIPLICATION || item.tag != tag) {
+                    continue;
+                }
+                const size_t num_points = prover.key->n + (item.constant == waffle::work_queue::MSMSize::N ? 0 : 1);
+                barretenberg::scalar_multiplication::pippenger_runtime_state runtime_state(num_points);
+                Timer timer;
+                auto result = barretenberg::scalar_multiplication::pippenger_unsafe(
+                    item.mul_scalars, prover.key->reference_string->get_monomials(), num_points, runtime_state);
+                seconds += timer.seconds();
+                DoNotOptimize(result);
+            }
+            prover.queue->process_queue();
+        }
+        state.SetIterationTime(seconds);
+    }
+}
+
+/**
+ * The tags of the scalar multiplications a proof queues, and the number of widgets of its prover, found by running a
+ * proof of the smallest size.
+ */
+template <typename Composer> std::pair<std::vector<std::string>, size_t> get_prover_stages()
+{
+    auto& fixture = prover_fixture<Composer>::get(min_log_n);
+    auto& prover = *fixture.prover;
+    std::vector<std::string> tags;
+    prover.reset();
+    for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+        fixture.execute_round(round);
+        for (auto const& item : prover.queue->get_queue()) {
+            if (item.work_type == waffle::work_queue::WorkType::SCALAR_MULTIPLICATION) {
+                tags.push_back(item.tag);
+            }
+        }
+        prover.queue->process_queue();
+    }
+    return { tags, prover.random_widgets.size() + prover.transition_widgets.size() };
+}
+
+template <typename Composer> void register_benchmarks(std::string const& composer_name)
+{
+    const auto [tags, num_widgets] = get_prover_stages<Composer>();
+
+    // Benchmarks run in registration order, so those sharing a fixture are registered together.
+    for (size_t log_n = min_log_n; log_n <= max_log_n; ++log_n) {
+        for (const size_t num_threads : thread_counts) {
+            const std::string suffix = "/log_n:" + std::to_string(log_n) + "/threads:" + std::to_string(num_threads);
+            std::vector<internal::Benchmark*> benchmarks;
+            const auto add = [&](std::string const& stage, auto&& fn) {
+                benchmarks.push_back(RegisterBenchmark((composer_name + "/" + stage + suffix).c_str(), fn));
+            };
+
+            add("key_construct", [=](State& state) { key_construct_bench<Composer>(state, log_n, num_threads); });
+            add("key_load_stream",
+                [=](State& state) { key_load_bench<Composer>(state, log_n, num_threads, false); });
+            add("key_load_mmap", [=](State& state) { key_load_bench<Composer>(state, log_n, num_threads, true); });
+            for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+                add("round_" + std::to_string(round),
+                    [=](State& state) { round_bench<Composer>(state, log_n, num_threads, round); });
+            }
+            for (size_t widget = 0; widget < num_widgets; ++widget) {
+                add("widget_" + std::to_string(widget),
+                    [=](State& state) { widget_bench<Composer>(state, log_n, num_threads, widget); });
+            }
+            for (auto const& tag : tags) {
+                add("msm_" + tag, [=](State& state) { msm_bench<Composer>(state, log_n, num_threads, tag); });
+            }
+            for (auto* benchmark : benchmarks) {
+                benchmark->UseManualTime()->Unit(kMillisecond);
+            }
+        }
+    }
+}
+
+// Consume the flags of this benchmark, leaving the rest to Google Benchmark.
+void parse_flags(int& argc, char** argv)
+{
+    int out = 1;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto value = [&](std::string const& flag) { return arg.substr(flag.size()); };
+        if (arg.rfind("--min_log_n=", 0) == 0) {
+            min_log_n = std::stoul(value("--min_log_n="));
+        } else if (arg.rfind("--max_log_n=", 0) == 0) {
+            max_log_n = std::stoul(value("--max_log_n="));
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            std::istringstream list(value("--threads="));
+            for (std::string count; std::getline(list, count, ',');) {
+                thread_counts.push_back(std::stoul(count));
+            }
+        } else {
+            argv[out++] = argv[i];
+        }
+    }
+    argc = out;
+
+    if (thread_counts.empty()) {
+        thread_counts.push_back(1);
+#ifndef NO_MULTITHREADING
+        const auto max_threads = static_cast<size_t>(omp_get_max_threads());
+        if (max_threads > 1) {
+            thread_counts.push_back(max_threads);
+        }
+#endif
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    parse_flags(argc, argv);
+    Initialize(&argc, argv);
+    if (ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    register_benchmarks<waffle::StandardComposer>("standard");
+    register_benchmarks<waffle::TurboComposer>("turbo");
+    register_benchmarks<waffle::PlookupComposer>("plookup");
+    RunSpecifiedBenchmarks();
+    Shutdown();
+    return 0;
+}
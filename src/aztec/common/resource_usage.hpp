@@ -0,0 +1,33 @@
+#pragma once
+#include <stddef.h>
+#include <sys/resource.h>
+
+/**
+ * Memory and storage I/O used by this process so far, as reported by getrusage.
+ **/
+struct ResourceUsage {
+    // High-water mark of the resident set, in bytes
+    size_t peak_resident_bytes = 0;
+    // Bytes read from and written to storage (not counting reads served by the page cache)
+    size_t bytes_read = 0;
+    size_t bytes_written = 0;
+
+    static ResourceUsage get()
+    {
+        ResourceUsage result;
+#ifndef __wasm__
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            // ru_maxrss is in kilobytes (bytes on macOS), block counts are in units of 512 bytes
+#ifdef __APPLE__
+            result.peak_resident_bytes = static_cast<size_t>(usage.ru_maxrss);
+#else
+            result.peak_resident_bytes = static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+            result.bytes_read = static_cast<size_t>(usage.ru_inblock) * 512;
+            result.bytes_written = static_cast<size_t>(usage.ru_oublock) * 512;
+        }
+#endif
+        return result;
+    }
+};
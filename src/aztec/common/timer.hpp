@@ -21,7 +21,7 @@ class Timer {
 
     void end() { clock_gettime(CLOCK_REALTIME, &_endTime); }
 
-    std::string toString() const
+    double seconds() const
     {
         struct timespec endTime;
         if (_endTime.tv_nsec == 0 && _endTime.tv_sec == 0) {
@@ -30,14 +30,16 @@ class Timer {
             endTime = _endTime;
         }
 
-        auto seconds = endTime.tv_sec - _startTime.tv_sec;
+        auto secs = endTime.tv_sec - _startTime.tv_sec;
         auto ns = endTime.tv_nsec - _startTime.tv_nsec;
 
         if (_startTime.tv_nsec > endTime.tv_nsec) { // clock underflow
-            --seconds;
+            --secs;
             ns += 1000000000;
         }
 
-        return std::to_string((double)seconds + (double)ns / (double)1000000000);
+        return (double)secs + (double)ns / (double)1000000000;
     }
+
+    std::string toString() const { return std::to_string(seconds()); }
 };
\ No newline at end of file
@@ -19,6 +19,22 @@
 
 #include "blake2-impl.hpp"
 #include "blake2s.hpp"
+#include <algorithm>
+#include <array>
+
+#if defined(__x86_64__) && !defined(__wasm__) && !defined(DISABLE_SHENANIGANS)
+#define BBERG_BLAKE2S_SIMD 1
+// GCC 12 reports false positives inside the AVX-512 shift intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#define BBERG_AVX2 __attribute__((target("avx2"), always_inline)) inline
+#define BBERG_AVX512F __attribute__((target("avx512f"), always_inline)) inline
+#else
+#define BBERG_BLAKE2S_SIMD 0
+#endif
 
 namespace blake2 {
 
@@ -233,4 +249,242 @@ std::vector<uint8_t> blake2s(std::vector<uint8_t> const& input)
     return output;
 }
 
+namespace {
+
+#if BBERG_BLAKE2S_SIMD
+/* Runtime CPU dispatch, evaluated once */
+bool has_avx2() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+bool has_avx512f() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("avx512f");
+    return supported;
+}
+
+/* One round of `blake2s_compress`, with `g` applied to the vectors v[] and m[] */
+#define ROUND_LANES(g, r)                                                                                              \
+    do {                                                                                                               \
+        g(v[0], v[4], v[8], v[12], m[blake2s_sigma[r][0]], m[blake2s_sigma[r][1]]);                                    \
+        g(v[1], v[5], v[9], v[13], m[blake2s_sigma[r][2]], m[blake2s_sigma[r][3]]);                                    \
+        g(v[2], v[6], v[10], v[14], m[blake2s_sigma[r][4]], m[blake2s_sigma[r][5]]);                                   \
+        g(v[3], v[7], v[11], v[15], m[blake2s_sigma[r][6]], m[blake2s_sigma[r][7]]);                                   \
+        g(v[0], v[5], v[10], v[15], m[blake2s_sigma[r][8]], m[blake2s_sigma[r][9]]);                                   \
+        g(v[1], v[6], v[11], v[12], m[blake2s_sigma[r][10]], m[blake2s_sigma[r][11]]);                                 \
+        g(v[2], v[7], v[8], v[13], m[blake2s_sigma[r][12]], m[blake2s_sigma[r][13]]);                                  \
+        g(v[3], v[4], v[9], v[14], m[blake2s_sigma[r][14]], m[blake2s_sigma[r][15]]);                                  \
+    } while (0)
+
+template <int N> BBERG_AVX2 __m256i rotr32_avx2(__m256i x)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+/* Rotations by whole bytes are a single shuffle */
+template <> BBERG_AVX2 __m256i rotr32_avx2<16>(__m256i x)
+{
+    const __m256i rotate = _mm256_setr_epi8(
+        2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    return _mm256_shuffle_epi8(x, rotate);
+}
+
+template <> BBERG_AVX2 __m256i rotr32_avx2<8>(__m256i x)
+{
+    const __m256i rotate = _mm256_setr_epi8(
+        1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12, 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    return _mm256_shuffle_epi8(x, rotate);
+}
+
+BBERG_AVX2 void g_avx2(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i x, __m256i y)
+{
+    a = _mm256_add_epi32(_mm256_add_epi32(a, b), x);
+    d = rotr32_avx2<16>(_mm256_xor_si256(d, a));
+    c = _mm256_add_epi32(c, d);
+    b = rotr32_avx2<12>(_mm256_xor_si256(b, c));
+    a = _mm256_add_epi32(_mm256_add_epi32(a, b), y);
+    d = rotr32_avx2<8>(_mm256_xor_si256(d, a));
+    c = _mm256_add_epi32(c, d);
+    b = rotr32_avx2<7>(_mm256_xor_si256(b, c));
+}
+
+/*
+ * `blake2s_compress` on the 8 states h[][j], with message words words[][j], and counters t[0][j], t[1][j] and
+ * f[j]
+ */
+__attribute__((target("avx2"))) void compress_avx2(uint32_t (&h)[8][8],
+                                                   const uint32_t (&words)[16][8],
+                                                   const uint32_t (&t)[2][8],
+                                                   const uint32_t (&f)[8])
+{
+    __m256i m[16];
+    for (size_t i = 0; i < 16; ++i) {
+        m[i] = _mm256_load_si256((const __m256i*)words[i]);
+    }
+    __m256i v[16];
+    for (size_t i = 0; i < 8; ++i) {
+        v[i] = _mm256_load_si256((const __m256i*)h[i]);
+        v[i + 8] = _mm256_set1_epi32((int)blake2s_IV[i]);
+    }
+    v[12] = _mm256_xor_si256(v[12], _mm256_load_si256((const __m256i*)t[0]));
+    v[13] = _mm256_xor_si256(v[13], _mm256_load_si256((const __m256i*)t[1]));
+    v[14] = _mm256_xor_si256(v[14], _mm256_load_si256((const __m256i*)f));
+
+    for (size_t r = 0; r < 10; ++r) {
+        ROUND_LANES(g_avx2, r);
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        const __m256i state = _mm256_load_si256((const __m256i*)h[i]);
+        _mm256_store_si256((__m256i*)h[i], _mm256_xor_si256(state, _mm256_xor_si256(v[i], v[i + 8])));
+    }
+}
+
+BBERG_AVX512F void g_avx512(__m512i& a, __m512i& b, __m512i& c, __m512i& d, __m512i x, __m512i y)
+{
+    a = _mm512_add_epi32(_mm512_add_epi32(a, b), x);
+    d = _mm512_ror_epi32(_mm512_xor_si512(d, a), 16);
+    c = _mm512_add_epi32(c, d);
+    b = _mm512_ror_epi32(_mm512_xor_si512(b, c), 12);
+    a = _mm512_add_epi32(_mm512_add_epi32(a, b), y);
+    d = _mm512_ror_epi32(_mm512_xor_si512(d, a), 8);
+    c = _mm512_add_epi32(c, d);
+    b = _mm512_ror_epi32(_mm512_xor_si512(b, c), 7);
+}
+
+/* As `compress_avx2`, on 16 states */
+__attribute__((target("avx512f"))) void compress_avx512(uint32_t (&h)[8][16],
+                                                        const uint32_t (&words)[16][16],
+                                                        const uint32_t (&t)[2][16],
+                                                        const uint32_t (&f)[16])
+{
+    __m512i m[16];
+    for (size_t i = 0; i < 16; ++i) {
+        m[i] = _mm512_load_si512(words[i]);
+    }
+    __m512i v[16];
+    for (size_t i = 0; i < 8; ++i) {
+        v[i] = _mm512_load_si512(h[i]);
+        v[i + 8] = _mm512_set1_epi32((int)blake2s_IV[i]);
+    }
+    v[12] = _mm512_xor_si512(v[12], _mm512_load_si512(t[0]));
+    v[13] = _mm512_xor_si512(v[13], _mm512_load_si512(t[1]));
+    v[14] = _mm512_xor_si512(v[14], _mm512_load_si512(f));
+
+    for (size_t r = 0; r < 10; ++r) {
+        ROUND_LANES(g_avx512, r);
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        const __m512i state = _mm512_load_si512(h[i]);
+        _mm512_store_si512(h[i], _mm512_xor_si512(state, _mm512_xor_si512(v[i], v[i + 8])));
+    }
+}
+
+#undef ROUND_LANES
+#endif
+
+/*
+ * Hash `inputs` with a kernel that compresses one block of each of `LANES` messages at a time.
+ *
+ * Each lane hashes one message. When it has compressed the last block, it writes the digest and starts on the next
+ * message. Once the messages run out, idle lanes compress zero blocks into states nobody reads.
+ */
+template <size_t LANES, typename Compress>
+std::vector<std::vector<uint8_t>> blake2s_multi_buffer(std::vector<std::vector<uint8_t>> const& inputs,
+                                                       Compress compress_lanes)
+{
+    std::vector<std::vector<uint8_t>> outputs(inputs.size());
+    alignas(64) uint32_t h[8][LANES];
+    alignas(64) uint32_t words[16][LANES];
+    alignas(64) uint32_t t[2][LANES];
+    alignas(64) uint32_t f[LANES];
+
+    /* The index in `inputs` of the message each lane is hashing, and how much of it has been compressed */
+    std::array<size_t, LANES> message_index{};
+    std::array<size_t, LANES> offset{};
+    std::array<bool, LANES> active{};
+    size_t next_message = 0;
+    size_t num_active = 0;
+
+    const auto start_next_message = [&](const size_t lane) {
+        active[lane] = next_message < inputs.size();
+        if (!active[lane]) {
+            return;
+        }
+        message_index[lane] = next_message++;
+        offset[lane] = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            h[i][lane] = blake2s_IV[i];
+        }
+        /* The parameter block of `blake2s_init`: a 32 byte digest, no key, fanout and depth 1 */
+        h[0][lane] ^= 0x01010000U | BLAKE2S_OUTBYTES;
+        ++num_active;
+    };
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        start_next_message(lane);
+    }
+
+    while (num_active > 0) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            uint8_t block[BLAKE2S_BLOCKBYTES] = { 0 };
+            uint64_t counter = 0;
+            bool last = false;
+            if (active[lane]) {
+                const std::vector<uint8_t>& input = inputs[message_index[lane]];
+                const size_t remaining = input.size() - offset[lane];
+                const size_t size = std::min(remaining, (size_t)BLAKE2S_BLOCKBYTES);
+                if (size > 0) {
+                    memcpy(block, &input[offset[lane]], size);
+                }
+                offset[lane] += size;
+                counter = offset[lane];
+                last = remaining <= BLAKE2S_BLOCKBYTES;
+            }
+            for (size_t i = 0; i < 16; ++i) {
+                words[i][lane] = load32(block + i * sizeof(words[i][lane]));
+            }
+            t[0][lane] = (uint32_t)counter;
+            t[1][lane] = (uint32_t)(counter >> 32);
+            f[lane] = last ? (uint32_t)-1 : 0;
+        }
+        compress_lanes(h, words, t, f);
+
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            if (!active[lane] || f[lane] == 0) {
+                continue;
+            }
+            std::vector<uint8_t>& output = outputs[message_index[lane]];
+            output.resize(BLAKE2S_OUTBYTES);
+            for (size_t i = 0; i < 8; ++i) {
+                store32(&output[i * sizeof(h[i][lane])], h[i][lane]);
+            }
+            --num_active;
+            start_next_message(lane);
+        }
+    }
+    return outputs;
+}
+
+} // namespace
+
+std::vector<std::vector<uint8_t>> blake2s_batch(std::vector<std::vector<uint8_t>> const& inputs, batch_kernel kernel)
+{
+#if BBERG_BLAKE2S_SIMD
+    if ((kernel == batch_kernel::best || kernel == batch_kernel::avx512) && has_avx512f()) {
+        return blake2s_multi_buffer<16>(inputs, compress_avx512);
+    }
+    if ((kernel == batch_kernel::best || kernel == batch_kernel::avx2) && has_avx2()) {
+        return blake2s_multi_buffer<8>(inputs, compress_avx2);
+    }
+#endif
+    std::vector<std::vector<uint8_t>> outputs(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        outputs[i] = blake2s(inputs[i]);
+    }
+    return outputs;
+}
+
 } // namespace blake2
@@ -14,6 +14,7 @@
 */
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <vector>
 
@@ -71,4 +72,19 @@ int blake2s_final(blake2s_state* S, void* out, size_t outlen);
 
 std::vector<uint8_t> blake2s(std::vector<uint8_t> const& input);
 
+/**
+ * Kernels `blake2s_batch` can hash with. `best` picks the widest one the CPU supports; a kernel the CPU (or build)
+ * does not support falls back to `scalar`.
+ *
+ * The SIMD kernels hash one message per 32-bit lane: 8 at a time with AVX2, 16 with AVX-512. A lane that finishes its
+ * message picks up the next one, so messages of different lengths keep every lane busy.
+ */
+enum class batch_kernel { best, scalar, avx2, avx512 };
+
+/**
+ * Hash independent messages. Gives the same results as calling `blake2s` on each of them.
+ */
+std::vector<std::vector<uint8_t>> blake2s_batch(std::vector<std::vector<uint8_t>> const& inputs,
+                                                batch_kernel kernel = batch_kernel::best);
+
 } // namespace blake2
\ No newline at end of file
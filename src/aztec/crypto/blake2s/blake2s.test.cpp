@@ -384,4 +384,33 @@ TEST(misc_blake2s, test_vectors)
         std::vector<uint8_t> input(v.input.begin(), v.input.end());
         EXPECT_EQ(blake2::blake2s(input), v.output);
     }
-}
\ No newline at end of file
+}
+
+TEST(misc_blake2s, batch_matches_blake2s)
+{
+    // Lengths either side of the block boundaries, and enough messages to refill every lane
+    std::vector<std::vector<uint8_t>> inputs;
+    for (auto v : test_vectors) {
+        inputs.push_back(std::vector<uint8_t>(v.input.begin(), v.input.end()));
+    }
+    for (size_t length : std::vector<size_t>{ 0, 1, 63, 64, 65, 127, 128, 129, 200, 1000 }) {
+        for (size_t j = 0; j < 3; ++j) {
+            std::vector<uint8_t> input(length);
+            for (size_t i = 0; i < length; ++i) {
+                input[i] = static_cast<uint8_t>(i * 31 + j * 7 + length);
+            }
+            inputs.push_back(input);
+        }
+    }
+
+    for (auto kernel : { blake2::batch_kernel::best,
+                         blake2::batch_kernel::scalar,
+                         blake2::batch_kernel::avx2,
+                         blake2::batch_kernel::avx512 }) {
+        auto results = blake2::blake2s_batch(inputs, kernel);
+        ASSERT_EQ(results.size(), inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            EXPECT_EQ(results[i], blake2::blake2s(inputs[i]));
+        }
+    }
+}
@@ -1,23 +1,200 @@
 #include "./pedersen.hpp"
 #include <common/throw_or_abort.hpp>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #ifndef NO_MULTITHREADING
 #include <omp.h>
 #endif
 
 namespace crypto {
 namespace pedersen {
+namespace {
+
+constexpr size_t num_bits = 254;
+constexpr size_t num_quads_base = (num_bits - 1) >> 1;
+constexpr size_t num_quads = ((num_quads_base << 1) + 1 < num_bits) ? num_quads_base + 1 : num_quads_base;
+constexpr size_t num_wnaf_bits = (num_quads << 1) + 1;
+
+// The batched hash looks up this many consecutive quads of the hash ladder at once.
+constexpr size_t quads_per_window = 4;
+constexpr size_t num_windows = (num_quads + quads_per_window - 1) / quads_per_window;
+constexpr size_t window_table_size = 1UL << (2 * quads_per_window);
+
+// Each batched hash sums one offset point and a window point per window of each input.
+constexpr size_t points_per_hash = 1 + 2 * num_windows;
+// The number of hashes that share a batch inversion, per thread.
+constexpr size_t hashes_per_batch = 256;
+
+/**
+ * Precomputed points for hashing pairs of field elements with the generators (hash_index, 0) and (hash_index, 1).
+ *
+ * hash_single adds a point from each rung of the hash ladder: for the quad with wnaf entry e, this is `one` or
+ * `three` as e is 1 or 3, negated if e is negative. Here the sums for `quads_per_window` consecutive quads are
+ * precomputed, indexed by two bits per quad: the low bit for the sign and the high bit to select `three`.
+ */
+struct pair_window_tables {
+    // windows[i][j * window_table_size + d] is entry `d` of window `j` for input `i`.
+    std::array<std::vector<grumpkin::g1::affine_element>, 2> windows;
+    // The sum of the first rung of both hash ladders, minus the skew generator of each input whose skew bit is set.
+    std::array<grumpkin::g1::affine_element, 4> offsets;
+};
+
+void compute_window_table(const fixed_base_ladder* ladder, std::vector<grumpkin::g1::affine_element>& table)
+{
+    table.resize(num_windows * window_table_size);
+    std::vector<grumpkin::g1::element> current(window_table_size);
+    std::vector<grumpkin::g1::element> next(window_table_size);
+    for (size_t j = 0; j < num_windows; ++j) {
+        const size_t first_quad = j * quads_per_window;
+        const size_t num_window_quads = std::min(quads_per_window, num_quads - first_quad);
+        size_t size = 1;
+        for (size_t k = 0; k < num_window_quads; ++k) {
+            const fixed_base_ladder& rung = ladder[first_quad + k + 1];
+            const grumpkin::g1::affine_element digits[4] = { rung.one, -rung.one, rung.three, -rung.three };
+            for (size_t d = 0; d < 4; ++d) {
+                for (size_t i = 0; i < size; ++i) {
+                    next[d * size + i] = (k == 0) ? grumpkin::g1::element(digits[d]) : current[i] + digits[d];
+                }
+            }
+            size *= 4;
+            std::swap(current, next);
+        }
+        grumpkin::g1::element::batch_normalize(&current[0], size);
+        for (size_t i = 0; i < size; ++i) {
+            table[j * window_table_size + i] = grumpkin::g1::affine_element(current[i].x, current[i].y);
+        }
+    }
+}
+
+std::unique_ptr<pair_window_tables> compute_pair_window_tables(const size_t hash_index)
+{
+    auto tables = std::make_unique<pair_window_tables>();
+    std::array<grumpkin::g1::element, 4> offsets;
+    const generator_data& lhs = get_generator_data({ hash_index, 0 });
+    const generator_data& rhs = get_generator_data({ hash_index, 1 });
+    compute_window_table(lhs.get_hash_ladder(num_bits), tables->windows[0]);
+    compute_window_table(rhs.get_hash_ladder(num_bits), tables->windows[1]);
+
+    offsets[0] = grumpkin::g1::element(lhs.get_hash_ladder(num_bits)[0].one) + rhs.get_hash_ladder(num_bits)[0].one;
+    offsets[1] = offsets[0] - lhs.skew_generator;
+    offsets[2] = offsets[0] - rhs.skew_generator;
+    offsets[3] = offsets[1] - rhs.skew_generator;
+    grumpkin::g1::element::batch_normalize(&offsets[0], 4);
+    for (size_t i = 0; i < 4; ++i) {
+        tables->offsets[i] = grumpkin::g1::affine_element(offsets[i].x, offsets[i].y);
+    }
+    return tables;
+}
+
+pair_window_tables const& get_pair_window_tables(const size_t hash_index)
+{
+    static std::mutex mutex;
+    static std::map<size_t, std::unique_ptr<pair_window_tables>> tables;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& entry = tables[hash_index];
+    if (!entry) {
+        entry = compute_pair_window_tables(hash_index);
+    }
+    return *entry;
+}
+
+/**
+ * Computes the wnaf of `in` as hash_single does, and returns its skew. `digits[j]` is set to the window table index of
+ * window j.
+ */
+bool get_window_digits(const grumpkin::fq& in, size_t* digits)
+{
+    barretenberg::fr scalar_multiplier = in.from_montgomery_form();
+    uint64_t wnaf_entries[num_quads + 2] = { 0 };
+    bool skew = false;
+    barretenberg::wnaf::fixed_wnaf<num_wnaf_bits, 1, 2>(&scalar_multiplier.data[0], &wnaf_entries[0], skew, 0);
+    for (size_t j = 0; j < num_windows; ++j) {
+        digits[j] = 0;
+    }
+    for (size_t i = 0; i < num_quads; ++i) {
+        const uint64_t entry = wnaf_entries[i + 1];
+        const size_t digit = (((entry & WNAF_MASK) == 1) ? 2 : 0) | static_cast<size_t>((entry >> 31U) & 1U);
+        digits[i / quads_per_window] |= digit << (2 * (i % quads_per_window));
+    }
+    return skew;
+}
+
+/**
+ * Hashes inputs[0..num_hashes) into `outputs`. The points of each hash are summed pairwise as a tree, in affine form.
+ * Each level of the tree needs an inversion per addition, and these are shared between all hashes with one batch
+ * inversion. An addition of two points with the same x-coordinate (which needs doubling or gives the point at infinity)
+ * is not handled, and the hash is recomputed by compress_native instead.
+ */
+void compress_native_batch_internal(const std::pair<grumpkin::fq, grumpkin::fq>* inputs,
+                                    grumpkin::fq* outputs,
+                                    const size_t num_hashes,
+                                    const size_t hash_index,
+                                    pair_window_tables const& tables)
+{
+    std::vector<grumpkin::g1::affine_element> points(num_hashes * points_per_hash);
+    std::vector<grumpkin::fq> inversions(num_hashes * (points_per_hash / 2));
+    std::vector<bool> degenerate(num_hashes, false);
+
+    size_t digits[num_windows];
+    for (size_t h = 0; h < num_hashes; ++h) {
+        grumpkin::g1::affine_element* hash_points = &points[h * points_per_hash];
+        size_t skew = 0;
+        for (size_t i = 0; i < 2; ++i) {
+            skew |= static_cast<size_t>(get_window_digits(i == 0 ? inputs[h].first : inputs[h].second, digits)) << i;
+            for (size_t j = 0; j < num_windows; ++j) {
+                hash_points[1 + i * num_windows + j] = tables.windows[i][j * window_table_size + digits[j]];
+            }
+        }
+        hash_points[0] = tables.offsets[skew];
+    }
+
+    size_t num_points = points_per_hash;
+    while (num_points > 1) {
+        const size_t num_pairs = num_points / 2;
+        for (size_t h = 0; h < num_hashes; ++h) {
+            const grumpkin::g1::affine_element* hash_points = &points[h * points_per_hash];
+            for (size_t i = 0; i < num_pairs; ++i) {
+                grumpkin::fq& inversion = inversions[h * num_pairs + i];
+                inversion = hash_points[2 * i + 1].x - hash_points[2 * i].x;
+                if (inversion.is_zero()) {
+                    degenerate[h] = true;
+                    inversion = grumpkin::fq::one();
+                }
+            }
+        }
+        grumpkin::fq::batch_invert(&inversions[0], num_hashes * num_pairs);
+
+        for (size_t h = 0; h < num_hashes; ++h) {
+            grumpkin::g1::affine_element* hash_points = &points[h * points_per_hash];
+            for (size_t i = 0; i < num_pairs; ++i) {
+                const grumpkin::g1::affine_element p1 = hash_points[2 * i];
+                const grumpkin::g1::affine_element& p2 = hash_points[2 * i + 1];
+                const grumpkin::fq lambda = (p2.y - p1.y) * inversions[h * num_pairs + i];
+                hash_points[i].x = lambda.sqr() - (p1.x + p2.x);
+                hash_points[i].y = lambda * (p1.x - hash_points[i].x) - p1.y;
+            }
+            if (num_points & 1) {
+                hash_points[num_pairs] = hash_points[num_points - 1];
+            }
+        }
+        num_points = num_pairs + (num_points & 1);
+    }
+
+    for (size_t h = 0; h < num_hashes; ++h) {
+        outputs[h] = degenerate[h] ? compress_native({ inputs[h].first, inputs[h].second }, hash_index)
+                                   : points[h * points_per_hash].x.reduce_once();
+    }
+}
+
+} // namespace
 
 grumpkin::g1::element hash_single(const barretenberg::fr& in, generator_index_t const& index)
 {
     auto gen_data = get_generator_data(index);
     barretenberg::fr scalar_multiplier = in.from_montgomery_form();
 
-    constexpr size_t num_bits = 254;
-    constexpr size_t num_quads_base = (num_bits - 1) >> 1;
-    constexpr size_t num_quads = ((num_quads_base << 1) + 1 < num_bits) ? num_quads_base + 1 : num_quads_base;
-    constexpr size_t num_wnaf_bits = (num_quads << 1) + 1;
-
     const crypto::pedersen::fixed_base_ladder* ladder = gen_data.get_hash_ladder(num_bits);
 
     uint64_t wnaf_entries[num_quads + 2] = { 0 };
@@ -73,6 +250,33 @@ grumpkin::fq compress_native(const std::vector<grumpkin::fq>& inputs, const size
     return commit_native(inputs, hash_index).x;
 }
 
+/**
+ * Compresses each pair of inputs, with the same result as calling compress_native({ lhs, rhs }, hash_index) on each.
+ *
+ * The scalar multiplications look up four quads of the hash ladder at a time in precomputed tables, and the resulting
+ * points are added in affine form with one batch inversion per level of additions, across a batch of hashes. Batches
+ * are hashed in parallel.
+ */
+std::vector<grumpkin::fq> compress_native_batch(std::span<const std::pair<grumpkin::fq, grumpkin::fq>> inputs,
+                                                const size_t hash_index)
+{
+    std::vector<grumpkin::fq> outputs(inputs.size());
+    // Ensure generator data and tables are initialized before threading...
+    init_generator_data();
+    auto const& tables = get_pair_window_tables(hash_index);
+
+    const size_t num_batches = (inputs.size() + hashes_per_batch - 1) / hashes_per_batch;
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (size_t i = 0; i < num_batches; ++i) {
+        const size_t start = i * hashes_per_batch;
+        const size_t num_hashes = std::min(hashes_per_batch, inputs.size() - start);
+        compress_native_batch_internal(&inputs[start], &outputs[start], num_hashes, hash_index, tables);
+    }
+    return outputs;
+}
+
 /**
  * Given an arbitrary length of bytes, convert them to fields and compress the result using the default generators.
  */
@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <span>
 #include <ecc/curves/grumpkin/grumpkin.hpp>
 #include "./generator_data.hpp"
 #include "./fixed_base_scalar_mul.hpp"
@@ -21,5 +22,8 @@ template <size_t T> grumpkin::fq compress_native(const std::array<grumpkin::fq,
 
 grumpkin::fq compress_native(const std::vector<uint8_t>& input);
 
+std::vector<grumpkin::fq> compress_native_batch(std::span<const std::pair<grumpkin::fq, grumpkin::fq>> inputs,
+                                                const size_t hash_index = 0);
+
 } // namespace pedersen
 } // namespace crypto
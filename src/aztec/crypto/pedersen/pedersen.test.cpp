@@ -84,3 +84,23 @@ TEST(pedersen, fixed_base_scalar_mul)
         EXPECT_EQ(result.y, pub_key.y);
     }
 }
+
+TEST(pedersen, compress_native_batch)
+{
+    // Spans several batches, the last of which is partial, and includes inputs with small and large wnaf digits.
+    std::vector<std::pair<grumpkin::fq, grumpkin::fq>> inputs;
+    for (size_t i = 0; i < 600; ++i) {
+        inputs.push_back({ grumpkin::fq::random_element(), grumpkin::fq::random_element() });
+    }
+    inputs.push_back({ 0, 0 });
+    inputs.push_back({ 1, 0 });
+    inputs.push_back({ grumpkin::fq(-1), grumpkin::fq(-1) });
+
+    for (size_t hash_index : { 0UL, 3UL }) {
+        auto outputs = compress_native_batch(inputs, hash_index);
+        EXPECT_EQ(outputs.size(), inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            EXPECT_EQ(outputs[i], compress_native({ inputs[i].first, inputs[i].second }, hash_index));
+        }
+    }
+}
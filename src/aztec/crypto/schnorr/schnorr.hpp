@@ -31,6 +31,12 @@ struct signature_b {
 template <typename Hash, typename Fq, typename Fr, typename G1>
 bool verify_signature(const std::string& message, const typename G1::affine_element& public_key, const signature& sig);
 
+// Only for signatures over grumpkin
+template <typename Hash, typename Fq, typename Fr, typename G1>
+std::vector<size_t> verify_signatures_batch(const std::vector<std::string>& messages,
+                                            const std::vector<typename G1::affine_element>& public_keys,
+                                            const std::vector<signature>& signatures);
+
 template <typename Hash, typename Fq, typename Fr, typename G1>
 signature construct_signature(const std::string& message, const key_pair<Fr, G1>& account);
 
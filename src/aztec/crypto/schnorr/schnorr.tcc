@@ -1,13 +1,32 @@
 #pragma once
 
+#include <common/assert.hpp>
+#include <common/max_threads.hpp>
 #include <crypto/hmac/hmac.hpp>
 #include <crypto/pedersen/pedersen.hpp>
+#include <type_traits>
 
 #include "schnorr.hpp"
 
 namespace crypto {
 namespace schnorr {
 
+/**
+ * @brief The last step of generate_schnorr_challenge: e = H(compressed_keys, message)
+ */
+template <typename Hash, typename Fq>
+static auto hash_schnorr_challenge(const std::string& message, const Fq& compressed_keys)
+{
+    std::vector<uint8_t> e_buffer;
+    write(e_buffer, compressed_keys);
+    std::copy(message.begin(), message.end(), std::back_inserter(e_buffer));
+
+    // hash the result of the pedersen hash digest
+    // we return auto since some hash implementation return
+    // either a std::vector or a std::array with 32 bytes
+    return Hash::hash(e_buffer);
+}
+
 /**
  * @brief Generate the schnorr signature challenge parameter `e` given a message, signer pubkey and nonce
  *
@@ -44,14 +63,7 @@ static auto generate_schnorr_challenge(const std::string& message,
     using Fq = typename G1::coordinate_field;
     // create challenge message pedersen_hash(R.x, pubkey)
     Fq compressed_keys = crypto::pedersen::compress_native({ R.x, pubkey.x, pubkey.y });
-    std::vector<uint8_t> e_buffer;
-    write(e_buffer, compressed_keys);
-    std::copy(message.begin(), message.end(), std::back_inserter(e_buffer));
-
-    // hash the result of the pedersen hash digest
-    // we return auto since some hash implementation return
-    // either a std::vector or a std::array with 32 bytes
-    return Hash::hash(e_buffer);
+    return hash_schnorr_challenge<Hash>(message, compressed_keys);
 }
 
 /**
@@ -100,6 +112,55 @@ signature construct_signature(const std::string& message, const key_pair<Fr, G1>
     return sig;
 }
 
+/**
+ * @brief The multiples j * 16^i * G1::one for j = 1, ..., 15, and i < 64, built on first use
+ */
+template <typename G1> const std::vector<typename G1::affine_element>& get_generator_table()
+{
+    using element = typename G1::element;
+    static const std::vector<typename G1::affine_element> table = [] {
+        constexpr size_t num_windows = 64;
+        std::vector<element> multiples(num_windows * 15);
+        element base = G1::one;
+        for (size_t i = 0; i < num_windows; ++i) {
+            element multiple = base;
+            for (size_t j = 0; j < 15; ++j) {
+                multiples[i * 15 + j] = multiple;
+                multiple += base;
+            }
+            base = multiple;
+        }
+        element::batch_normalize(&multiples[0], multiples.size());
+        std::vector<typename G1::affine_element> result;
+        result.reserve(multiples.size());
+        for (auto& multiple : multiples) {
+            result.emplace_back(multiple.x, multiple.y);
+        }
+        return result;
+    }();
+    return table;
+}
+
+/**
+ * @brief Compute scalar * G1::one with one mixed addition per nonzero 4-bit window of the scalar, and no doublings.
+ *
+ * @details Not constant time: only use it on public scalars.
+ */
+template <typename G1, typename Fr> typename G1::element mul_generator(const Fr& scalar)
+{
+    const auto& table = get_generator_table<G1>();
+    const Fr converted = scalar.from_montgomery_form();
+    typename G1::element result;
+    result.self_set_infinity();
+    for (size_t i = 0; i < 64; ++i) {
+        const uint64_t window = (converted.data[i / 16] >> ((i % 16) * 4)) & 15;
+        if (window != 0) {
+            result += table[i * 15 + window - 1];
+        }
+    }
+    return result;
+}
+
 /**
  * @brief Verify a Schnorr signature of the sort produced by construct_signature.
  */
@@ -127,7 +188,7 @@ bool verify_signature(const std::string& message, const typename G1::affine_elem
     }
 
     // R = g^{sig.s} • pub^{sig.e}
-    affine_element R(element(public_key) * e + G1::one * s);
+    affine_element R(element(public_key) * e + mul_generator<G1>(s));
     if (R.is_point_at_infinity()) {
         // this result implies k == 0
         return false;
@@ -139,5 +200,97 @@ bool verify_signature(const std::string& message, const typename G1::affine_elem
     auto target_e = generate_schnorr_challenge<Hash, G1>(message, public_key, R);
     return std::equal(sig.e.begin(), sig.e.end(), target_e.begin(), target_e.end());
 }
+
+/**
+ * @brief Verify many Schnorr signatures, with the same result as calling verify_signature on each.
+ *
+ * @details A signature (s, e) only determines its nonce R = g^{s} • pub^{e} through the hash check on R, so the
+ * signatures can't be folded into one random linear combination: every R has to be computed, and hashed. Instead,
+ * the work is shared. g^{s} uses the table of `mul_generator`, each thread converts its R's and pedersen commitments
+ * to affine form with one inversion each, and the signatures are split across threads.
+ *
+ * The pedersen commitments are built from the grumpkin generator tables, so only grumpkin signatures are supported.
+ *
+ * @return The indices of the signatures that fail to verify, in increasing order. Empty if all of them verify.
+ */
+template <typename Hash, typename Fq, typename Fr, typename G1>
+std::vector<size_t> verify_signatures_batch(const std::vector<std::string>& messages,
+                                            const std::vector<typename G1::affine_element>& public_keys,
+                                            const std::vector<signature>& signatures)
+{
+    static_assert(std::is_same_v<G1, grumpkin::g1> && std::is_same_v<Fq, grumpkin::fq>,
+                  "verify_signatures_batch uses the grumpkin pedersen generators");
+    using element = typename G1::element;
+
+    ASSERT(messages.size() == signatures.size() && public_keys.size() == signatures.size());
+    const size_t num_signatures = signatures.size();
+    std::vector<element> R(num_signatures);
+    std::vector<uint8_t> valid(num_signatures, 0);
+
+    // Build the tables before the threads need them
+    get_generator_table<G1>();
+    crypto::pedersen::init_generator_data();
+
+    const size_t num_threads = std::max(std::min(max_threads::compute_num_threads(), num_signatures), 1UL);
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < num_threads; ++j) {
+        const size_t start = (j * num_signatures) / num_threads;
+        const size_t end = ((j + 1) * num_signatures) / num_threads;
+        if (start == end) {
+            continue;
+        }
+        for (size_t i = start; i < end; ++i) {
+            const auto& public_key = public_keys[i];
+            // The same checks as verify_signature
+            Fr e = Fr::serialize_from_buffer(&signatures[i].e[0]);
+            Fr s = Fr::serialize_from_buffer(&signatures[i].s[0]);
+            if (!public_key.on_curve() || public_key.is_point_at_infinity() || s == 0 || e == 0) {
+                R[i].self_set_infinity();
+                continue;
+            }
+            R[i] = element(public_key) * e + mul_generator<G1>(s);
+            valid[i] = !R[i].is_point_at_infinity();
+        }
+
+        element::batch_normalize(&R[start], end - start);
+
+        // pedersen(r.x || pub_key.x || pub_key.y) as compress_native computes it, but without its parallel loop, which
+        // is slow to start inside this one, and with one inversion for all the commitments
+        std::vector<element> commitments(end - start);
+        for (size_t i = start; i < end; ++i) {
+            auto& commitment = commitments[i - start];
+            if (!valid[i]) {
+                commitment.self_set_infinity();
+                continue;
+            }
+            const Fq inputs[3]{ R[i].x, public_keys[i].x, public_keys[i].y };
+            commitment = crypto::pedersen::hash_single(inputs[0], { 0, 0 });
+            for (size_t k = 1; k < 3; ++k) {
+                commitment = crypto::pedersen::hash_single(inputs[k], { 0, k }) + commitment;
+            }
+        }
+        element::batch_normalize(&commitments[0], commitments.size());
+
+        for (size_t i = start; i < end; ++i) {
+            if (!valid[i]) {
+                continue;
+            }
+            const auto& commitment = commitments[i - start];
+            const Fq compressed_keys = commitment.is_point_at_infinity() ? Fq(0) : commitment.x;
+            auto target_e = hash_schnorr_challenge<Hash>(messages[i], compressed_keys);
+            valid[i] = std::equal(signatures[i].e.begin(), signatures[i].e.end(), target_e.begin(), target_e.end());
+        }
+    }
+
+    std::vector<size_t> invalid;
+    for (size_t i = 0; i < num_signatures; ++i) {
+        if (!valid[i]) {
+            invalid.push_back(i);
+        }
+    }
+    return invalid;
+}
 } // namespace schnorr
-} // namespace crypto
\ No newline at end of file
+} // namespace crypto
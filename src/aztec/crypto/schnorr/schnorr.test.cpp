@@ -136,4 +136,42 @@ TEST(schnorr, hmac_signature_consistency)
     res = verify_signature<KeccakHasher, grumpkin::fq, grumpkin::fr, grumpkin::g1>(
         message_b, account_b.public_key, signature_h);
     EXPECT_EQ(res, true);
-}
\ No newline at end of file
+}
+
+TEST(schnorr, verify_signatures_batch)
+{
+    constexpr size_t num_signatures = 20;
+    std::vector<std::string> messages;
+    std::vector<grumpkin::g1::affine_element> public_keys;
+    std::vector<crypto::schnorr::signature> signatures;
+    for (size_t i = 0; i < num_signatures; ++i) {
+        auto account = generate_signature();
+        messages.push_back("message " + std::to_string(i));
+        public_keys.push_back(account.public_key);
+        signatures.push_back(
+            construct_signature<Blake2sHasher, grumpkin::fq, grumpkin::fr, grumpkin::g1>(messages[i], account));
+    }
+
+    auto invalid =
+        verify_signatures_batch<Blake2sHasher, grumpkin::fq, grumpkin::fr, grumpkin::g1>(messages, public_keys, signatures);
+    EXPECT_TRUE(invalid.empty());
+
+    // A wrong message, a wrong key, a tampered s, a zero e and a key off the curve
+    messages[2] = "another message";
+    public_keys[5] = public_keys[6];
+    signatures[11].s[31] ^= 1;
+    signatures[12].e.fill(0);
+    public_keys[19].y += grumpkin::fq::one();
+
+    invalid =
+        verify_signatures_batch<Blake2sHasher, grumpkin::fq, grumpkin::fr, grumpkin::g1>(messages, public_keys, signatures);
+    EXPECT_EQ(invalid, (std::vector<size_t>{ 2, 5, 11, 12, 19 }));
+    for (size_t i = 0; i < num_signatures; ++i) {
+        bool expected = std::find(invalid.begin(), invalid.end(), i) == invalid.end();
+        bool result = verify_signature<Blake2sHasher, grumpkin::fq, grumpkin::fr, grumpkin::g1>(
+            messages[i], public_keys[i], signatures[i]);
+        EXPECT_EQ(result, expected);
+    }
+
+    EXPECT_TRUE((verify_signatures_batch<Blake2sHasher, grumpkin::fq, grumpkin::fr, grumpkin::g1>({}, {}, {}).empty()));
+}
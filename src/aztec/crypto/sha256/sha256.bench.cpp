@@ -0,0 +1,47 @@
+#include "sha256.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace benchmark;
+
+namespace {
+constexpr size_t NUM_MESSAGES = 256;
+
+std::vector<std::vector<uint8_t>> get_messages(const size_t size)
+{
+    std::vector<std::vector<uint8_t>> messages(NUM_MESSAGES, std::vector<uint8_t>(size));
+    for (size_t i = 0; i < NUM_MESSAGES; ++i) {
+        for (size_t j = 0; j < size; ++j) {
+            messages[i][j] = static_cast<uint8_t>(i * 7 + j);
+        }
+    }
+    return messages;
+}
+} // namespace
+
+// Hash NUM_MESSAGES messages of state.range(0) bytes one after another; uses the SHA extensions if the CPU has them
+void sha256_bench(State& state) noexcept
+{
+    const auto messages = get_messages(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (auto& message : messages) {
+            DoNotOptimize(sha256::sha256(message));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(NUM_MESSAGES) * state.range(0));
+}
+BENCHMARK(sha256_bench)->RangeMultiplier(4)->Range(32, 8192);
+
+// As `sha256_bench`, through `sha256_batch` with the given kernel. Kernels the CPU lacks run the scalar one.
+void sha256_batch_bench(State& state, sha256::batch_kernel kernel) noexcept
+{
+    const auto messages = get_messages(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        DoNotOptimize(sha256::sha256_batch(messages, kernel));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(NUM_MESSAGES) * state.range(0));
+}
+BENCHMARK_CAPTURE(sha256_batch_bench, scalar, sha256::batch_kernel::scalar)->RangeMultiplier(4)->Range(32, 8192);
+BENCHMARK_CAPTURE(sha256_batch_bench, avx2, sha256::batch_kernel::avx2)->RangeMultiplier(4)->Range(32, 8192);
+BENCHMARK_CAPTURE(sha256_batch_bench, avx512, sha256::batch_kernel::avx512)->RangeMultiplier(4)->Range(32, 8192);
+
+BENCHMARK_MAIN();
@@ -4,6 +4,20 @@
 #include <common/net.hpp>
 #include <memory.h>
 
+#if defined(__x86_64__) && !defined(__wasm__) && !defined(DISABLE_SHENANIGANS)
+#define BBERG_SHA256_SIMD 1
+// GCC 12 reports false positives inside the AVX-512 shift intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#define BBERG_AVX2 __attribute__((target("avx2"), always_inline)) inline
+#define BBERG_AVX512F __attribute__((target("avx512f"), always_inline)) inline
+#else
+#define BBERG_SHA256_SIMD 0
+#endif
+
 namespace sha256 {
 
 namespace {
@@ -108,6 +122,309 @@ std::array<uint32_t, 8> sha256_block(const std::array<uint32_t, 8>& h_init, cons
     return output;
 }
 
+namespace {
+
+#if BBERG_SHA256_SIMD
+// Runtime CPU dispatch, evaluated once
+bool has_sha_ni() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+    return supported;
+}
+
+bool has_avx2() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+bool has_avx512f() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("avx512f");
+    return supported;
+}
+
+/**
+ * `sha256_block` with the SHA extensions. These keep the state as the word pairs ABEF and CDGH, and do two rounds per
+ * instruction.
+ **/
+__attribute__((target("sha,sse4.1"))) void compress_sha_ni(uint32_t* state, const uint32_t* input)
+{
+    // DCBA, HGFE -> ABEF, CDGH
+    __m128i dcba = _mm_loadu_si128((const __m128i*)&state[0]);
+    __m128i hgfe = _mm_loadu_si128((const __m128i*)&state[4]);
+    const __m128i cdab = _mm_shuffle_epi32(dcba, 0xB1);
+    const __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1B);
+    __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+    const __m128i abef_init = abef;
+    const __m128i cdgh_init = cdgh;
+
+    // w[i % 4] holds message words 4i, ..., 4i + 3
+    __m128i w[4];
+    for (size_t i = 0; i < 4; ++i) {
+        w[i] = _mm_loadu_si128((const __m128i*)&input[4 * i]);
+    }
+    for (size_t i = 0; i < 16; ++i) {
+        if (i >= 4) {
+            // w[i - 4] + s0(w[i - 3]) + w[i - 2 : i - 1] + s1(w[i - 1])
+            __m128i next = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+            next = _mm_add_epi32(next, _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+            w[i & 3] = _mm_sha256msg2_epu32(next, w[(i + 3) & 3]);
+        }
+        __m128i message = _mm_add_epi32(w[i & 3], _mm_loadu_si128((const __m128i*)&round_constants[4 * i]));
+        cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+        message = _mm_shuffle_epi32(message, 0x0E);
+        abef = _mm_sha256rnds2_epu32(abef, cdgh, message);
+    }
+    abef = _mm_add_epi32(abef, abef_init);
+    cdgh = _mm_add_epi32(cdgh, cdgh_init);
+
+    // ABEF, CDGH -> DCBA, HGFE
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    dcba = _mm_blend_epi16(feba, dchg, 0xF0);
+    hgfe = _mm_alignr_epi8(dchg, feba, 8);
+    _mm_storeu_si128((__m128i*)&state[0], dcba);
+    _mm_storeu_si128((__m128i*)&state[4], hgfe);
+}
+
+template <int N> BBERG_AVX2 __m256i ror_avx2(__m256i x)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+BBERG_AVX2 __m256i add_avx2(__m256i a, __m256i b)
+{
+    return _mm256_add_epi32(a, b);
+}
+
+BBERG_AVX2 __m256i xor_avx2(__m256i a, __m256i b, __m256i c)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+}
+
+/**
+ * `sha256_block` on the 8 states state[][j], with message words words[][j]
+ **/
+__attribute__((target("avx2"))) void compress_avx2(uint32_t (&state)[8][8], const uint32_t (&words)[16][8])
+{
+    __m256i w[16];
+    for (size_t i = 0; i < 16; ++i) {
+        w[i] = _mm256_load_si256((const __m256i*)words[i]);
+    }
+    __m256i s[8];
+    for (size_t i = 0; i < 8; ++i) {
+        s[i] = _mm256_load_si256((const __m256i*)state[i]);
+    }
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+    for (size_t i = 0; i < 64; ++i) {
+        // The message schedule only needs the last 16 words
+        if (i >= 16) {
+            const __m256i w15 = w[(i + 1) & 15];
+            const __m256i w2 = w[(i + 14) & 15];
+            const __m256i s0 = xor_avx2(ror_avx2<7>(w15), ror_avx2<18>(w15), _mm256_srli_epi32(w15, 3));
+            const __m256i s1 = xor_avx2(ror_avx2<17>(w2), ror_avx2<19>(w2), _mm256_srli_epi32(w2, 10));
+            w[i & 15] = add_avx2(add_avx2(w[i & 15], w[(i + 9) & 15]), add_avx2(s0, s1));
+        }
+        const __m256i S1 = xor_avx2(ror_avx2<6>(e), ror_avx2<11>(e), ror_avx2<25>(e));
+        const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        const __m256i k = _mm256_set1_epi32(static_cast<int>(round_constants[i]));
+        const __m256i temp1 = add_avx2(add_avx2(h, S1), add_avx2(add_avx2(ch, k), w[i & 15]));
+        const __m256i S0 = xor_avx2(ror_avx2<2>(a), ror_avx2<13>(a), ror_avx2<22>(a));
+        const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, _mm256_or_si256(b, c)), _mm256_and_si256(b, c));
+        const __m256i temp2 = add_avx2(S0, maj);
+
+        h = g;
+        g = f;
+        f = e;
+        e = add_avx2(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = add_avx2(temp1, temp2);
+    }
+
+    const __m256i result[8]{ a, b, c, d, e, f, g, h };
+    for (size_t i = 0; i < 8; ++i) {
+        _mm256_store_si256((__m256i*)state[i], add_avx2(s[i], result[i]));
+    }
+}
+
+BBERG_AVX512F __m512i add_avx512(__m512i a, __m512i b)
+{
+    return _mm512_add_epi32(a, b);
+}
+
+BBERG_AVX512F __m512i xor_avx512(__m512i a, __m512i b, __m512i c)
+{
+    return _mm512_ternarylogic_epi32(a, b, c, 0x96);
+}
+
+/**
+ * As `compress_avx2`, on 16 states
+ **/
+__attribute__((target("avx512f"))) void compress_avx512(uint32_t (&state)[8][16], const uint32_t (&words)[16][16])
+{
+    __m512i w[16];
+    for (size_t i = 0; i < 16; ++i) {
+        w[i] = _mm512_load_si512(words[i]);
+    }
+    __m512i s[8];
+    for (size_t i = 0; i < 8; ++i) {
+        s[i] = _mm512_load_si512(state[i]);
+    }
+    __m512i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+    for (size_t i = 0; i < 64; ++i) {
+        if (i >= 16) {
+            const __m512i w15 = w[(i + 1) & 15];
+            const __m512i w2 = w[(i + 14) & 15];
+            const __m512i s0 = xor_avx512(_mm512_ror_epi32(w15, 7), _mm512_ror_epi32(w15, 18), _mm512_srli_epi32(w15, 3));
+            const __m512i s1 = xor_avx512(_mm512_ror_epi32(w2, 17), _mm512_ror_epi32(w2, 19), _mm512_srli_epi32(w2, 10));
+            w[i & 15] = add_avx512(add_avx512(w[i & 15], w[(i + 9) & 15]), add_avx512(s0, s1));
+        }
+        const __m512i S1 = xor_avx512(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25));
+        // e ? f : g
+        const __m512i ch = _mm512_ternarylogic_epi32(e, f, g, 0xCA);
+        const __m512i k = _mm512_set1_epi32(static_cast<int>(round_constants[i]));
+        const __m512i temp1 = add_avx512(add_avx512(h, S1), add_avx512(add_avx512(ch, k), w[i & 15]));
+        const __m512i S0 = xor_avx512(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22));
+        // majority(a, b, c)
+        const __m512i maj = _mm512_ternarylogic_epi32(a, b, c, 0xE8);
+        const __m512i temp2 = add_avx512(S0, maj);
+
+        h = g;
+        g = f;
+        f = e;
+        e = add_avx512(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = add_avx512(temp1, temp2);
+    }
+
+    const __m512i result[8]{ a, b, c, d, e, f, g, h };
+    for (size_t i = 0; i < 8; ++i) {
+        _mm512_store_si512(state[i], add_avx512(s[i], result[i]));
+    }
+}
+#endif
+
+/**
+ * `sha256_block`, with the SHA extensions when the CPU has them
+ **/
+std::array<uint32_t, 8> compress(const std::array<uint32_t, 8>& h_init, const std::array<uint32_t, 16>& input)
+{
+#if BBERG_SHA256_SIMD
+    if (has_sha_ni()) {
+        std::array<uint32_t, 8> output = h_init;
+        compress_sha_ni(&output[0], &input[0]);
+        return output;
+    }
+#endif
+    return sha256_block(h_init, input);
+}
+
+uint32_t read_word(const uint8_t* input)
+{
+    uint32_t word;
+    memcpy((void*)&word, (void*)input, 4);
+    return is_little_endian() ? __builtin_bswap32(word) : word;
+}
+
+/**
+ * Append the padding and message length, to get a whole number of blocks
+ **/
+template <typename ByteContainer> std::vector<uint8_t> pad_message(const ByteContainer& input)
+{
+    std::vector<uint8_t> message_schedule;
+    // At most a block of padding
+    message_schedule.reserve(input.size() + 72);
+
+    message_schedule.insert(message_schedule.end(), input.begin(), input.end());
+    uint64_t l = message_schedule.size() * 8;
+    message_schedule.push_back(0x80);
+
+    uint32_t num_zero_bytes = ((448U - (message_schedule.size() << 3U)) & 511U) >> 3U;
+
+    message_schedule.resize(message_schedule.size() + num_zero_bytes, 0x00);
+    for (size_t i = 0; i < 8; ++i) {
+        uint8_t byte = static_cast<uint8_t>(l >> (uint64_t)(56 - (i * 8)));
+        message_schedule.push_back(byte);
+    }
+    return message_schedule;
+}
+
+/**
+ * Hash `inputs` with a kernel that compresses one block of each of `LANES` messages at a time.
+ *
+ * Each lane hashes one message. When it has compressed the last block, it writes the digest and starts on the next
+ * message. Once the messages run out, idle lanes compress zero blocks into states nobody reads.
+ **/
+template <size_t LANES, typename Compress>
+std::vector<hash> sha256_multi_buffer(std::vector<std::vector<uint8_t>> const& inputs, Compress compress_lanes)
+{
+    std::vector<hash> outputs(inputs.size());
+    alignas(64) uint32_t state[8][LANES];
+    alignas(64) uint32_t words[16][LANES];
+
+    // The padded message each lane is hashing, its index in `inputs`, and its next block
+    std::array<std::vector<uint8_t>, LANES> messages;
+    std::array<size_t, LANES> message_index{};
+    std::array<size_t, LANES> block{};
+    std::array<bool, LANES> active{};
+    size_t next_message = 0;
+    size_t num_active = 0;
+
+    const auto start_next_message = [&](const size_t lane) {
+        active[lane] = next_message < inputs.size();
+        if (!active[lane]) {
+            return;
+        }
+        messages[lane] = pad_message(inputs[next_message]);
+        message_index[lane] = next_message++;
+        block[lane] = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            state[i][lane] = init_constants[i];
+        }
+        ++num_active;
+    };
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        start_next_message(lane);
+    }
+
+    while (num_active > 0) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            const uint8_t* input = active[lane] ? &messages[lane][block[lane] * 64] : nullptr;
+            for (size_t i = 0; i < 16; ++i) {
+                words[i][lane] = input ? read_word(input + 4 * i) : 0;
+            }
+        }
+        compress_lanes(state, words);
+
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            if (!active[lane] || ++block[lane] * 64 < messages[lane].size()) {
+                continue;
+            }
+            hash& output = outputs[message_index[lane]];
+            for (size_t i = 0; i < 8; ++i) {
+                const uint32_t word = state[i][lane];
+                output[4 * i] = static_cast<uint8_t>(word >> 24);
+                output[4 * i + 1] = static_cast<uint8_t>(word >> 16);
+                output[4 * i + 2] = static_cast<uint8_t>(word >> 8);
+                output[4 * i + 3] = static_cast<uint8_t>(word);
+            }
+            --num_active;
+            start_next_message(lane);
+        }
+    }
+    return outputs;
+}
+
+} // namespace
+
 hash sha256_block(const std::vector<uint8_t>& input)
 {
     ASSERT(input.size() == 64);
@@ -120,7 +437,7 @@ hash sha256_block(const std::vector<uint8_t>& input)
             hash_input[j] = __builtin_bswap32(hash_input[j]);
         }
     }
-    result = sha256_block(result, hash_input);
+    result = compress(result, hash_input);
 
     hash output;
     memcpy((void*)&output[0], (void*)&result[0], 32);
@@ -136,21 +453,7 @@ hash sha256_block(const std::vector<uint8_t>& input)
 
 template <typename ByteContainer> hash sha256(const ByteContainer& input)
 {
-    std::vector<uint8_t> message_schedule;
-
-    std::copy(input.begin(), input.end(), std::back_inserter(message_schedule));
-    uint64_t l = message_schedule.size() * 8;
-    message_schedule.push_back(0x80);
-
-    uint32_t num_zero_bytes = ((448U - (message_schedule.size() << 3U)) & 511U) >> 3U;
-
-    for (size_t i = 0; i < num_zero_bytes; ++i) {
-        message_schedule.push_back(0x00);
-    }
-    for (size_t i = 0; i < 8; ++i) {
-        uint8_t byte = static_cast<uint8_t>(l >> (uint64_t)(56 - (i * 8)));
-        message_schedule.push_back(byte);
-    }
+    std::vector<uint8_t> message_schedule = pad_message(input);
     std::array<uint32_t, 8> rolling_hash;
     prepare_constants(rolling_hash);
     const size_t num_blocks = message_schedule.size() / 64;
@@ -162,7 +465,7 @@ template <typename ByteContainer> hash sha256(const ByteContainer& input)
                 hash_input[j] = __builtin_bswap32(hash_input[j]);
             }
         }
-        rolling_hash = sha256_block(rolling_hash, hash_input);
+        rolling_hash = compress(rolling_hash, hash_input);
     }
 
     hash output;
@@ -181,4 +484,21 @@ template hash sha256<std::vector<uint8_t>>(const std::vector<uint8_t>& input);
 template hash sha256<std::array<uint8_t, 32>>(const std::array<uint8_t, 32>& input);
 template hash sha256<std::string>(const std::string& input);
 
+std::vector<hash> sha256_batch(std::vector<std::vector<uint8_t>> const& inputs, batch_kernel kernel)
+{
+#if BBERG_SHA256_SIMD
+    if ((kernel == batch_kernel::best || kernel == batch_kernel::avx512) && has_avx512f()) {
+        return sha256_multi_buffer<16>(inputs, compress_avx512);
+    }
+    if ((kernel == batch_kernel::best || kernel == batch_kernel::avx2) && has_avx2()) {
+        return sha256_multi_buffer<8>(inputs, compress_avx2);
+    }
+#endif
+    std::vector<hash> outputs(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        outputs[i] = sha256(inputs[i]);
+    }
+    return outputs;
+}
+
 } // namespace sha256
\ No newline at end of file
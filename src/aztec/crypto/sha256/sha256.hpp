@@ -19,6 +19,21 @@ extern template hash sha256<std::vector<uint8_t>>(const std::vector<uint8_t>& in
 extern template hash sha256<std::array<uint8_t, 32>>(const std::array<uint8_t, 32>& input);
 extern template hash sha256<std::string>(const std::string& input);
 
+/**
+ * Kernels `sha256_batch` can hash with. `best` picks the widest one the CPU supports; a kernel the CPU (or build) does
+ * not support falls back to `scalar`.
+ *
+ * The SIMD kernels hash one message per 32-bit lane: 8 at a time with AVX2, 16 with AVX-512. A lane that finishes its
+ * message picks up the next one, so messages of different lengths keep every lane busy.
+ **/
+enum class batch_kernel { best, scalar, avx2, avx512 };
+
+/**
+ * Hash independent messages. Gives the same results as calling `sha256` on each of them.
+ **/
+std::vector<hash> sha256_batch(std::vector<std::vector<uint8_t>> const& inputs,
+                               batch_kernel kernel = batch_kernel::best);
+
 inline barretenberg::fr sha256_to_field(std::vector<uint8_t> const& input)
 {
     auto result = sha256::sha256(input);
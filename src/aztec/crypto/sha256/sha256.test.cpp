@@ -98,3 +98,30 @@ TEST(misc_sha256, test_NIST_vector_five)
         EXPECT_EQ(result[i], expected[i]);
     }
 }
+
+TEST(misc_sha256, batch_matches_sha256)
+{
+    // Lengths either side of the padding and block boundaries, and enough messages to refill every lane
+    std::vector<std::vector<uint8_t>> inputs;
+    for (size_t length : std::vector<size_t>{ 0, 1, 31, 32, 55, 56, 63, 64, 65, 119, 120, 128, 200, 1000 }) {
+        for (size_t j = 0; j < 3; ++j) {
+            std::vector<uint8_t> input(length);
+            for (size_t i = 0; i < length; ++i) {
+                input[i] = static_cast<uint8_t>(i * 31 + j * 7 + length);
+            }
+            inputs.push_back(input);
+        }
+    }
+
+    for (auto kernel : { sha256::batch_kernel::best,
+                         sha256::batch_kernel::scalar,
+                         sha256::batch_kernel::avx2,
+                         sha256::batch_kernel::avx512 }) {
+        auto results = sha256::sha256_batch(inputs, kernel);
+        ASSERT_EQ(results.size(), inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            EXPECT_EQ(results[i], sha256::sha256(inputs[i]));
+        }
+    }
+    EXPECT_TRUE(sha256::sha256_batch({}).empty());
+}
@@ -0,0 +1,217 @@
+#include "./fixed_size_msm.hpp"
+#include "./scalar_multiplication.hpp"
+
+#include <common/max_threads.hpp>
+#include <common/mem.hpp>
+#include <numeric/bitop/get_msb.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#ifndef NO_MULTITHREADING
+#include <omp.h>
+#endif
+
+namespace barretenberg {
+namespace scalar_multiplication {
+
+namespace {
+/**
+ * Get `bits` bits of a 128-bit endomorphism scalar, starting at `bit_position`. Bits past the top of the scalar are 0,
+ * as the last digit window can extend beyond it.
+ **/
+inline uint64_t get_signed_digit_bits(const uint64_t* scalar, const size_t bit_position, const size_t bits)
+{
+    if (bit_position >= 128) {
+        return 0;
+    }
+    const size_t limb_index = bit_position / 64;
+    const size_t shift = bit_position & 63;
+    uint64_t slice = scalar[limb_index] >> shift;
+    if (limb_index == 0 && shift != 0) {
+        slice |= scalar[1] << (64 - shift);
+    }
+    return slice & ((1ULL << bits) - 1);
+}
+} // namespace
+
+template <size_t num_initial_points>
+fixed_size_msm<num_initial_points>::fixed_size_msm()
+    : state(num_initial_points)
+{}
+
+/**
+ * Write the signed-digit point schedule of `scalars` to the runtime state. The entry for round `i` of point `j` is at
+ * `point_schedule[i * num_points + j]` and is packed as in `compute_wnaf_states`. Round 0 holds the most significant
+ * digits. Zero digits get the empty entry 0xffffffffffffffff, which sorts behind every bucket and is excluded from
+ * `round_counts`.
+ **/
+template <size_t num_initial_points>
+void fixed_size_msm<num_initial_points>::compute_signed_digit_schedule(const fr* scalars)
+{
+    constexpr uint64_t digit_modulus = 1ULL << digit_bits;
+#ifndef NO_MULTITHREADING
+    const size_t num_threads = max_threads::compute_num_threads();
+#else
+    const size_t num_threads = 1;
+#endif
+    const size_t num_initial_points_per_thread = num_initial_points / num_threads;
+    std::vector<std::array<uint64_t, num_rounds>> thread_round_counts(num_threads);
+
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < num_threads; ++i) {
+        fr T0;
+        for (size_t j = i * num_initial_points_per_thread; j < (i + 1) * num_initial_points_per_thread; ++j) {
+            T0 = scalars[j].from_montgomery_form();
+            fr::split_into_endomorphism_scalars(T0, T0, *(fr*)&T0.data[2]);
+
+            for (size_t k = 0; k < 2; ++k) {
+                const uint64_t point_index = static_cast<uint64_t>(2 * j + k);
+                uint64_t carry = 0;
+                for (size_t round = 0; round < num_rounds; ++round) {
+                    uint64_t digit = get_signed_digit_bits(&T0.data[2 * k], round * digit_bits, digit_bits) + carry;
+                    // Digits above 2^(c-1) are replaced by the (non-positive) digit - 2^c, plus a carry into the next.
+                    carry = digit > num_buckets ? 1 : 0;
+                    const uint64_t sign = carry;
+                    const uint64_t magnitude = carry ? digit_modulus - digit : digit;
+
+                    const size_t round_index = num_rounds - 1 - round;
+                    uint64_t& entry = state.point_schedule[round_index * num_points + point_index];
+                    if (magnitude == 0) {
+                        entry = 0xffffffffffffffffULL;
+                    } else {
+                        entry = (point_index << 32ULL) | (sign << 31ULL) | (magnitude - 1);
+                        ++thread_round_counts[i][round_index];
+                    }
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < num_rounds; ++i) {
+        state.round_counts[i] = 0;
+        for (size_t j = 0; j < num_threads; ++j) {
+            state.round_counts[i] += thread_round_counts[j][i];
+        }
+    }
+}
+
+/**
+ * Accumulate the sorted point schedule into buckets and combine them, as in `evaluate_pippenger_rounds`. The only
+ * difference is the bucket weights: bucket `k` holds points multiplied by digit `k + 1` (rather than `2k + 1`), and
+ * there is no skew to correct for.
+ **/
+template <size_t num_initial_points>
+g1::element fixed_size_msm<num_initial_points>::evaluate_rounds(g1::affine_element* points)
+{
+#ifndef NO_MULTITHREADING
+    const size_t num_threads = max_threads::compute_num_threads();
+#else
+    const size_t num_threads = 1;
+#endif
+
+    std::unique_ptr<g1::element[], decltype(&aligned_free)> thread_accumulators(
+        static_cast<g1::element*>(aligned_alloc(64, num_threads * sizeof(g1::element))), &aligned_free);
+
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < num_threads; ++j) {
+        thread_accumulators[j].self_set_infinity();
+
+        for (size_t i = 0; i < num_rounds; ++i) {
+            const uint64_t num_round_points = state.round_counts[i];
+
+            g1::element accumulator;
+            accumulator.self_set_infinity();
+
+            if ((num_round_points == 0) || (num_round_points < num_threads && j != num_threads - 1)) {
+            } else {
+                const uint64_t num_round_points_per_thread = num_round_points / num_threads;
+                const uint64_t leftovers =
+                    (j == num_threads - 1) ? (num_round_points) - (num_round_points_per_thread * num_threads) : 0;
+
+                uint64_t* thread_point_schedule =
+                    &state.point_schedule[(i * num_points) + j * num_round_points_per_thread];
+                const size_t first_bucket = thread_point_schedule[0] & 0x7fffffffU;
+                const size_t last_bucket =
+                    thread_point_schedule[(num_round_points_per_thread - 1 + leftovers)] & 0x7fffffffU;
+                const size_t num_thread_buckets = (last_bucket - first_bucket) + 1;
+
+                affine_product_runtime_state product_state = state.get_affine_product_runtime_state(num_threads, j);
+                product_state.num_points = static_cast<uint32_t>(num_round_points_per_thread + leftovers);
+                product_state.points = points;
+                product_state.point_schedule = thread_point_schedule;
+                product_state.num_buckets = static_cast<uint32_t>(num_thread_buckets);
+                g1::affine_element* output_buckets = reduce_buckets(product_state, true, false);
+                g1::element running_sum;
+                running_sum.self_set_infinity();
+
+                size_t output_it = product_state.num_points - 1;
+                for (size_t k = num_thread_buckets - 1; k > 0; --k) {
+                    if (__builtin_expect(!product_state.bucket_empty_status[k], 1)) {
+                        running_sum += (output_buckets[output_it]);
+                        --output_it;
+                    }
+                    accumulator += running_sum;
+                }
+                running_sum += output_buckets[0];
+                accumulator += running_sum;
+
+                // The buckets of this thread start at `first_bucket`, so every one of them is worth `first_bucket`
+                // more than its position in the thread's bucket list accounts for.
+                if (first_bucket > 0) {
+                    const uint32_t multiplier = static_cast<uint32_t>(first_bucket);
+                    size_t shift = numeric::get_msb(multiplier);
+                    g1::element rolling_accumulator = g1::point_at_infinity;
+                    bool init = false;
+                    while (shift != static_cast<size_t>(-1)) {
+                        if (init) {
+                            rolling_accumulator.self_dbl();
+                            if (((multiplier >> shift) & 1)) {
+                                rolling_accumulator += running_sum;
+                            }
+                        } else {
+                            rolling_accumulator += running_sum;
+                        }
+                        init = true;
+                        shift -= 1;
+                    }
+                    accumulator += rolling_accumulator;
+                }
+            }
+
+            if (i > 0) {
+                for (size_t k = 0; k < digit_bits; ++k) {
+                    thread_accumulators[j].self_dbl();
+                }
+            }
+            thread_accumulators[j] += accumulator;
+        }
+    }
+
+    g1::element result;
+    result.self_set_infinity();
+    for (size_t i = 0; i < num_threads; ++i) {
+        result += thread_accumulators[i];
+    }
+    return result;
+}
+
+template <size_t num_initial_points>
+g1::element fixed_size_msm<num_initial_points>::pippenger_unsafe(const fr* scalars, g1::affine_element* points)
+{
+    compute_signed_digit_schedule(scalars);
+    organize_buckets(state.point_schedule, state.round_counts, num_points);
+    return evaluate_rounds(points);
+}
+
+template class fixed_size_msm<1UL << 16>;
+template class fixed_size_msm<1UL << 17>;
+template class fixed_size_msm<1UL << 20>;
+
+} // namespace scalar_multiplication
+} // namespace barretenberg
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../fr.hpp"
+#include "../g1.hpp"
+#include "../../../groups/wnaf.hpp"
+#include "./runtime_states.hpp"
+
+namespace barretenberg {
+namespace scalar_multiplication {
+
+/**
+ * A pippenger engine for one fixed multi-scalar multiplication size, using signed-digit (rather than wNAF) bucket
+ * decomposition.
+ *
+ * Our circuit sizes are fixed, so the bucket width, the number of rounds and the sizes of all scratch space are known
+ * at compile time. The engine owns a `pippenger_runtime_state` for its size, allocated once, so repeated MSMs never
+ * allocate or page in scratch memory.
+ *
+ * Each endomorphism-split scalar is written as a sum of `num_rounds` signed digits in [-2^(c-1), 2^(c-1)], where
+ * `c = digit_bits`. Digit `d` is added (or subtracted, if negative) into bucket `|d| - 1`, and zero digits are skipped
+ * altogether. Unlike the wNAF decomposition used by `pippenger`, digits are not forced to be odd, so there is no skew
+ * correction pass over the point table at the end, and a sparse scalar produces a sparse point schedule.
+ *
+ * Point schedules have the same layout as the wNAF schedules (see `compute_wnaf_states`), so they are sorted with
+ * `organize_buckets` and reduced with `reduce_buckets`.
+ *
+ * Like `pippenger_unsafe`, this uses incomplete addition formulae and must not be used by a verifier.
+ **/
+template <size_t num_initial_points> class fixed_size_msm {
+  public:
+    static constexpr size_t num_points = num_initial_points * 2;
+    static constexpr size_t bits_per_bucket = get_optimal_bucket_width(num_initial_points);
+    static constexpr size_t digit_bits = bits_per_bucket + 1;
+    static constexpr size_t num_buckets = 1UL << bits_per_bucket;
+    static constexpr size_t num_rounds = get_num_rounds(num_points);
+
+    static_assert((num_initial_points & (num_initial_points - 1)) == 0, "MSM size must be a power of two");
+    // The top digit can only absorb a carry without overflowing if the digits cover one bit more than the scalars.
+    static_assert(digit_bits * num_rounds >= wnaf::SCALAR_BITS + 1, "signed digits do not cover an endo scalar");
+
+    fixed_size_msm();
+
+    /**
+     * Compute sum_i scalars[i].points[i], for `points` a pippenger point table (see `generate_pippenger_point_table`)
+     * of at least `num_initial_points` points.
+     **/
+    g1::element pippenger_unsafe(const fr* scalars, g1::affine_element* points);
+
+    void compute_signed_digit_schedule(const fr* scalars);
+
+    g1::element evaluate_rounds(g1::affine_element* points);
+
+  private:
+    pippenger_runtime_state state;
+};
+
+extern template class fixed_size_msm<1UL << 16>;
+extern template class fixed_size_msm<1UL << 17>;
+extern template class fixed_size_msm<1UL << 20>;
+
+} // namespace scalar_multiplication
+} // namespace barretenberg
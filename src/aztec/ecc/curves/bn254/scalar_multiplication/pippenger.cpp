@@ -1,11 +1,79 @@
 #include "pippenger.hpp"
+#include <common/throw_or_abort.hpp>
 #include <srs/io.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifndef __wasm__
+#include <sys/mman.h>
+#endif
 
 namespace barretenberg {
 namespace scalar_multiplication {
 
+std::string get_point_table_cache_path(std::string const& dir, size_t num_points)
+{
+    return dir + "/pippenger_point_table_" + std::to_string(num_points) + ".dat";
+}
+
+/**
+ * 64-bit FNV-1a over every header field but the checksum itself.
+ * This detects truncated or corrupted cache headers, it is not meant to be collision resistant.
+ */
+uint64_t compute_point_table_cache_header_checksum(point_table_cache_header const& header)
+{
+    const uint64_t* words = reinterpret_cast<uint64_t const*>(&header);
+    const size_t num_words = offsetof(point_table_cache_header, checksum) / sizeof(uint64_t);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < num_words; ++i) {
+        hash = (hash ^ words[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static point_table_cache_header make_point_table_cache_header(size_t num_points, std::string const& transcript_path)
+{
+    point_table_cache_header header{};
+    header.magic = point_table_cache_header::MAGIC;
+    header.version = point_table_cache_header::VERSION;
+    header.header_size = sizeof(point_table_cache_header);
+    header.num_points = num_points;
+    header.num_table_entries = num_points * 2;
+    header.srs_size = barretenberg::io::get_transcript_num_g1_points(transcript_path);
+    header.transcript_hash = barretenberg::io::get_transcript_hash(transcript_path, num_points);
+    header.checksum = compute_point_table_cache_header_checksum(header);
+    return header;
+}
+
+bool write_point_table_cache(std::string const& filename,
+                             g1::affine_element const* table,
+                             size_t num_points,
+                             std::string const& transcript_path)
+{
+    const point_table_cache_header header = make_point_table_cache_header(num_points, transcript_path);
+
+    // Write to a temporary file and rename it into place, so that concurrent readers never map a partial table.
+    const std::string tmp_filename = filename + ".tmp." + std::to_string(getpid());
+    std::ofstream file(tmp_filename, std::ios::binary);
+    file.write((char*)&header, sizeof(header));
+    file.write((char*)table, (std::streamsize)(header.num_table_entries * sizeof(g1::affine_element)));
+    file.close();
+    if (!file || std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        std::remove(tmp_filename.c_str());
+        info("Failed to write pippenger point table cache: ", filename);
+        return false;
+    }
+    return true;
+}
+
 Pippenger::Pippenger(uint8_t const* points, size_t num_points)
     : num_points_(num_points)
+    , mapped_base_(nullptr)
+    , mapped_size_(0)
 {
     monomials_ = point_table_alloc<g1::affine_element>(num_points);
 
@@ -15,13 +83,79 @@ Pippenger::Pippenger(uint8_t const* points, size_t num_points)
     barretenberg::scalar_multiplication::generate_pippenger_point_table(monomials_, monomials_, num_points);
 }
 
-Pippenger::Pippenger(std::string const& path, size_t num_points)
+Pippenger::Pippenger(std::string const& path, size_t num_points, std::string const& point_table_cache_dir)
     : num_points_(num_points)
+    , mapped_base_(nullptr)
+    , mapped_size_(0)
 {
+    const std::string cache_path =
+        point_table_cache_dir.empty() ? "" : get_point_table_cache_path(point_table_cache_dir, num_points);
+    if (!cache_path.empty() && map_point_table_cache(cache_path, path)) {
+        return;
+    }
+
     monomials_ = point_table_alloc<g1::affine_element>(num_points);
 
     barretenberg::io::read_transcript_g1(monomials_, num_points, path);
     barretenberg::scalar_multiplication::generate_pippenger_point_table(monomials_, monomials_, num_points);
+
+    if (!cache_path.empty()) {
+        mkdir(point_table_cache_dir.c_str(), 0700);
+        write_point_table_cache(cache_path, monomials_, num_points, path);
+    }
+}
+
+bool Pippenger::map_point_table_cache(std::string const& filename, std::string const& transcript_path)
+{
+#ifdef __wasm__
+    static_cast<void>(filename);
+    static_cast<void>(transcript_path);
+    return false;
+#else
+    const size_t header_size = sizeof(point_table_cache_header);
+    const size_t file_size = header_size + num_points_ * 2 * sizeof(g1::affine_element);
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    // Validate the header before mapping anything. The table is trusted if the header matches the transcript we
+    // would otherwise have read, so loading the cache never touches more of the file than the pages pippenger uses.
+    point_table_cache_header header;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != file_size ||
+        pread(fd, &header, header_size, 0) != (ssize_t)header_size) {
+        close(fd);
+        return false;
+    }
+    const point_table_cache_header expected = make_point_table_cache_header(num_points_, transcript_path);
+    if (memcmp(&header, &expected, header_size) != 0) {
+        info("Ignoring stale or corrupt pippenger point table cache: ", filename);
+        close(fd);
+        return false;
+    }
+
+    // Reserve the full table, including the prefetch overflow, as zeroed anonymous memory, then map the file over
+    // the front of it. Pages are private, so nothing ever writes back to the cache file.
+    const size_t mapped_size = header_size + point_table_buf_size<g1::affine_element>(num_points_);
+    void* base = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    void* file_base = mmap(base, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+    close(fd);
+    if (file_base == MAP_FAILED) {
+        munmap(base, mapped_size);
+        return false;
+    }
+
+    g1::affine_element* table = (g1::affine_element*)((uint8_t*)base + header_size);
+    monomials_ = table;
+    mapped_base_ = base;
+    mapped_size_ = mapped_size;
+    return true;
+#endif
 }
 
 g1::element Pippenger::pippenger_unsafe(fr* scalars, size_t from, size_t range)
@@ -32,8 +166,14 @@ g1::element Pippenger::pippenger_unsafe(fr* scalars, size_t from, size_t range)
 
 Pippenger::~Pippenger()
 {
+#ifndef __wasm__
+    if (mapped_base_) {
+        munmap(mapped_base_, mapped_size_);
+        return;
+    }
+#endif
     free(monomials_);
 }
 
 } // namespace scalar_multiplication
-} // namespace barretenberg
\ No newline at end of file
+} // namespace barretenberg
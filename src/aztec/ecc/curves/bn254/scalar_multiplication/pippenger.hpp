@@ -32,11 +32,50 @@ template <typename T> inline T* point_table_alloc(size_t num_points)
     return (T*)aligned_alloc(64, point_table_buf_size<T>(num_points));
 }
 
+/**
+ * Header of an on-disk pippenger point table cache.
+ * The `2 * num_points` table entries follow the header directly, in host byte order and montgomery form, so a cache
+ * file can be mmap'd and used as the point table without copying. The prefetch overflow is not stored; it is backed by
+ * zeroed pages when the file is mapped.
+ * The table itself is not checksummed, as that would mean reading all of it on every load. Instead the header records
+ * the transcript the table was computed from (`srs_size` and `transcript_hash`, see `io::get_transcript_hash`), and
+ * `checksum` covers the header.
+ */
+struct point_table_cache_header {
+    static constexpr uint64_t MAGIC = 0x454c424154505442ULL; // "BTPTABLE"
+    static constexpr uint32_t VERSION = 2;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t num_points;
+    uint64_t num_table_entries;
+    uint64_t srs_size;
+    uint64_t transcript_hash;
+    uint64_t checksum;
+    uint64_t reserved;
+};
+static_assert(sizeof(point_table_cache_header) == sizeof(g1::affine_element));
+
+std::string get_point_table_cache_path(std::string const& dir, size_t num_points);
+
+uint64_t compute_point_table_cache_header_checksum(point_table_cache_header const& header);
+
+bool write_point_table_cache(std::string const& filename,
+                             g1::affine_element const* table,
+                             size_t num_points,
+                             std::string const& transcript_path);
+
 class Pippenger {
   public:
     Pippenger(uint8_t const* points, size_t num_points);
 
-    Pippenger(std::string const& path, size_t num_points);
+    /**
+     * Read `num_points` monomials from the transcript at `path` and compute their point table.
+     * If `point_table_cache_dir` is given, the table is mapped from a cache file in that directory when a valid one
+     * exists, and written there after being computed otherwise.
+     */
+    Pippenger(std::string const& path, size_t num_points, std::string const& point_table_cache_dir = "");
 
     ~Pippenger();
 
@@ -46,9 +85,15 @@ class Pippenger {
 
     size_t get_num_points() const { return num_points_; }
 
+    bool is_mapped() const { return mapped_base_ != nullptr; }
+
   private:
+    bool map_point_table_cache(std::string const& filename, std::string const& transcript_path);
+
     g1::affine_element* monomials_;
     size_t num_points_;
+    void* mapped_base_;
+    size_t mapped_size_;
 };
 
 } // namespace scalar_multiplication
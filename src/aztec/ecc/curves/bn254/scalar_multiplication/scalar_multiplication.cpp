@@ -5,10 +5,12 @@
 #include <common/max_threads.hpp>
 #include <numeric/bitop/get_msb.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <vector>
 
 #include "../../../groups/wnaf.hpp"
 #include "../fq.hpp"
@@ -933,5 +935,379 @@ g1::element pippenger_unsafe(fr* scalars,
 {
     return pippenger(scalars, points, num_initial_points, state, false);
 }
+
+namespace {
+/**
+ * Get the wnaf entry that `fixed_wnaf_with_counts` would schedule for window `window` (counting from the least
+ * significant window) of a 127-bit endomorphism scalar, without computing the other windows.
+ *
+ * A window's digit only depends on its own bit slice and on whether the slice above it is even: an even slice above
+ * borrows 2^{wnaf_bits} from this window, to make the slice above odd. Windows above the most significant bit of the
+ * scalar have no entry, and neither does a zero scalar. Returns false if there is no entry.
+ **/
+inline bool get_wnaf_window(
+    const uint64_t* scalar, const size_t window, const size_t wnaf_bits, uint32_t& bucket, bool& negative)
+{
+    const uint128_t value = (static_cast<uint128_t>(scalar[1]) << 64) | scalar[0];
+    const uint128_t window_value = value >> (window * wnaf_bits);
+    if (window_value == 0) {
+        return false;
+    }
+    const uint64_t slice = static_cast<uint64_t>(window_value) & ((1ULL << wnaf_bits) - 1);
+    // The lowest window is made odd by the skew, the others by the borrow of the window below them
+    const uint64_t previous = slice + ((slice & 1) == 0);
+    const uint128_t next_value = window_value >> wnaf_bits;
+    negative = (next_value != 0) && ((next_value & 1) == 0);
+    bucket = static_cast<uint32_t>((negative ? (1ULL << wnaf_bits) - previous : previous) >> 1);
+    return true;
+}
+
+/**
+ * One thread's buckets for `pippenger_unsafe_multi`, stored as affine points.
+ *
+ * Points are added into buckets with the affine addition formulae, batched so that a batch of additions shares a
+ * single inversion (see `add_affine_points`). The additions in a batch must be independent, so a point for a bucket
+ * that already has an addition in the current batch is deferred to a later batch. Deferred points that share a bucket
+ * are first added together pairwise, so that a bucket that receives many points (e.g. a skew bucket) does not need one
+ * batch per point.
+ *
+ * A batch refers to the points it adds by pointer, so they must stay put until the batch is evaluated.
+ **/
+struct affine_bucket_accumulator {
+    static constexpr size_t BATCH_SIZE = 1024;
+
+    std::vector<g1::affine_element> buckets;
+    std::vector<uint8_t> bucket_empty_status;
+    std::vector<uint8_t> bucket_queued_status;
+
+    size_t num_batched = 0;
+    std::vector<uint32_t> batch_buckets;
+    std::vector<g1::affine_element*> batch_targets;
+    std::vector<const g1::affine_element*> batch_points;
+    std::vector<uint8_t> batch_negations;
+    std::vector<fq> batch_products;
+    std::vector<std::pair<uint32_t, g1::affine_element>> deferred;
+    std::vector<std::pair<uint32_t, g1::affine_element>> retried;
+
+    affine_bucket_accumulator(const size_t num_buckets)
+        : buckets(num_buckets)
+        , bucket_empty_status(num_buckets, 1)
+        , bucket_queued_status(num_buckets, 0)
+        , batch_buckets(BATCH_SIZE)
+        , batch_targets(BATCH_SIZE)
+        , batch_points(BATCH_SIZE)
+        , batch_negations(BATCH_SIZE)
+        , batch_products(BATCH_SIZE)
+    {}
+
+    void clear() { std::fill(bucket_empty_status.begin(), bucket_empty_status.end(), 1); }
+
+    // Add `point` (or its negation) into `bucket`
+    void add(const uint32_t bucket, const g1::affine_element* point, const bool negate)
+    {
+        if (bucket_queued_status[bucket]) {
+            deferred.emplace_back(bucket, negate ? -*point : *point);
+            if (deferred.size() >= BATCH_SIZE) {
+                flush();
+            }
+            return;
+        }
+        queue(bucket, point, negate);
+    }
+
+    // Complete every queued and deferred addition
+    void flush()
+    {
+        while (num_batched > 0 || !deferred.empty()) {
+            evaluate_batch();
+            reduce_deferred();
+            // Every bucket now has at most one deferred point, and no queued addition
+            retried.swap(deferred);
+            for (const auto& [bucket, point] : retried) {
+                queue(bucket, &point, false);
+            }
+            evaluate_batch();
+            retried.clear();
+        }
+    }
+
+    void queue(const uint32_t bucket, const g1::affine_element* point, const bool negate)
+    {
+        if (bucket_empty_status[bucket]) {
+            g1::conditional_negate_affine(point, &buckets[bucket], negate);
+            bucket_empty_status[bucket] = 0;
+            return;
+        }
+        __builtin_prefetch(&buckets[bucket]);
+        bucket_queued_status[bucket] = 1;
+        batch_buckets[num_batched] = bucket;
+        batch_targets[num_batched] = &buckets[bucket];
+        batch_points[num_batched] = point;
+        batch_negations[num_batched] = negate;
+        if (++num_batched == BATCH_SIZE) {
+            evaluate_batch();
+        }
+    }
+
+    // Add the deferred points of each bucket together, until every bucket has at most one deferred point
+    void reduce_deferred()
+    {
+        std::sort(deferred.begin(), deferred.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        bool reduced = true;
+        while (reduced) {
+            reduced = false;
+            for (size_t i = 0; i + 1 < deferred.size(); ++i) {
+                if (deferred[i].first == deferred[i + 1].first) {
+                    if (num_batched == batch_targets.size()) {
+                        batch_targets.resize(num_batched * 2);
+                        batch_points.resize(num_batched * 2);
+                        batch_negations.resize(num_batched * 2);
+                        batch_products.resize(num_batched * 2);
+                    }
+                    batch_targets[num_batched] = &deferred[i].second;
+                    batch_points[num_batched] = &deferred[i + 1].second;
+                    batch_negations[num_batched] = 0;
+                    ++num_batched;
+                    deferred[i + 1].first = UINT32_MAX;
+                    ++i;
+                }
+            }
+            if (num_batched > 0) {
+                reduced = true;
+                evaluate_batch(false);
+                deferred.erase(std::remove_if(deferred.begin(),
+                                              deferred.end(),
+                                              [](const auto& entry) { return entry.first == UINT32_MAX; }),
+                               deferred.end());
+            }
+        }
+    }
+
+    // Add each batched point into its target, with one inversion for the whole batch
+    void evaluate_batch(const bool into_buckets = true)
+    {
+        if (num_batched == 0) {
+            return;
+        }
+        fq batch_inversion_accumulator = fq::one();
+        for (size_t i = 0; i < num_batched; ++i) {
+            batch_products[i] = batch_inversion_accumulator;
+            batch_inversion_accumulator *= (batch_points[i]->x - batch_targets[i]->x); // x2 - x1
+        }
+        if (batch_inversion_accumulator == 0) {
+            throw_or_abort("attempted to invert zero in affine_bucket_accumulator");
+        }
+        batch_inversion_accumulator = batch_inversion_accumulator.invert();
+
+        for (size_t i = num_batched - 1; i < num_batched; --i) {
+            g1::affine_element& target = *batch_targets[i];
+            const g1::affine_element& point = *batch_points[i];
+            const fq y_difference = batch_negations[i] ? -(point.y + target.y) : (point.y - target.y); // y2 - y1
+            const fq lambda = y_difference * (batch_inversion_accumulator * batch_products[i]);
+            batch_inversion_accumulator *= (point.x - target.x);
+            const fq x3 = lambda.sqr() - target.x - point.x;
+            target.y = lambda * (target.x - x3) - target.y;
+            target.x = x3;
+        }
+        if (into_buckets) {
+            for (size_t i = 0; i < num_batched; ++i) {
+                bucket_queued_status[batch_buckets[i]] = 0;
+            }
+        }
+        num_batched = 0;
+    }
+};
+} // namespace
+
+/**
+ * Compute the multi-scalar multiplications of several scalar vectors against the same `points`, streaming the points
+ * from memory once per round rather than once per round for every vector.
+ *
+ * `pippenger` sorts each round's wnaf entries by bucket, so that threads own disjoint bucket ranges, and then gathers
+ * the points in bucket order: K scalar vectors gather all of the points K times per round. Here, each round instead
+ * walks over the points in order, computing the round's wnaf entry of every vector for each point as it goes (see
+ * `get_wnaf_window`), and adds the point into the buckets of all K vectors at once. Each thread walks its own slice of
+ * the points and owns a full set of buckets for every vector. At the end of a round, the threads merge their bucket
+ * sets one bucket range at a time, and each thread concatenates its bucket range for every vector as in
+ * `evaluate_pippenger_rounds`.
+ *
+ * The endomorphism-split scalars (32 bytes per scalar) and the bucket sets (64 bytes per bucket per vector per thread)
+ * are the only extra memory; no point schedule is stored. The skew is corrected with one extra bucket per vector in the
+ * last round.
+ *
+ * Like `pippenger_unsafe`, this uses incomplete addition formulae and must not be used by a verifier.
+ * Fewer than two vectors, or too few points to share between threads, go through `pippenger_unsafe`.
+ **/
+std::vector<g1::element> pippenger_unsafe_multi(const std::vector<fr*>& scalars,
+                                                g1::affine_element* points,
+                                                const size_t num_initial_points,
+                                                pippenger_runtime_state& state)
+{
+    const size_t num_vectors = scalars.size();
+#ifndef NO_MULTITHREADING
+    const size_t num_threads = max_threads::compute_num_threads();
+    const size_t threshold = std::max(num_threads * 8, 8UL);
+#else
+    const size_t num_threads = 1;
+    const size_t threshold = 8UL;
+#endif
+    std::vector<g1::element> results;
+    if (num_vectors < 2 || num_initial_points <= threshold) {
+        for (fr* vector_scalars : scalars) {
+            results.push_back(pippenger_unsafe(vector_scalars, points, num_initial_points, state));
+        }
+        return results;
+    }
+
+    const size_t num_points = num_initial_points * 2;
+    const size_t bits_per_bucket = get_optimal_bucket_width(num_initial_points);
+    const size_t wnaf_bits = bits_per_bucket + 1;
+    const size_t num_rounds = get_num_rounds(num_points);
+    const size_t num_buckets = 1UL << bits_per_bucket;
+    // Every vector has its buckets followed by its skew bucket
+    const size_t num_vector_buckets = num_buckets + 1;
+
+    // Endomorphism-split scalars, for all vectors of a point next to each other
+    std::vector<uint64_t> split_scalars(num_points * num_vectors * 2);
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < num_initial_points; ++i) {
+        for (size_t k = 0; k < num_vectors; ++k) {
+            fr T0 = scalars[k][i].from_montgomery_form();
+            fr::split_into_endomorphism_scalars(T0, T0, *(fr*)&T0.data[2]);
+            uint64_t* k1 = &split_scalars[((2 * i) * num_vectors + k) * 2];
+            uint64_t* k2 = &split_scalars[((2 * i + 1) * num_vectors + k) * 2];
+            k1[0] = T0.data[0];
+            k1[1] = T0.data[1];
+            k2[0] = T0.data[2];
+            k2[1] = T0.data[3];
+        }
+    }
+
+    std::vector<affine_bucket_accumulator> thread_buckets(num_threads,
+                                                          affine_bucket_accumulator(num_vectors * num_vector_buckets));
+    std::vector<g1::element> thread_accumulators(num_threads * num_vectors);
+    results.resize(num_vectors);
+    for (auto& result : results) {
+        result.self_set_infinity();
+    }
+    const size_t num_points_per_thread = num_points / num_threads;
+
+    for (size_t i = 0; i < num_rounds; ++i) {
+        const size_t window = num_rounds - 1 - i;
+        const bool last_round = (i == num_rounds - 1);
+
+        // Add every point into its bucket of every vector, each thread over its own slice of the points
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+        for (size_t j = 0; j < num_threads; ++j) {
+            affine_bucket_accumulator& accumulator = thread_buckets[j];
+            accumulator.clear();
+            const size_t end = (j == num_threads - 1) ? num_points : (j + 1) * num_points_per_thread;
+            for (size_t point_index = j * num_points_per_thread; point_index < end; ++point_index) {
+                const g1::affine_element& point = points[point_index];
+                const uint64_t* point_scalars = &split_scalars[point_index * num_vectors * 2];
+                for (size_t k = 0; k < num_vectors; ++k) {
+                    const uint64_t* scalar = &point_scalars[k * 2];
+                    const uint32_t vector_offset = static_cast<uint32_t>(k * num_vector_buckets);
+                    uint32_t bucket;
+                    bool negative;
+                    if (get_wnaf_window(scalar, window, wnaf_bits, bucket, negative)) {
+                        accumulator.add(vector_offset + bucket, &point, negative);
+                    }
+                    // An even scalar was made odd by adding one to it, so subtract the point once
+                    if (last_round && ((scalar[0] & 1) == 0) && ((scalar[0] | scalar[1]) != 0)) {
+                        accumulator.add(vector_offset + static_cast<uint32_t>(num_buckets), &point, true);
+                    }
+                }
+            }
+            accumulator.flush();
+        }
+
+        // Merge the threads' buckets into thread j's buckets over thread j's bucket range, and concatenate them
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+        for (size_t j = 0; j < num_threads; ++j) {
+            affine_bucket_accumulator& accumulator = thread_buckets[j];
+            const size_t first_bucket = (j * num_buckets) / num_threads;
+            // The last thread also owns the skew buckets
+            const size_t end_bucket =
+                (j == num_threads - 1) ? num_vector_buckets : ((j + 1) * num_buckets) / num_threads;
+            for (size_t k = 0; k < num_vectors; ++k) {
+                for (size_t l = 0; l < num_threads; ++l) {
+                    if (l == j) {
+                        continue;
+                    }
+                    for (size_t m = first_bucket; m < end_bucket; ++m) {
+                        const size_t bucket = k * num_vector_buckets + m;
+                        if (!thread_buckets[l].bucket_empty_status[bucket]) {
+                            accumulator.add(static_cast<uint32_t>(bucket), &thread_buckets[l].buckets[bucket], false);
+                        }
+                    }
+                }
+            }
+            accumulator.flush();
+
+            const size_t concatenation_end = std::min(end_bucket, num_buckets);
+            for (size_t k = 0; k < num_vectors; ++k) {
+                g1::element& thread_accumulator = thread_accumulators[j * num_vectors + k];
+                thread_accumulator.self_set_infinity();
+                const g1::affine_element* output_buckets = &accumulator.buckets[k * num_vector_buckets];
+                const uint8_t* bucket_empty_status = &accumulator.bucket_empty_status[k * num_vector_buckets];
+                if (last_round && end_bucket == num_vector_buckets && !bucket_empty_status[num_buckets]) {
+                    thread_accumulator += output_buckets[num_buckets];
+                }
+                if (concatenation_end <= first_bucket) {
+                    continue;
+                }
+
+                g1::element running_sum;
+                running_sum.self_set_infinity();
+                g1::element bucket_sum;
+                bucket_sum.self_set_infinity();
+                for (size_t m = concatenation_end - 1; m > first_bucket; --m) {
+                    if (!bucket_empty_status[m]) {
+                        running_sum += output_buckets[m];
+                    }
+                    bucket_sum += running_sum;
+                }
+                if (!bucket_empty_status[first_bucket]) {
+                    running_sum += output_buckets[first_bucket];
+                }
+                bucket_sum.self_dbl();
+                bucket_sum += running_sum;
+
+                // Bucket m holds the multiples of (2m + 1), so scale the running sum up to the first bucket
+                if (first_bucket > 0) {
+                    const uint64_t multiplier = static_cast<uint64_t>(first_bucket << 1UL);
+                    g1::element rolling_accumulator = running_sum;
+                    for (size_t shift = numeric::get_msb(multiplier); shift > 0; --shift) {
+                        rolling_accumulator.self_dbl();
+                        if (((multiplier >> (shift - 1)) & 1) == 1) {
+                            rolling_accumulator += running_sum;
+                        }
+                    }
+                    bucket_sum += rolling_accumulator;
+                }
+                thread_accumulator += bucket_sum;
+            }
+        }
+
+        for (size_t k = 0; k < num_vectors; ++k) {
+            if (i > 0) {
+                for (size_t l = 0; l < wnaf_bits; ++l) {
+                    results[k].self_dbl();
+                }
+            }
+            for (size_t j = 0; j < num_threads; ++j) {
+                results[k] += thread_accumulators[j * num_vectors + k];
+            }
+        }
+    }
+    return results;
+}
 } // namespace scalar_multiplication
 } // namespace barretenberg
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "./runtime_states.hpp"
 #include <stddef.h>
 #include <stdint.h>
+#include <vector>
 
 namespace barretenberg {
 namespace scalar_multiplication {
@@ -147,5 +148,10 @@ g1::element pippenger_unsafe(fr* scalars,
                              const size_t num_initial_points,
                              pippenger_runtime_state& state);
 
+std::vector<g1::element> pippenger_unsafe_multi(const std::vector<fr*>& scalars,
+                                                g1::affine_element* points,
+                                                const size_t num_initial_points,
+                                                pippenger_runtime_state& state);
+
 } // namespace scalar_multiplication
 } // namespace barretenberg
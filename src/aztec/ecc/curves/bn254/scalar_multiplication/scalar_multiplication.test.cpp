@@ -1,18 +1,19 @@
-// #include "pippenger.hpp"
-// #include "scalar_multiplication.hpp"
-// #include <chrono>
-// #include <common/test.hpp>
-// #include <srs/io.hpp>
-// #include <vector>
+#include "fixed_size_msm.hpp"
+#include "pippenger.hpp"
+#include "scalar_multiplication.hpp"
+#include <chrono>
+#include <common/test.hpp>
+#include <srs/io.hpp>
+#include <vector>
 
 // #include <numeric/random/engine.hpp>
 
-// #include <common/mem.hpp>
+#include <common/mem.hpp>
 
-// #define BARRETENBERG_SRS_PATH "../srs_db"
+#define BARRETENBERG_SRS_PATH "../srs_db"
 
-// using namespace barretenberg;
-// using namespace barretenberg::scalar_multiplication;
+using namespace barretenberg;
+using namespace barretenberg::scalar_multiplication;
 
 // namespace {
 // auto& engine = numeric::random::get_debug_engine();
@@ -926,3 +927,77 @@
 
 //     EXPECT_EQ(result.is_point_at_infinity(), true);
 // }
+
+TEST(scalar_multiplication, pippenger_unsafe_multi)
+{
+    // Not a power of two, to check the split of the points between threads.
+    constexpr size_t num_points = 4096 + 300;
+    constexpr size_t num_vectors = 4;
+
+    g1::affine_element* points = scalar_multiplication::point_table_alloc<g1::affine_element>(num_points);
+    for (size_t i = 0; i < num_points; ++i) {
+        points[i] = g1::affine_element(g1::element::random_element());
+    }
+    scalar_multiplication::generate_pippenger_point_table(points, points, num_points);
+
+    std::vector<std::vector<fr>> scalar_vectors(num_vectors, std::vector<fr>(num_points));
+    std::vector<fr*> scalars;
+    for (auto& scalar_vector : scalar_vectors) {
+        for (auto& scalar : scalar_vector) {
+            scalar = fr::random_element();
+        }
+        scalars.push_back(&scalar_vector[0]);
+    }
+    // Small scalars leave the top windows empty, zeros have no windows at all and a run of equal scalars piles points
+    // into the same buckets.
+    for (size_t i = 0; i < num_points; ++i) {
+        scalar_vectors[1][i] = fr(i % 5);
+        if (i < 1000) {
+            scalar_vectors[2][i] = fr(7);
+        }
+    }
+
+    scalar_multiplication::pippenger_runtime_state state(num_points);
+    std::vector<g1::element> results =
+        scalar_multiplication::pippenger_unsafe_multi(scalars, points, num_points, state);
+
+    EXPECT_EQ(results.size(), num_vectors);
+    for (size_t i = 0; i < num_vectors; ++i) {
+        g1::element expected = scalar_multiplication::pippenger_unsafe(scalars[i], points, num_points, state);
+        EXPECT_EQ(results[i].normalize(), expected.normalize());
+    }
+
+    aligned_free(points);
+}
+
+TEST(scalar_multiplication, fixed_size_msm)
+{
+    constexpr size_t num_points = 1 << 16;
+    Pippenger srs(BARRETENBERG_SRS_PATH, num_points);
+
+    std::vector<fr> scalars(num_points);
+    for (auto& scalar : scalars) {
+        scalar = fr::random_element();
+    }
+    // Exercise zero digits, and digits that carry into the next window.
+    scalars[0] = 0;
+    scalars[1] = 1;
+    scalars[2] = -fr(1);
+    scalars[3] = fr((1ULL << 13) - 1);
+
+    fixed_size_msm<num_points> msm;
+    g1::element result = msm.pippenger_unsafe(&scalars[0], srs.get_point_table());
+
+    pippenger_runtime_state state(num_points);
+    g1::element expected =
+        scalar_multiplication::pippenger_unsafe(&scalars[0], srs.get_point_table(), num_points, state);
+
+    EXPECT_EQ(result.normalize(), expected.normalize());
+
+    // The same engine can be reused for another MSM of its size.
+    std::fill(scalars.begin(), scalars.end(), fr(0));
+    scalars[num_points - 1] = fr::random_element();
+    result = msm.pippenger_unsafe(&scalars[0], srs.get_point_table());
+    expected = g1::element(srs.get_point_table()[2 * (num_points - 1)]) * scalars[num_points - 1];
+    EXPECT_EQ(result.normalize(), expected.normalize());
+}
@@ -0,0 +1,293 @@
+#include "batch_arithmetic.hpp"
+
+#if BBERG_BATCH_AVX512
+// GCC 12 reports false positives inside the AVX-512 shift intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+#define BBERG_AVX512F __attribute__((target("avx512f"), always_inline)) inline
+#define BBERG_AVX512IFMA __attribute__((target("avx512f,avx512ifma"), always_inline)) inline
+
+namespace barretenberg {
+namespace batch_arithmetic {
+namespace {
+constexpr uint64_t LIMB_MASK = (1ULL << 52) - 1;
+
+/**
+ * Load 8 consecutive field elements, and transpose them so that w[i] holds the i'th 64-bit word of every element
+ **/
+BBERG_AVX512F void load_words(const uint64_t* src, __m512i (&w)[4])
+{
+    // r0 holds elements 0 and 1, r1 elements 2 and 3, and so on
+    const __m512i r0 = _mm512_loadu_si512(src);
+    const __m512i r1 = _mm512_loadu_si512(src + 8);
+    const __m512i r2 = _mm512_loadu_si512(src + 16);
+    const __m512i r3 = _mm512_loadu_si512(src + 24);
+
+    // words 0 and 2 (resp. 1 and 3) of four elements
+    const __m512i even_words = _mm512_setr_epi64(0, 4, 8, 12, 2, 6, 10, 14);
+    const __m512i odd_words = _mm512_setr_epi64(1, 5, 9, 13, 3, 7, 11, 15);
+    const __m512i a02 = _mm512_permutex2var_epi64(r0, even_words, r1);
+    const __m512i a13 = _mm512_permutex2var_epi64(r0, odd_words, r1);
+    const __m512i b02 = _mm512_permutex2var_epi64(r2, even_words, r3);
+    const __m512i b13 = _mm512_permutex2var_epi64(r2, odd_words, r3);
+
+    const __m512i lo_halves = _mm512_setr_epi64(0, 1, 2, 3, 8, 9, 10, 11);
+    const __m512i hi_halves = _mm512_setr_epi64(4, 5, 6, 7, 12, 13, 14, 15);
+    w[0] = _mm512_permutex2var_epi64(a02, lo_halves, b02);
+    w[1] = _mm512_permutex2var_epi64(a13, lo_halves, b13);
+    w[2] = _mm512_permutex2var_epi64(a02, hi_halves, b02);
+    w[3] = _mm512_permutex2var_epi64(a13, hi_halves, b13);
+}
+
+/**
+ * Inverse of `load_words`
+ **/
+BBERG_AVX512F void store_words(uint64_t* dest, const __m512i (&w)[4])
+{
+    const __m512i lo_halves = _mm512_setr_epi64(0, 1, 2, 3, 8, 9, 10, 11);
+    const __m512i hi_halves = _mm512_setr_epi64(4, 5, 6, 7, 12, 13, 14, 15);
+    const __m512i a02 = _mm512_permutex2var_epi64(w[0], lo_halves, w[2]);
+    const __m512i b02 = _mm512_permutex2var_epi64(w[0], hi_halves, w[2]);
+    const __m512i a13 = _mm512_permutex2var_epi64(w[1], lo_halves, w[3]);
+    const __m512i b13 = _mm512_permutex2var_epi64(w[1], hi_halves, w[3]);
+
+    const __m512i first_pair = _mm512_setr_epi64(0, 8, 4, 12, 1, 9, 5, 13);
+    const __m512i second_pair = _mm512_setr_epi64(2, 10, 6, 14, 3, 11, 7, 15);
+    _mm512_storeu_si512(dest, _mm512_permutex2var_epi64(a02, first_pair, a13));
+    _mm512_storeu_si512(dest + 8, _mm512_permutex2var_epi64(a02, second_pair, a13));
+    _mm512_storeu_si512(dest + 16, _mm512_permutex2var_epi64(b02, first_pair, b13));
+    _mm512_storeu_si512(dest + 24, _mm512_permutex2var_epi64(b02, second_pair, b13));
+}
+
+/**
+ * Split 4 x 64-bit words into 5 x 52-bit limbs
+ **/
+BBERG_AVX512F void to_limbs(const __m512i (&w)[4], __m512i (&l)[5])
+{
+    const __m512i mask = _mm512_set1_epi64(LIMB_MASK);
+    l[0] = _mm512_and_si512(w[0], mask);
+    l[1] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(w[0], 52), _mm512_slli_epi64(w[1], 12)), mask);
+    l[2] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(w[1], 40), _mm512_slli_epi64(w[2], 24)), mask);
+    l[3] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(w[2], 28), _mm512_slli_epi64(w[3], 36)), mask);
+    l[4] = _mm512_srli_epi64(w[3], 16);
+}
+
+/**
+ * As `to_limbs`, for 16 times the input. Inputs are < 2^255, so this still fits in 5 limbs
+ **/
+BBERG_AVX512F void to_limbs_times_16(const __m512i (&w)[4], __m512i (&l)[5])
+{
+    const __m512i mask = _mm512_set1_epi64(LIMB_MASK);
+    l[0] = _mm512_and_si512(_mm512_slli_epi64(w[0], 4), mask);
+    l[1] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(w[0], 48), _mm512_slli_epi64(w[1], 16)), mask);
+    l[2] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(w[1], 36), _mm512_slli_epi64(w[2], 28)), mask);
+    l[3] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(w[2], 24), _mm512_slli_epi64(w[3], 40)), mask);
+    l[4] = _mm512_srli_epi64(w[3], 12);
+}
+
+/**
+ * Join 5 normalized 52-bit limbs of a value < 2^256 into 4 x 64-bit words
+ **/
+BBERG_AVX512F void from_limbs(const __m512i (&l)[5], __m512i (&w)[4])
+{
+    w[0] = _mm512_or_si512(l[0], _mm512_slli_epi64(l[1], 52));
+    w[1] = _mm512_or_si512(_mm512_srli_epi64(l[1], 12), _mm512_slli_epi64(l[2], 40));
+    w[2] = _mm512_or_si512(_mm512_srli_epi64(l[2], 24), _mm512_slli_epi64(l[3], 28));
+    w[3] = _mm512_or_si512(_mm512_srli_epi64(l[3], 36), _mm512_slli_epi64(l[4], 16));
+}
+
+/**
+ * Broadcast the 52-bit limbs of 2^shift * p
+ **/
+__attribute__((target("avx512f"))) void broadcast_modulus_limbs(const modulus_params& params,
+                                                                 const size_t shift,
+                                                                 __m512i (&l)[5])
+{
+    const uint64_t* p = params.modulus;
+    const uint64_t words[4]{ p[0] << shift,
+                             (p[1] << shift) | (shift ? p[0] >> (64 - shift) : 0),
+                             (p[2] << shift) | (shift ? p[1] >> (64 - shift) : 0),
+                             (p[3] << shift) | (shift ? p[2] >> (64 - shift) : 0) };
+    l[0] = _mm512_set1_epi64(static_cast<int64_t>(words[0] & LIMB_MASK));
+    l[1] = _mm512_set1_epi64(static_cast<int64_t>(((words[0] >> 52) | (words[1] << 12)) & LIMB_MASK));
+    l[2] = _mm512_set1_epi64(static_cast<int64_t>(((words[1] >> 40) | (words[2] << 24)) & LIMB_MASK));
+    l[3] = _mm512_set1_epi64(static_cast<int64_t>(((words[2] >> 28) | (words[3] << 36)) & LIMB_MASK));
+    l[4] = _mm512_set1_epi64(static_cast<int64_t>(words[3] >> 16));
+}
+
+/**
+ * Compute a.b.2^{-260} mod p, in [0, 2p), for a.b < 2^260.p (this is the radix 2^52 analogue of
+ * `field::montgomery_mul`).
+ *
+ * `field` uses a Montgomery radix of 2^256, so callers pass 16b for b, which puts the result back into Montgomery
+ * form. For a, b < 2p, a.16b < 64p^2, which is within the bound as 64p < 2^260.
+ *
+ * Limbs are accumulated without carry propagation: every lane starts below 2^52 and gains fewer than 2^58 over the
+ * 5 rounds, so a 64-bit lane never overflows. Carries are only propagated at the end.
+ **/
+BBERG_AVX512IFMA void montgomery_mul(const __m512i (&a)[5],
+                                     const __m512i (&b)[5],
+                                     __m512i (&r)[5],
+                                     const __m512i (&p)[5],
+                                     const __m512i r_inv)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i t[6]{ zero, zero, zero, zero, zero, zero };
+    for (size_t i = 0; i < 5; ++i) {
+        for (size_t j = 0; j < 5; ++j) {
+            t[j] = _mm512_madd52lo_epu64(t[j], a[i], b[j]);
+            t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], a[i], b[j]);
+        }
+        // m = -t / p mod 2^52, so that t + m.p is divisible by 2^52
+        const __m512i m = _mm512_madd52lo_epu64(zero, t[0], r_inv);
+        for (size_t j = 0; j < 5; ++j) {
+            t[j] = _mm512_madd52lo_epu64(t[j], m, p[j]);
+            t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], m, p[j]);
+        }
+        t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], 52));
+        for (size_t j = 0; j < 5; ++j) {
+            t[j] = t[j + 1];
+        }
+        t[5] = zero;
+    }
+
+    const __m512i mask = _mm512_set1_epi64(LIMB_MASK);
+    for (size_t j = 0; j < 4; ++j) {
+        t[j + 1] = _mm512_add_epi64(t[j + 1], _mm512_srli_epi64(t[j], 52));
+        r[j] = _mm512_and_si512(t[j], mask);
+    }
+    r[4] = t[4];
+}
+
+/**
+ * Given s < 4p, as 5 limbs that may be negative or exceed 52 bits, return s mod 2p in [0, 2p) as normalized limbs
+ **/
+BBERG_AVX512F void reduce_twice_modulus(__m512i (&s)[5], const __m512i (&twice_p)[5])
+{
+    const __m512i mask = _mm512_set1_epi64(LIMB_MASK);
+    for (size_t j = 0; j < 4; ++j) {
+        s[j + 1] = _mm512_add_epi64(s[j + 1], _mm512_srai_epi64(s[j], 52));
+        s[j] = _mm512_and_si512(s[j], mask);
+    }
+    __m512i d[5];
+    __m512i borrow = _mm512_setzero_si512();
+    for (size_t j = 0; j < 4; ++j) {
+        d[j] = _mm512_add_epi64(_mm512_sub_epi64(s[j], twice_p[j]), borrow);
+        borrow = _mm512_srai_epi64(d[j], 52);
+        d[j] = _mm512_and_si512(d[j], mask);
+    }
+    d[4] = _mm512_add_epi64(_mm512_sub_epi64(s[4], twice_p[4]), borrow);
+    // keep s - 2p wherever it did not underflow
+    const __mmask8 no_underflow = _mm512_cmpge_epi64_mask(d[4], _mm512_setzero_si512());
+    for (size_t j = 0; j < 5; ++j) {
+        s[j] = _mm512_mask_mov_epi64(s[j], no_underflow, d[j]);
+    }
+}
+} // namespace
+
+bool has_avx512f() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("avx512f");
+    return supported;
+}
+
+bool has_avx512ifma() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+    return supported;
+}
+
+__attribute__((target("avx512f,avx512ifma"))) void mul_ifma(
+    const uint64_t* a, const uint64_t* b, uint64_t* r, const size_t n, const modulus_params& params) noexcept
+{
+    __m512i p[5];
+    broadcast_modulus_limbs(params, 0, p);
+    const __m512i r_inv = _mm512_set1_epi64(static_cast<int64_t>(params.r_inv & LIMB_MASK));
+    for (size_t i = 0; i < n; i += NUM_LANES) {
+        __m512i words[4];
+        __m512i left[5];
+        __m512i right[5];
+        __m512i result[5];
+        load_words(a + 4 * i, words);
+        to_limbs(words, left);
+        load_words(b + 4 * i, words);
+        to_limbs_times_16(words, right);
+        montgomery_mul(left, right, result, p, r_inv);
+        from_limbs(result, words);
+        store_words(r + 4 * i, words);
+    }
+}
+
+__attribute__((target("avx512f,avx512ifma"))) void sqr_ifma(const uint64_t* a,
+                                                             uint64_t* r,
+                                                             const size_t n,
+                                                             const modulus_params& params) noexcept
+{
+    __m512i p[5];
+    broadcast_modulus_limbs(params, 0, p);
+    const __m512i r_inv = _mm512_set1_epi64(static_cast<int64_t>(params.r_inv & LIMB_MASK));
+    for (size_t i = 0; i < n; i += NUM_LANES) {
+        __m512i words[4];
+        __m512i left[5];
+        __m512i right[5];
+        __m512i result[5];
+        load_words(a + 4 * i, words);
+        to_limbs(words, left);
+        to_limbs_times_16(words, right);
+        montgomery_mul(left, right, result, p, r_inv);
+        from_limbs(result, words);
+        store_words(r + 4 * i, words);
+    }
+}
+
+__attribute__((target("avx512f"))) void add_avx512(
+    const uint64_t* a, const uint64_t* b, uint64_t* r, const size_t n, const modulus_params& params) noexcept
+{
+    __m512i twice_p[5];
+    broadcast_modulus_limbs(params, 1, twice_p);
+    for (size_t i = 0; i < n; i += NUM_LANES) {
+        __m512i words[4];
+        __m512i left[5];
+        __m512i right[5];
+        load_words(a + 4 * i, words);
+        to_limbs(words, left);
+        load_words(b + 4 * i, words);
+        to_limbs(words, right);
+        for (size_t j = 0; j < 5; ++j) {
+            left[j] = _mm512_add_epi64(left[j], right[j]);
+        }
+        reduce_twice_modulus(left, twice_p);
+        from_limbs(left, words);
+        store_words(r + 4 * i, words);
+    }
+}
+
+__attribute__((target("avx512f"))) void sub_avx512(
+    const uint64_t* a, const uint64_t* b, uint64_t* r, const size_t n, const modulus_params& params) noexcept
+{
+    __m512i twice_p[5];
+    broadcast_modulus_limbs(params, 1, twice_p);
+    for (size_t i = 0; i < n; i += NUM_LANES) {
+        __m512i words[4];
+        __m512i left[5];
+        __m512i right[5];
+        load_words(a + 4 * i, words);
+        to_limbs(words, left);
+        load_words(b + 4 * i, words);
+        to_limbs(words, right);
+        // a - b + 2p is in (0, 4p)
+        for (size_t j = 0; j < 5; ++j) {
+            left[j] = _mm512_sub_epi64(_mm512_add_epi64(left[j], twice_p[j]), right[j]);
+        }
+        reduce_twice_modulus(left, twice_p);
+        from_limbs(left, words);
+        store_words(r + 4 * i, words);
+    }
+}
+
+} // namespace batch_arithmetic
+} // namespace barretenberg
+#endif
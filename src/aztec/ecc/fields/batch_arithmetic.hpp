@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) && !defined(__wasm__) && !defined(DISABLE_SHENANIGANS)
+#define BBERG_BATCH_AVX512 1
+#else
+#define BBERG_BATCH_AVX512 0
+#endif
+
+namespace barretenberg {
+namespace batch_arithmetic {
+
+/**
+ * SIMD kernels behind `field::mul_batch`, `sqr_batch`, `add_batch` and `sub_batch`.
+ *
+ * Each kernel processes 8 field elements at a time, one per 64-bit lane of a 512-bit register, so `n` must be a
+ * multiple of `NUM_LANES`. The kernels take the same (coarse, i.e. in [0, 2p)) Montgomery form inputs as `field`
+ * arithmetic, and also produce outputs in [0, 2p). Results may alias inputs.
+ *
+ * Multiplication uses AVX-512 IFMA (52-bit multiply-accumulate) on 5 x 52-bit limbs. It requires p < 2^254, like the
+ * coarse reduction of `field`. There is no AVX2 kernel: AVX2 only has a 32 x 32-bit multiplier, and a 32-bit limb
+ * Montgomery multiplication is slower than the scalar MULX path. `field` falls back to its scalar arithmetic when
+ * the CPU does not support a kernel.
+ **/
+constexpr size_t NUM_LANES = 8;
+
+struct modulus_params {
+    uint64_t modulus[4];
+    // -p^{-1} mod 2^64
+    uint64_t r_inv;
+};
+
+#if BBERG_BATCH_AVX512
+// Runtime CPU dispatch, evaluated once
+bool has_avx512f() noexcept;
+bool has_avx512ifma() noexcept;
+
+void mul_ifma(const uint64_t* a, const uint64_t* b, uint64_t* r, size_t n, const modulus_params& params) noexcept;
+void sqr_ifma(const uint64_t* a, uint64_t* r, size_t n, const modulus_params& params) noexcept;
+void add_avx512(const uint64_t* a, const uint64_t* b, uint64_t* r, size_t n, const modulus_params& params) noexcept;
+void sub_avx512(const uint64_t* a, const uint64_t* b, uint64_t* r, size_t n, const modulus_params& params) noexcept;
+#endif
+
+} // namespace batch_arithmetic
+} // namespace barretenberg
@@ -0,0 +1,92 @@
+#include "../curves/bn254/fq.hpp"
+#include "../curves/bn254/fr.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace barretenberg;
+
+namespace test_batch_arithmetic {
+
+// Sizes that exercise both the SIMD kernels and the scalar tail
+constexpr size_t test_sizes[] = { 1, 7, 8, 9, 63, 64, 67 };
+
+// Random elements, every other one of which is represented in [p, 2p) rather than [0, p)
+template <typename Field> std::vector<Field> get_random_elements(const size_t n)
+{
+    std::vector<Field> elements(n);
+    for (size_t i = 0; i < n; ++i) {
+        elements[i] = Field::random_element();
+        if (i & 1) {
+            const uint256_t unreduced = uint256_t(elements[i].data[0],
+                                                  elements[i].data[1],
+                                                  elements[i].data[2],
+                                                  elements[i].data[3]) +
+                                        Field::modulus;
+            elements[i] = Field{ unreduced.data[0], unreduced.data[1], unreduced.data[2], unreduced.data[3] };
+        }
+    }
+    return elements;
+}
+
+template <typename Field> void check_batch_arithmetic()
+{
+    for (const size_t n : test_sizes) {
+        const std::vector<Field> a = get_random_elements<Field>(n);
+        const std::vector<Field> b = get_random_elements<Field>(n);
+        std::vector<Field> result(n);
+
+        Field::mul_batch(&a[0], &b[0], &result[0], n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(result[i], a[i] * b[i]);
+        }
+        Field::sqr_batch(&a[0], &result[0], n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(result[i], a[i].sqr());
+        }
+        Field::add_batch(&a[0], &b[0], &result[0], n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(result[i], a[i] + b[i]);
+        }
+        Field::sub_batch(&a[0], &b[0], &result[0], n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(result[i], a[i] - b[i]);
+        }
+
+        // outputs may alias inputs
+        result = a;
+        Field::mul_batch(&result[0], &b[0], &result[0], n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(result[i], a[i] * b[i]);
+        }
+    }
+}
+
+TEST(batch_arithmetic, fr)
+{
+    check_batch_arithmetic<fr>();
+}
+
+TEST(batch_arithmetic, fq)
+{
+    check_batch_arithmetic<fq>();
+}
+
+TEST(batch_arithmetic, batch_invert)
+{
+    for (const size_t n : test_sizes) {
+        std::vector<fr> coeffs = get_random_elements<fr>(n);
+        // zero elements are left untouched
+        coeffs[n / 2] = fr::zero();
+        std::vector<fr> inverses = coeffs;
+        fr::batch_invert(&inverses[0], n);
+
+        for (size_t i = 0; i < n; ++i) {
+            if (i == n / 2) {
+                EXPECT_EQ(inverses[i], fr::zero());
+            } else {
+                EXPECT_EQ(coeffs[i] * inverses[i], fr::one());
+            }
+        }
+    }
+}
+} // namespace test_batch_arithmetic
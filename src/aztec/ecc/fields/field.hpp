@@ -181,7 +181,17 @@ template <class Params> struct alignas(32) field {
     static constexpr uint256_t modulus_minus_two =
         uint256_t(Params::modulus_0 - 2ULL, Params::modulus_1, Params::modulus_2, Params::modulus_3);
     constexpr field invert() const noexcept;
+    // Inputs of at least this many elements are inverted with interleaved SIMD prefix products, smaller ones with a
+    // single scalar prefix product, which avoids the lane overhead and heap scratch space.
+    static constexpr size_t MIN_INTERLEAVED_BATCH_INVERT_SIZE = 64;
     static void batch_invert(field* coeffs, const size_t n) noexcept;
+
+    // Pointwise arithmetic over arrays of `n` elements: r[i] = a[i] * b[i], a[i]^2, a[i] + b[i] and a[i] - b[i].
+    // These use SIMD kernels where the CPU supports them (see batch_arithmetic.hpp), and `r` may alias the inputs.
+    static void mul_batch(const field* a, const field* b, field* r, const size_t n) noexcept;
+    static void sqr_batch(const field* a, field* r, const size_t n) noexcept;
+    static void add_batch(const field* a, const field* b, field* r, const size_t n) noexcept;
+    static void sub_batch(const field* a, const field* b, field* r, const size_t n) noexcept;
     /**
      * @brief Compute square root of the field element.
      *
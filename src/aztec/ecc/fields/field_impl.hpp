@@ -1,4 +1,6 @@
 #pragma once
+#include "batch_arithmetic.hpp"
+#include <algorithm>
 #include <common/throw_or_abort.hpp>
 #include <numeric/bitop/get_msb.hpp>
 #include <numeric/random/engine.hpp>
@@ -329,32 +331,175 @@ template <class T> constexpr field<T> field<T>::invert() const noexcept
 
 template <class T> void field<T>::batch_invert(field* coeffs, const size_t n) noexcept
 {
-    std::vector<field> temporaries;
-    std::vector<bool> skipped;
-    temporaries.reserve(n);
-    skipped.reserve(n);
-
-    field accumulator = one();
-    for (size_t i = 0; i < n; ++i) {
-        temporaries.emplace_back(accumulator);
-        if (coeffs[i] == field(0)) {
-            skipped.emplace_back(true);
-        } else {
-            skipped.emplace_back(false);
-            accumulator *= coeffs[i];
+    if (n == 0) {
+        return;
+    }
+    if (n < MIN_INTERLEAVED_BATCH_INVERT_SIZE) {
+        // A single prefix product, with its scratch space on the stack
+        std::array<field, MIN_INTERLEAVED_BATCH_INVERT_SIZE> temporaries;
+        std::array<bool, MIN_INTERLEAVED_BATCH_INVERT_SIZE> skipped;
+
+        field accumulator = one();
+        for (size_t i = 0; i < n; ++i) {
+            temporaries[i] = accumulator;
+            skipped[i] = coeffs[i] == field(0);
+            if (!skipped[i]) {
+                accumulator *= coeffs[i];
+            }
+        }
+
+        accumulator = accumulator.invert();
+
+        field T0;
+        for (size_t i = n - 1; i < n; --i) {
+            if (!skipped[i]) {
+                T0 = accumulator * temporaries[i];
+                accumulator *= coeffs[i];
+                coeffs[i] = T0;
+            }
+        }
+        return;
+    }
+    // We run `NUM_LANES` interleaved prefix products (over coeffs[j], coeffs[j + NUM_LANES], ...), so that each step
+    // is a single `mul_batch`. Zero elements are skipped, i.e. multiplied in as one.
+    constexpr size_t num_lanes = batch_arithmetic::NUM_LANES;
+    std::vector<field> temporaries(n);
+    std::vector<bool> skipped(n);
+    std::array<field, num_lanes> accumulators;
+    std::array<field, num_lanes> block;
+    std::array<field, num_lanes> block_temporaries;
+    accumulators.fill(one());
+
+    for (size_t i = 0; i < n; i += num_lanes) {
+        const size_t num_elements = std::min(num_lanes, n - i);
+        for (size_t j = 0; j < num_lanes; ++j) {
+            if (j < num_elements) {
+                temporaries[i + j] = accumulators[j];
+                skipped[i + j] = coeffs[i + j] == field(0);
+            }
+            block[j] = (j < num_elements && !skipped[i + j]) ? coeffs[i + j] : one();
+        }
+        mul_batch(&accumulators[0], &block[0], &accumulators[0], num_lanes);
+    }
+
+    // Invert the lane accumulators with a single inversion
+    field product = one();
+    std::array<field, num_lanes> lane_temporaries;
+    for (size_t j = 0; j < num_lanes; ++j) {
+        lane_temporaries[j] = product;
+        product *= accumulators[j];
+    }
+    product = product.invert();
+    for (size_t j = num_lanes - 1; j < num_lanes; --j) {
+        const field lane_inverse = product * lane_temporaries[j];
+        product *= accumulators[j];
+        accumulators[j] = lane_inverse;
+    }
+
+    for (size_t i = ((n - 1) / num_lanes) * num_lanes; i < n; i -= num_lanes) {
+        const size_t num_elements = std::min(num_lanes, n - i);
+        for (size_t j = 0; j < num_lanes; ++j) {
+            block[j] = (j < num_elements && !skipped[i + j]) ? coeffs[i + j] : one();
+            block_temporaries[j] = (j < num_elements) ? temporaries[i + j] : one();
+        }
+        // block_temporaries[j] becomes the inverse of block[j]
+        mul_batch(&accumulators[0], &block_temporaries[0], &block_temporaries[0], num_lanes);
+        mul_batch(&accumulators[0], &block[0], &accumulators[0], num_lanes);
+        for (size_t j = 0; j < num_elements; ++j) {
+            if (!skipped[i + j]) {
+                coeffs[i + j] = block_temporaries[j];
+            }
+        }
+    }
+}
+
+template <class T> void field<T>::mul_batch(const field* a, const field* b, field* r, const size_t n) noexcept
+{
+    size_t i = 0;
+#if BBERG_BATCH_AVX512
+    if constexpr (modulus.data[3] < 0x4000000000000000ULL) {
+        if (batch_arithmetic::has_avx512ifma()) {
+            constexpr batch_arithmetic::modulus_params params{
+                { T::modulus_0, T::modulus_1, T::modulus_2, T::modulus_3 }, T::r_inv
+            };
+            i = n - (n % batch_arithmetic::NUM_LANES);
+            batch_arithmetic::mul_ifma(reinterpret_cast<const uint64_t*>(a),
+                                       reinterpret_cast<const uint64_t*>(b),
+                                       reinterpret_cast<uint64_t*>(r),
+                                       i,
+                                       params);
         }
     }
+#endif
+    for (; i < n; ++i) {
+        r[i] = a[i] * b[i];
+    }
+}
 
-    accumulator = accumulator.invert();
+template <class T> void field<T>::sqr_batch(const field* a, field* r, const size_t n) noexcept
+{
+    size_t i = 0;
+#if BBERG_BATCH_AVX512
+    if constexpr (modulus.data[3] < 0x4000000000000000ULL) {
+        if (batch_arithmetic::has_avx512ifma()) {
+            constexpr batch_arithmetic::modulus_params params{
+                { T::modulus_0, T::modulus_1, T::modulus_2, T::modulus_3 }, T::r_inv
+            };
+            i = n - (n % batch_arithmetic::NUM_LANES);
+            batch_arithmetic::sqr_ifma(
+                reinterpret_cast<const uint64_t*>(a), reinterpret_cast<uint64_t*>(r), i, params);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        r[i] = a[i].sqr();
+    }
+}
 
-    field T0;
-    for (size_t i = n - 1; i < n; --i) {
-        if (!skipped[i]) {
-            T0 = accumulator * temporaries[i];
-            accumulator *= coeffs[i];
-            coeffs[i] = T0;
+template <class T> void field<T>::add_batch(const field* a, const field* b, field* r, const size_t n) noexcept
+{
+    size_t i = 0;
+#if BBERG_BATCH_AVX512
+    if constexpr (modulus.data[3] < 0x4000000000000000ULL) {
+        if (batch_arithmetic::has_avx512f()) {
+            constexpr batch_arithmetic::modulus_params params{
+                { T::modulus_0, T::modulus_1, T::modulus_2, T::modulus_3 }, T::r_inv
+            };
+            i = n - (n % batch_arithmetic::NUM_LANES);
+            batch_arithmetic::add_avx512(reinterpret_cast<const uint64_t*>(a),
+                                         reinterpret_cast<const uint64_t*>(b),
+                                         reinterpret_cast<uint64_t*>(r),
+                                         i,
+                                         params);
         }
     }
+#endif
+    for (; i < n; ++i) {
+        r[i] = a[i] + b[i];
+    }
+}
+
+template <class T> void field<T>::sub_batch(const field* a, const field* b, field* r, const size_t n) noexcept
+{
+    size_t i = 0;
+#if BBERG_BATCH_AVX512
+    if constexpr (modulus.data[3] < 0x4000000000000000ULL) {
+        if (batch_arithmetic::has_avx512f()) {
+            constexpr batch_arithmetic::modulus_params params{
+                { T::modulus_0, T::modulus_1, T::modulus_2, T::modulus_3 }, T::r_inv
+            };
+            i = n - (n % batch_arithmetic::NUM_LANES);
+            batch_arithmetic::sub_avx512(reinterpret_cast<const uint64_t*>(a),
+                                         reinterpret_cast<const uint64_t*>(b),
+                                         reinterpret_cast<uint64_t*>(r),
+                                         i,
+                                         params);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        r[i] = a[i] - b[i];
+    }
 }
 
 template <class T> constexpr field<T> field<T>::tonelli_shanks_sqrt() const noexcept
@@ -0,0 +1,74 @@
+#include "./pippenger.hpp"
+#include "../curves/bn254/g1.hpp"
+#include "../curves/bn254/scalar_multiplication/scalar_multiplication.hpp"
+#include "../curves/grumpkin/grumpkin.hpp"
+#include "../curves/secp256k1/secp256k1.hpp"
+#include "../curves/secp256r1/secp256r1.hpp"
+#include <benchmark/benchmark.h>
+#include <numeric/random/engine.hpp>
+
+using namespace benchmark;
+using namespace barretenberg;
+
+namespace {
+constexpr size_t MAX_NUM_POINTS = 1 << 16;
+
+auto& engine = numeric::random::get_debug_engine();
+
+// Random scalars and random points. The points must be independent (not e.g. an arithmetic progression), or the
+// incomplete addition formulae of `pippenger_unsafe` will meet equal partial bucket sums.
+template <typename Group> struct msm_inputs {
+    std::vector<typename Group::subgroup_field> scalars;
+    std::vector<typename Group::affine_element> points;
+
+    msm_inputs()
+    {
+        typedef typename Group::element element;
+        std::vector<element> jacobian_points(MAX_NUM_POINTS);
+        for (auto& point : jacobian_points) {
+            point = element::random_element(&engine);
+        }
+        element::batch_normalize(&jacobian_points[0], MAX_NUM_POINTS);
+        for (size_t i = 0; i < MAX_NUM_POINTS; ++i) {
+            points.emplace_back(jacobian_points[i].x, jacobian_points[i].y);
+            scalars.emplace_back(Group::subgroup_field::random_element(&engine));
+        }
+    }
+
+    static msm_inputs& get()
+    {
+        static msm_inputs inputs;
+        return inputs;
+    }
+};
+} // namespace
+
+template <typename Group> void generic_pippenger_bench(State& state) noexcept
+{
+    const size_t num_points = static_cast<size_t>(state.range(0));
+    auto& inputs = msm_inputs<Group>::get();
+    scalar_multiplication::generic::pippenger_runtime_state<Group> runtime_state(num_points);
+    for (auto _ : state) {
+        DoNotOptimize(scalar_multiplication::generic::pippenger_unsafe<Group>(
+            &inputs.scalars[0], &inputs.points[0], num_points, runtime_state));
+    }
+}
+BENCHMARK_TEMPLATE(generic_pippenger_bench, g1)->RangeMultiplier(4)->Range(1 << 10, MAX_NUM_POINTS);
+BENCHMARK_TEMPLATE(generic_pippenger_bench, grumpkin::g1)->RangeMultiplier(4)->Range(1 << 10, MAX_NUM_POINTS);
+BENCHMARK_TEMPLATE(generic_pippenger_bench, secp256k1::g1)->RangeMultiplier(4)->Range(1 << 10, MAX_NUM_POINTS);
+BENCHMARK_TEMPLATE(generic_pippenger_bench, secp256r1::g1)->RangeMultiplier(4)->Range(1 << 10, MAX_NUM_POINTS);
+
+// The bn254-only engine on the same inputs, as a baseline for the generic one
+void bn254_pippenger_bench(State& state) noexcept
+{
+    const size_t num_points = static_cast<size_t>(state.range(0));
+    auto& inputs = msm_inputs<g1>::get();
+    std::vector<g1::affine_element> point_table(num_points * 2);
+    scalar_multiplication::generate_pippenger_point_table(&inputs.points[0], &point_table[0], num_points);
+    std::vector<fr> scalars(inputs.scalars.begin(), inputs.scalars.begin() + static_cast<ptrdiff_t>(num_points));
+    scalar_multiplication::pippenger_runtime_state runtime_state(num_points);
+    for (auto _ : state) {
+        DoNotOptimize(scalar_multiplication::pippenger_unsafe(&scalars[0], &point_table[0], num_points, runtime_state));
+    }
+}
+BENCHMARK(bn254_pippenger_bench)->RangeMultiplier(4)->Range(1 << 10, MAX_NUM_POINTS);
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "./group.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace barretenberg {
+namespace scalar_multiplication {
+/**
+ * A multi-scalar multiplication engine for any `group<Fq, Fr, Params>` (bn254, grumpkin, secp256k1, secp256r1...).
+ *
+ * It follows the design of the bn254 `scalar_multiplication::pippenger` (see `ecc/pippenger.md`):
+ *
+ * 1. Slice every scalar into signed windows and encode one 64-bit schedule entry per (point, round):
+ *    the point index in the high 32 bits, the sign in bit 31 and the bucket index in the low 31 bits.
+ * 2. Radix sort each round's entries into bucket order, so that threads can be handed disjoint ranges of buckets.
+ * 3. Reduce each bucket to a single point with the affine trick: the points of every bucket are arranged into
+ *    independent pairs, which are added with affine formulae sharing one field inversion per batch.
+ * 4. Combine the buckets of a round with a running sum, and the rounds with doublings.
+ *
+ * What differs from the bn254 code is what depends on the curve:
+ *
+ * - Scalars are only split with the endomorphism when the group has one (`Group::USE_ENDOMORPHISM`).
+ *   Otherwise the full scalar is sliced, so the number of rounds is derived from the bit length of `Fr`.
+ * - Windows are signed digits in [-2^{c-1}, 2^{c-1}] rather than odd wnaf digits. Zero digits are not scheduled,
+ *   so there is no skew correction pass, and points at infinity or zero scalars never reach a bucket.
+ * - The doubling formula in the edge-case pair adder includes the curve's `a` coefficient.
+ *
+ * The input points are never modified; the endomorphism point table is held in the runtime state.
+ **/
+namespace generic {
+
+/**
+ * Per-thread view of `pippenger_runtime_state`, used while reducing the buckets of one round.
+ * Mirrors the bn254 `affine_product_runtime_state`.
+ **/
+template <typename Group> struct affine_product_runtime_state {
+    using affine_element = typename Group::affine_element;
+    using Fq = typename Group::coordinate_field;
+
+    const affine_element* points;
+    affine_element* point_pairs_1;
+    affine_element* point_pairs_2;
+    Fq* scratch_space;
+    uint32_t* bucket_counts;
+    uint64_t* point_schedule;
+    uint32_t num_points;
+    uint32_t num_buckets;
+    std::array<uint32_t, 33> bit_offsets;
+};
+
+/**
+ * Scratch memory for `pippenger`. Constructing it with the largest number of points the caller will multiply
+ * allocates (and pages in) everything up front; smaller multiplications reuse it, larger ones grow it.
+ **/
+template <typename Group> struct pippenger_runtime_state {
+    using affine_element = typename Group::affine_element;
+    using Fq = typename Group::coordinate_field;
+
+    // (P, \lambda.P) pairs when the group has an endomorphism, unused otherwise
+    std::vector<affine_element> point_table;
+    std::vector<uint64_t> point_schedule;
+    std::vector<uint64_t> round_counts;
+    std::vector<affine_element> point_pairs_1;
+    std::vector<affine_element> point_pairs_2;
+    std::vector<Fq> scratch_space;
+    std::vector<uint32_t> bucket_counts;
+
+    pippenger_runtime_state(const size_t num_initial_points = 0) { allocate(num_initial_points); }
+
+    void allocate(const size_t num_initial_points);
+
+    affine_product_runtime_state<Group> get_affine_product_runtime_state(const size_t num_threads,
+                                                                         const size_t thread_index,
+                                                                         const size_t num_table_points,
+                                                                         const size_t num_buckets);
+};
+
+template <typename Group> constexpr size_t get_num_scalar_bits();
+
+template <typename Group> constexpr size_t get_num_table_points(const size_t num_initial_points);
+
+constexpr size_t get_window_bits(const size_t num_table_points);
+
+template <typename Group> constexpr size_t get_num_rounds(const size_t num_table_points);
+
+template <typename Group>
+void compute_point_schedule(pippenger_runtime_state<Group>& state,
+                            const typename Group::subgroup_field* scalars,
+                            const typename Group::affine_element* points,
+                            const size_t num_initial_points);
+
+template <typename Group> void organize_buckets(pippenger_runtime_state<Group>& state, const size_t num_table_points);
+
+template <typename Group>
+void add_affine_points(typename Group::affine_element* points,
+                       const size_t num_points,
+                       typename Group::coordinate_field* scratch_space);
+
+template <typename Group>
+void add_affine_points_with_edge_cases(typename Group::affine_element* points,
+                                       const size_t num_points,
+                                       typename Group::coordinate_field* scratch_space);
+
+template <typename Group>
+uint32_t construct_addition_chains(affine_product_runtime_state<Group>& state, bool empty_bucket_counts = true);
+
+template <typename Group>
+void evaluate_addition_chains(affine_product_runtime_state<Group>& state,
+                              const size_t max_bucket_bits,
+                              bool handle_edge_cases);
+
+template <typename Group>
+typename Group::affine_element* reduce_buckets(affine_product_runtime_state<Group>& state,
+                                               bool handle_edge_cases = false);
+
+template <typename Group>
+typename Group::element evaluate_pippenger_rounds(pippenger_runtime_state<Group>& state,
+                                                  const typename Group::affine_element* points,
+                                                  const size_t num_table_points,
+                                                  bool handle_edge_cases = false);
+
+template <typename Group>
+typename Group::element pippenger(const typename Group::subgroup_field* scalars,
+                                  const typename Group::affine_element* points,
+                                  const size_t num_initial_points,
+                                  pippenger_runtime_state<Group>& state,
+                                  bool handle_edge_cases = true);
+
+template <typename Group>
+typename Group::element pippenger_unsafe(const typename Group::subgroup_field* scalars,
+                                         const typename Group::affine_element* points,
+                                         const size_t num_initial_points,
+                                         pippenger_runtime_state<Group>& state);
+
+template <typename Group>
+typename Group::element pippenger(const std::vector<typename Group::subgroup_field>& scalars,
+                                  const std::vector<typename Group::affine_element>& points,
+                                  bool handle_edge_cases = true);
+
+} // namespace generic
+} // namespace scalar_multiplication
+} // namespace barretenberg
+
+#include "./pippenger_impl.hpp"
@@ -0,0 +1,144 @@
+#include "./pippenger.hpp"
+#include "../curves/bn254/g1.hpp"
+#include "../curves/grumpkin/grumpkin.hpp"
+#include "../curves/secp256k1/secp256k1.hpp"
+#include "../curves/secp256r1/secp256r1.hpp"
+#include <gtest/gtest.h>
+#include <numeric/random/engine.hpp>
+
+using namespace barretenberg;
+using namespace barretenberg::scalar_multiplication;
+
+namespace {
+auto& engine = numeric::random::get_debug_engine();
+}
+
+template <typename Group> class generic_pippenger : public testing::Test {
+  public:
+    typedef typename Group::element element;
+    typedef typename Group::affine_element affine_element;
+    typedef typename Group::subgroup_field Fr;
+
+    static std::vector<affine_element> random_points(const size_t num_points)
+    {
+        std::vector<element> points(num_points);
+        for (auto& point : points) {
+            point = element::random_element(&engine);
+        }
+        element::batch_normalize(&points[0], num_points);
+        std::vector<affine_element> result;
+        for (auto& point : points) {
+            result.emplace_back(point.x, point.y);
+        }
+        return result;
+    }
+
+    static std::vector<Fr> random_scalars(const size_t num_scalars)
+    {
+        std::vector<Fr> scalars(num_scalars);
+        for (auto& scalar : scalars) {
+            scalar = Fr::random_element(&engine);
+        }
+        return scalars;
+    }
+
+    static affine_element naive_msm(const std::vector<Fr>& scalars, const std::vector<affine_element>& points)
+    {
+        element result = Group::point_at_infinity;
+        for (size_t i = 0; i < points.size(); ++i) {
+            if (!points[i].is_point_at_infinity()) {
+                result += element(points[i]) * scalars[i];
+            }
+        }
+        return affine_element(result);
+    }
+};
+
+typedef testing::Types<g1, grumpkin::g1, secp256k1::g1, secp256r1::g1> GroupTypes;
+
+TYPED_TEST_SUITE(generic_pippenger, GroupTypes);
+
+TYPED_TEST(generic_pippenger, random_points)
+{
+    typedef typename TypeParam::affine_element affine_element;
+    constexpr size_t num_points = 1000;
+    const auto points = TestFixture::random_points(num_points);
+    const auto scalars = TestFixture::random_scalars(num_points);
+
+    // start from a state that is too small, then reuse the grown state for a smaller multiplication
+    generic::pippenger_runtime_state<TypeParam> state(16);
+    for (const size_t n : { num_points, num_points / 3 }) {
+        const std::vector<affine_element> slice_points(points.begin(), points.begin() + static_cast<ptrdiff_t>(n));
+        const std::vector<typename TestFixture::Fr> slice_scalars(scalars.begin(),
+                                                                  scalars.begin() + static_cast<ptrdiff_t>(n));
+        const affine_element expected = TestFixture::naive_msm(slice_scalars, slice_points);
+
+        const affine_element result(generic::pippenger<TypeParam>(&scalars[0], &points[0], n, state));
+        EXPECT_EQ(result, expected);
+        const affine_element unsafe_result(generic::pippenger_unsafe<TypeParam>(&scalars[0], &points[0], n, state));
+        EXPECT_EQ(unsafe_result, expected);
+    }
+}
+
+TYPED_TEST(generic_pippenger, edge_cases)
+{
+    typedef typename TypeParam::affine_element affine_element;
+    typedef typename TestFixture::Fr Fr;
+    constexpr size_t num_points = 300;
+    const auto distinct_points = TestFixture::random_points(5);
+    const auto random_scalars = TestFixture::random_scalars(3);
+
+    // repeated points with repeated scalars share every bucket (doublings), negated copies cancel out,
+    // and zero scalars, -1 and points at infinity never contribute
+    std::vector<affine_element> points;
+    std::vector<Fr> scalars;
+    for (size_t i = 0; i < num_points; ++i) {
+        affine_element point = distinct_points[i % distinct_points.size()];
+        if (i % 11 == 0) {
+            point = -point;
+        }
+        if (i % 37 == 0) {
+            point = TypeParam::affine_point_at_infinity;
+        }
+        points.push_back(point);
+
+        Fr scalar = random_scalars[i % random_scalars.size()];
+        if (i % 13 == 0) {
+            scalar = Fr::zero();
+        }
+        if (i % 17 == 0) {
+            scalar = -Fr::one();
+        }
+        scalars.push_back(scalar);
+    }
+
+    const affine_element expected = TestFixture::naive_msm(scalars, points);
+    const affine_element result(generic::pippenger<TypeParam>(scalars, points));
+    EXPECT_EQ(result, expected);
+
+    // a point and its negation with the same scalar sum to the point at infinity
+    std::vector<affine_element> cancelling_points;
+    std::vector<Fr> cancelling_scalars;
+    for (size_t i = 0; i < num_points; ++i) {
+        cancelling_points.push_back(distinct_points[i % distinct_points.size()]);
+        cancelling_points.push_back(-distinct_points[i % distinct_points.size()]);
+        cancelling_scalars.push_back(random_scalars[i % random_scalars.size()]);
+        cancelling_scalars.push_back(random_scalars[i % random_scalars.size()]);
+    }
+    const affine_element cancelled(generic::pippenger<TypeParam>(cancelling_scalars, cancelling_points));
+    EXPECT_TRUE(cancelled.is_point_at_infinity());
+}
+
+TYPED_TEST(generic_pippenger, small_inputs)
+{
+    typedef typename TypeParam::affine_element affine_element;
+    auto points = TestFixture::random_points(5);
+    const auto scalars = TestFixture::random_scalars(5);
+    points[2] = TypeParam::affine_point_at_infinity;
+
+    const affine_element result(generic::pippenger<TypeParam>(scalars, points));
+    EXPECT_EQ(result, TestFixture::naive_msm(scalars, points));
+
+    const affine_element empty(generic::pippenger<TypeParam>({}, {}));
+    EXPECT_TRUE(empty.is_point_at_infinity());
+}
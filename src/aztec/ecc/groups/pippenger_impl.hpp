@@ -0,0 +1,625 @@
+#pragma once
+
+#include "../curves/bn254/scalar_multiplication/process_buckets.hpp"
+#include "./wnaf.hpp"
+#include <common/max_threads.hpp>
+#include <common/throw_or_abort.hpp>
+#include <numeric/bitop/get_msb.hpp>
+#include <algorithm>
+#ifndef NO_MULTITHREADING
+#include <omp.h>
+#endif
+
+namespace barretenberg {
+namespace scalar_multiplication {
+namespace generic {
+
+inline size_t get_num_msm_threads()
+{
+#ifndef NO_MULTITHREADING
+    return max_threads::compute_num_threads();
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Number of bits of the scalars we slice into windows. With the endomorphism these are the two halves produced by
+ * `field::split_into_endomorphism_scalars`, which have the same bit length as in the bn254 wnaf code.
+ **/
+template <typename Group> constexpr size_t get_num_scalar_bits()
+{
+    if constexpr (Group::USE_ENDOMORPHISM) {
+        return wnaf::SCALAR_BITS;
+    } else {
+        return static_cast<size_t>(Group::subgroup_field::modulus.get_msb()) + 1;
+    }
+}
+
+template <typename Group> constexpr size_t get_num_table_points(const size_t num_initial_points)
+{
+    return Group::USE_ENDOMORPHISM ? num_initial_points * 2 : num_initial_points;
+}
+
+/**
+ * A window of c bits gives signed digits in [-2^{c-1}, 2^{c-1}], i.e. 2^{c-1} buckets: the same bucket count as
+ * a (c - 1) bit wnaf slice in the bn254 code, so we use the same table of optimal bucket widths.
+ **/
+constexpr size_t get_window_bits(const size_t num_table_points)
+{
+    return wnaf::get_optimal_bucket_width(num_table_points / 2) + 1;
+}
+
+/**
+ * Borrowing from the next window can carry one bit past the top of the scalar, so we need c * rounds > scalar bits
+ **/
+template <typename Group> constexpr size_t get_num_rounds(const size_t num_table_points)
+{
+    const size_t window_bits = get_window_bits(num_table_points);
+    return (get_num_scalar_bits<Group>() + window_bits) / window_bits;
+}
+
+template <typename Group> void pippenger_runtime_state<Group>::allocate(const size_t num_initial_points)
+{
+    const size_t num_table_points = get_num_table_points<Group>(num_initial_points);
+    const size_t num_rounds = get_num_rounds<Group>(num_table_points);
+    const size_t num_buckets = 1UL << (get_window_bits(num_table_points) - 1);
+    const size_t num_threads = get_num_msm_threads();
+    // `construct_addition_chains` prefetches points a few schedule entries ahead of the one it is reading
+    constexpr size_t prefetch_overflow = 16;
+
+    const auto grow = [](auto& buffer, const size_t size) {
+        if (buffer.size() < size) {
+            buffer.resize(size);
+        }
+    };
+    if constexpr (Group::USE_ENDOMORPHISM) {
+        grow(point_table, num_table_points);
+    }
+    grow(point_schedule, num_table_points * num_rounds + prefetch_overflow);
+    grow(round_counts, num_rounds);
+    // each thread gets ceil(num_table_points / num_threads) entries, see `get_affine_product_runtime_state`
+    grow(point_pairs_1, num_table_points + num_threads);
+    grow(point_pairs_2, num_table_points + num_threads);
+    grow(scratch_space, num_table_points + num_threads);
+    grow(bucket_counts, num_threads * num_buckets);
+}
+
+/**
+ * A thread never takes more than ceil(num_table_points / num_threads) schedule entries of a round, so it can own a
+ * fixed slice of that size of the point pair and scratch buffers for all rounds.
+ **/
+template <typename Group>
+affine_product_runtime_state<Group> pippenger_runtime_state<Group>::get_affine_product_runtime_state(
+    const size_t num_threads, const size_t thread_index, const size_t num_table_points, const size_t num_buckets)
+{
+    const size_t points_per_thread = (num_table_points + num_threads - 1) / num_threads;
+    affine_product_runtime_state<Group> product_state;
+    product_state.point_pairs_1 = &point_pairs_1[thread_index * points_per_thread];
+    product_state.point_pairs_2 = &point_pairs_2[thread_index * points_per_thread];
+    product_state.scratch_space = &scratch_space[thread_index * points_per_thread];
+    product_state.bucket_counts = &bucket_counts[thread_index * num_buckets];
+    return product_state;
+}
+
+/**
+ * Fill `state.point_schedule` with one entry per (point, round), rounds being stored in increasing significance.
+ *
+ * Each window value w (plus the carry from the window below) is mapped to a signed digit: if it exceeds 2^{c-1} we
+ * use w - 2^c and carry one into the next window. A digit d != 0 adds the point, negated if d < 0, into bucket |d|-1.
+ * A zero digit is written as an entry for bucket 2^{c-1}, one past the last bucket, which sorts it to the end of the
+ * round where `organize_buckets` drops it.
+ *
+ * With the endomorphism, k.P = k1.P + k2.(\beta.x, -y) (see `field::split_into_endomorphism_scalars`), and the two
+ * points of each input are written to `state.point_table`.
+ **/
+template <typename Group>
+void compute_point_schedule(pippenger_runtime_state<Group>& state,
+                            const typename Group::subgroup_field* scalars,
+                            const typename Group::affine_element* points,
+                            const size_t num_initial_points)
+{
+    using Fq = typename Group::coordinate_field;
+    using Fr = typename Group::subgroup_field;
+    using affine_element = typename Group::affine_element;
+
+    const size_t num_table_points = get_num_table_points<Group>(num_initial_points);
+    const size_t window_bits = get_window_bits(num_table_points);
+    const size_t num_rounds = get_num_rounds<Group>(num_table_points);
+    const uint64_t window_mask = (1ULL << window_bits) - 1;
+    const uint64_t half_window = 1ULL << (window_bits - 1);
+    uint64_t* point_schedule = &state.point_schedule[0];
+
+    const auto schedule_scalar = [&](const uint64_t* limbs, const size_t num_limbs, const uint64_t point_index) {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < num_rounds; ++i) {
+            const size_t bit_position = i * window_bits;
+            const size_t limb = bit_position >> 6;
+            const size_t shift = bit_position & 63;
+            uint64_t slice = 0;
+            if (limb < num_limbs) {
+                slice = limbs[limb] >> shift;
+                if (shift + window_bits > 64 && limb + 1 < num_limbs) {
+                    slice |= limbs[limb + 1] << (64 - shift);
+                }
+            }
+            slice = (slice & window_mask) + carry;
+            carry = (slice > half_window) ? 1 : 0;
+            const uint64_t magnitude = (carry == 1) ? (window_mask + 1) - slice : slice;
+            point_schedule[i * num_table_points + point_index] =
+                (magnitude == 0) ? half_window : ((point_index << 32ULL) | (carry << 31ULL) | (magnitude - 1));
+        }
+    };
+
+    const size_t num_threads = std::max(std::min(get_num_msm_threads(), num_initial_points), 1UL);
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < num_threads; ++j) {
+        const size_t start = (j * num_initial_points) / num_threads;
+        const size_t end = ((j + 1) * num_initial_points) / num_threads;
+        for (size_t i = start; i < end; ++i) {
+            const bool is_infinity = points[i].is_point_at_infinity();
+            const Fr scalar = is_infinity ? Fr::zero() : scalars[i].from_montgomery_form();
+            if constexpr (Group::USE_ENDOMORPHISM) {
+                state.point_table[2 * i] = points[i];
+                state.point_table[2 * i + 1] =
+                    is_infinity ? points[i] : affine_element(points[i].x * Fq::beta(), -points[i].y);
+
+                Fr endo_scalars{ 0, 0, 0, 0 };
+                Fr::split_into_endomorphism_scalars(scalar, endo_scalars, *(Fr*)&endo_scalars.data[2]);
+                schedule_scalar(&endo_scalars.data[0], 2, 2 * i);
+                schedule_scalar(&endo_scalars.data[2], 2, 2 * i + 1);
+            } else {
+                schedule_scalar(&scalar.data[0], 4, i);
+            }
+        }
+    }
+}
+
+/**
+ * Sort each round's schedule into bucket order, and count the entries that land in a bucket.
+ * As in the bn254 code, threads are split over rounds rather than within the radix sort.
+ **/
+template <typename Group> void organize_buckets(pippenger_runtime_state<Group>& state, const size_t num_table_points)
+{
+    const size_t window_bits = get_window_bits(num_table_points);
+    const size_t num_rounds = get_num_rounds<Group>(num_table_points);
+    const uint64_t zero_digit_bucket = 1ULL << (window_bits - 1);
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < num_rounds; ++i) {
+        uint64_t* round_schedule = &state.point_schedule[i * num_table_points];
+        process_buckets(round_schedule, num_table_points, static_cast<uint32_t>(window_bits));
+        const uint64_t* round_end =
+            std::partition_point(round_schedule, round_schedule + num_table_points, [=](const uint64_t entry) {
+                return (entry & 0x7fffffffULL) < zero_digit_bucket;
+            });
+        state.round_counts[i] = static_cast<uint64_t>(round_end - round_schedule);
+    }
+}
+
+/**
+ * Add the pairs (points[0], points[1]), (points[2], points[3]), ... with affine formulae and one batched inversion,
+ * writing the sums to points[num_points / 2], ..., points[num_points - 1].
+ * See the bn254 `scalar_multiplication::add_affine_points` for the derivation.
+ **/
+template <typename Group>
+void add_affine_points(typename Group::affine_element* points,
+                       const size_t num_points,
+                       typename Group::coordinate_field* scratch_space)
+{
+    using Fq = typename Group::coordinate_field;
+    Fq batch_inversion_accumulator = Fq::one();
+
+    for (size_t i = 0; i < num_points; i += 2) {
+        scratch_space[i >> 1] = points[i].x + points[i + 1].x; // x2 + x1
+        points[i + 1].x -= points[i].x;                        // x2 - x1
+        points[i + 1].y -= points[i].y;                        // y2 - y1
+        points[i + 1].y *= batch_inversion_accumulator;        // (y2 - y1)*accumulator_old
+        batch_inversion_accumulator *= (points[i + 1].x);
+    }
+
+    if (batch_inversion_accumulator == 0) {
+        throw_or_abort("attempted to invert zero in add_affine_points");
+    } else {
+        batch_inversion_accumulator = batch_inversion_accumulator.invert();
+    }
+
+    for (size_t i = (num_points)-2; i < num_points; i -= 2) {
+        __builtin_prefetch(points + i - 2);
+        __builtin_prefetch(points + i - 1);
+        __builtin_prefetch(points + ((i + num_points - 2) >> 1));
+        __builtin_prefetch(scratch_space + ((i - 2) >> 1));
+
+        points[i + 1].y *= batch_inversion_accumulator; // update accumulator
+        batch_inversion_accumulator *= points[i + 1].x;
+        points[i + 1].x = points[i + 1].y.sqr();
+        points[(i + num_points) >> 1].x = points[i + 1].x - (scratch_space[i >> 1]); // x3 = lambda_squared - x2
+                                                                                     // - x1
+        points[i].x -= points[(i + num_points) >> 1].x;
+        points[i].x *= points[i + 1].y;
+        points[(i + num_points) >> 1].y = points[i].x - points[i].y;
+    }
+}
+
+/**
+ * As `add_affine_points`, but handles pairs that are equal, negations of each other or contain the point at infinity.
+ * The tangent slope of a doubling is (3x^2 + a) / 2y.
+ **/
+template <typename Group>
+void add_affine_points_with_edge_cases(typename Group::affine_element* points,
+                                       const size_t num_points,
+                                       typename Group::coordinate_field* scratch_space)
+{
+    using Fq = typename Group::coordinate_field;
+    Fq batch_inversion_accumulator = Fq::one();
+
+    for (size_t i = 0; i < num_points; i += 2) {
+        if (points[i].is_point_at_infinity() || points[i + 1].is_point_at_infinity()) {
+            continue;
+        }
+        if (points[i].x == points[i + 1].x) {
+            if (points[i].y == points[i + 1].y) {
+                // double
+                scratch_space[i >> 1] = points[i].x + points[i].x; // 2x
+                Fq x_squared = points[i].x.sqr();
+                points[i + 1].x = points[i].y + points[i].y;         // 2y
+                points[i + 1].y = x_squared + x_squared + x_squared; // 3x^2
+                if constexpr (Group::has_a) {
+                    points[i + 1].y += Group::curve_a; // 3x^2 + a
+                }
+                points[i + 1].y *= batch_inversion_accumulator;
+                batch_inversion_accumulator *= (points[i + 1].x);
+                continue;
+            }
+            points[i].self_set_infinity();
+            points[i + 1].self_set_infinity();
+            continue;
+        }
+
+        scratch_space[i >> 1] = points[i].x + points[i + 1].x; // x2 + x1
+        points[i + 1].x -= points[i].x;                        // x2 - x1
+        points[i + 1].y -= points[i].y;                        // y2 - y1
+        points[i + 1].y *= batch_inversion_accumulator;        // (y2 - y1)*accumulator_old
+        batch_inversion_accumulator *= (points[i + 1].x);
+    }
+    if (!batch_inversion_accumulator.is_zero()) {
+        batch_inversion_accumulator = batch_inversion_accumulator.invert();
+    }
+    for (size_t i = (num_points)-2; i < num_points; i -= 2) {
+        __builtin_prefetch(points + i - 2);
+        __builtin_prefetch(points + i - 1);
+        __builtin_prefetch(points + ((i + num_points - 2) >> 1));
+        __builtin_prefetch(scratch_space + ((i - 2) >> 1));
+
+        if (points[i].is_point_at_infinity()) {
+            points[(i + num_points) >> 1] = points[i + 1];
+            continue;
+        }
+        if (points[i + 1].is_point_at_infinity()) {
+            points[(i + num_points) >> 1] = points[i];
+            continue;
+        }
+
+        points[i + 1].y *= batch_inversion_accumulator; // update accumulator
+        batch_inversion_accumulator *= points[i + 1].x;
+        points[i + 1].x = points[i + 1].y.sqr();
+        points[(i + num_points) >> 1].x = points[i + 1].x - (scratch_space[i >> 1]); // x3 = lambda_squared - x2
+                                                                                     // - x1
+        points[i].x -= points[(i + num_points) >> 1].x;
+        points[i].x *= points[i + 1].y;
+        points[(i + num_points) >> 1].y = points[i].x - points[i].y;
+    }
+}
+
+/**
+ * Copy each bucket's points into `point_pairs_1`, grouped by the binary decomposition of the bucket's size, so that
+ * `evaluate_addition_chains` can add them as independent pairs, pairs of pairs etc.
+ * See the bn254 `scalar_multiplication::construct_addition_chains`. Returns log2 of the largest bucket size.
+ **/
+template <typename Group>
+uint32_t construct_addition_chains(affine_product_runtime_state<Group>& state, bool empty_bucket_counts)
+{
+    // if this is the first call to `construct_addition_chains`, we need to count up our buckets
+    if (empty_bucket_counts) {
+        std::fill(state.bucket_counts, state.bucket_counts + state.num_buckets, 0U);
+        const uint32_t first_bucket = static_cast<uint32_t>(state.point_schedule[0] & 0x7fffffffULL);
+        for (size_t i = 0; i < state.num_points; ++i) {
+            const uint32_t bucket_index = static_cast<uint32_t>(state.point_schedule[i] & 0x7fffffffULL);
+            ++state.bucket_counts[bucket_index - first_bucket];
+        }
+    }
+
+    uint32_t max_count = 0;
+    for (size_t i = 0; i < state.num_buckets; ++i) {
+        max_count = std::max(state.bucket_counts[i], max_count);
+    }
+    const uint32_t max_bucket_bits = numeric::get_msb(max_count);
+
+    // bit_offsets[j] = where the points of the 2^j sized chunks of every bucket start
+    for (size_t i = 0; i < max_bucket_bits + 1; ++i) {
+        state.bit_offsets[i] = 0;
+    }
+    for (size_t i = 0; i < state.num_buckets; ++i) {
+        const uint32_t count = state.bucket_counts[i];
+        for (uint32_t j = 0; j < max_bucket_bits; ++j) {
+            state.bit_offsets[j + 1] += (count & (1U << j));
+        }
+    }
+    for (size_t i = 2; i < max_bucket_bits + 1; ++i) {
+        state.bit_offsets[i] += state.bit_offsets[i - 1];
+    }
+
+    // we need to update `bit_offsets` to compute our point shuffle,
+    // but we need the original array later on, so make a copy.
+    std::array<uint32_t, 33> bit_offsets_copy = state.bit_offsets;
+
+    size_t schedule_it = 0;
+    for (size_t i = 0; i < state.num_buckets; ++i) {
+        const uint32_t count = state.bucket_counts[i];
+        const uint32_t num_bits = numeric::get_msb(count) + 1;
+        for (size_t j = 0; j < num_bits; ++j) {
+            uint32_t& current_offset = bit_offsets_copy[j];
+            const size_t k_end = count & (1UL << j);
+            for (size_t k = 0; k < k_end; ++k) {
+                // points are read in a uniformly random order, so fetch them a few iterations early
+                __builtin_prefetch(state.points + (state.point_schedule[schedule_it + 8] >> 32ULL));
+                const uint64_t schedule = state.point_schedule[schedule_it];
+                typename Group::affine_element& point = state.point_pairs_1[current_offset];
+                point = state.points[schedule >> 32ULL];
+                point.y.self_conditional_negate((schedule >> 31ULL) & 1ULL);
+                ++current_offset;
+                ++schedule_it;
+            }
+        }
+    }
+    return max_bucket_bits;
+}
+
+template <typename Group>
+void evaluate_addition_chains(affine_product_runtime_state<Group>& state,
+                              const size_t max_bucket_bits,
+                              bool handle_edge_cases)
+{
+    size_t end = state.num_points;
+    size_t start = 0;
+    for (size_t i = 0; i < max_bucket_bits; ++i) {
+        const size_t points_in_round = (state.num_points - state.bit_offsets[i + 1]) >> (i);
+        start = end - points_in_round;
+        if (handle_edge_cases) {
+            add_affine_points_with_edge_cases<Group>(state.point_pairs_1 + start, points_in_round, state.scratch_space);
+        } else {
+            add_affine_points<Group>(state.point_pairs_1 + start, points_in_round, state.scratch_space);
+        }
+    }
+}
+
+/**
+ * Reduce every bucket of `state` to a single point, returning them in bucket order (empty buckets are skipped).
+ * Each pass of pairwise additions shrinks a bucket of n points to popcount(n) points, and we repeat until every bucket
+ * holds at most one point. See the bn254 `scalar_multiplication::reduce_buckets`.
+ **/
+template <typename Group>
+typename Group::affine_element* reduce_buckets(affine_product_runtime_state<Group>& state, bool handle_edge_cases)
+{
+    bool first_round = true;
+    while (true) {
+        const uint32_t max_bucket_bits = construct_addition_chains(state, first_round);
+        if (max_bucket_bits == 0) {
+            return state.point_pairs_1;
+        }
+        first_round = false;
+
+        evaluate_addition_chains(state, max_bucket_bits, handle_edge_cases);
+
+        // the sums of each round of `evaluate_addition_chains` sit in the upper half of that round's input range
+        const uint32_t end = state.num_points;
+        for (size_t i = 0; i < max_bucket_bits; ++i) {
+            const uint32_t points_in_round = (state.num_points - state.bit_offsets[i + 1]) >> static_cast<uint32_t>(i);
+            const uint32_t start = end - points_in_round;
+            state.bit_offsets[i + 1] = start + points_in_round / 2;
+        }
+
+        // schedule the remaining points of every bucket, which are now addressed by their position in point_pairs_1
+        uint32_t new_num_points = 0;
+        for (size_t i = 0; i < state.num_buckets; ++i) {
+            uint32_t& count = state.bucket_counts[i];
+            const uint32_t num_bits = numeric::get_msb(count) + 1;
+            uint32_t new_bucket_count = 0;
+            for (size_t j = 0; j < num_bits; ++j) {
+                uint32_t& current_offset = state.bit_offsets[j];
+                if (((count >> j) & 1) == 1) {
+                    state.point_schedule[new_num_points++] = (static_cast<uint64_t>(current_offset) << 32ULL) + i;
+                    ++new_bucket_count;
+                    ++current_offset;
+                }
+            }
+            count = new_bucket_count;
+        }
+
+        typename Group::affine_element* temp = state.point_pairs_1;
+        state.num_points = new_num_points;
+        state.points = state.point_pairs_1;
+        state.point_pairs_1 = state.point_pairs_2;
+        state.point_pairs_2 = temp;
+    }
+}
+
+/**
+ * Compute scalar * point for a small scalar, by double-and-add.
+ **/
+template <typename Group>
+typename Group::element mul_by_small_scalar(const typename Group::element& point, const uint64_t scalar)
+{
+    typename Group::element result = Group::point_at_infinity;
+    for (size_t i = numeric::get_msb(scalar) + 1; i > 0; --i) {
+        result.self_dbl();
+        if (((scalar >> (i - 1)) & 1ULL) == 1ULL) {
+            result += point;
+        }
+    }
+    return result;
+}
+
+/**
+ * Evaluate every round's buckets and combine them, most significant round first.
+ *
+ * Within a round, each thread takes an equal share of the sorted schedule entries, reduces the buckets they cover
+ * and sums them with weights (bucket index + 1). A bucket that straddles two threads is reduced by both, which is
+ * harmless as the weighted sum is linear. Each thread folds its rounds into its own accumulator, doubling it by the
+ * window size between rounds, and the thread accumulators are summed at the end.
+ **/
+template <typename Group>
+typename Group::element evaluate_pippenger_rounds(pippenger_runtime_state<Group>& state,
+                                                  const typename Group::affine_element* points,
+                                                  const size_t num_table_points,
+                                                  bool handle_edge_cases)
+{
+    using element = typename Group::element;
+    using affine_element = typename Group::affine_element;
+
+    const size_t window_bits = get_window_bits(num_table_points);
+    const size_t num_rounds = get_num_rounds<Group>(num_table_points);
+    const size_t num_buckets = 1UL << (window_bits - 1);
+    const size_t num_threads = get_num_msm_threads();
+
+    std::vector<element> thread_accumulators(num_threads);
+
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < num_threads; ++j) {
+        element& thread_accumulator = thread_accumulators[j];
+        thread_accumulator.self_set_infinity();
+
+        for (size_t i = num_rounds - 1; i < num_rounds; --i) {
+            if (i != num_rounds - 1) {
+                for (size_t k = 0; k < window_bits; ++k) {
+                    thread_accumulator.self_dbl();
+                }
+            }
+
+            const size_t num_round_points = static_cast<size_t>(state.round_counts[i]);
+            const size_t start = (j * num_round_points) / num_threads;
+            const size_t end = ((j + 1) * num_round_points) / num_threads;
+            if (start == end) {
+                continue;
+            }
+
+            affine_product_runtime_state<Group> product_state =
+                state.get_affine_product_runtime_state(num_threads, j, num_table_points, num_buckets);
+            uint64_t* thread_point_schedule = &state.point_schedule[i * num_table_points + start];
+            const uint64_t first_bucket = thread_point_schedule[0] & 0x7fffffffULL;
+            const uint64_t last_bucket = thread_point_schedule[end - start - 1] & 0x7fffffffULL;
+            product_state.points = points;
+            product_state.point_schedule = thread_point_schedule;
+            product_state.num_points = static_cast<uint32_t>(end - start);
+            product_state.num_buckets = static_cast<uint32_t>(last_bucket - first_bucket + 1);
+
+            const affine_element* output_buckets = reduce_buckets(product_state, handle_edge_cases);
+
+            // running_sum accumulates buckets from the top, so bucket k is added (k - first_bucket + 1) times
+            element running_sum = Group::point_at_infinity;
+            element accumulator = Group::point_at_infinity;
+            size_t output_it = product_state.num_points - 1;
+            for (size_t k = product_state.num_buckets - 1; k < product_state.num_buckets; --k) {
+                if (product_state.bucket_counts[k] != 0) {
+                    // with edge cases, a bucket's points can cancel out
+                    if (!output_buckets[output_it].is_point_at_infinity()) {
+                        running_sum += output_buckets[output_it];
+                    }
+                    --output_it;
+                }
+                accumulator += running_sum;
+            }
+            if (first_bucket > 0) {
+                accumulator += mul_by_small_scalar<Group>(running_sum, first_bucket);
+            }
+            thread_accumulator += accumulator;
+        }
+    }
+
+    element result = Group::point_at_infinity;
+    for (size_t j = 0; j < num_threads; ++j) {
+        result += thread_accumulators[j];
+    }
+    return result;
+}
+
+/**
+ * Compute \sum_i scalars[i] * points[i].
+ *
+ * With `handle_edge_cases` unset, bucket additions use incomplete affine formulae, which is only sound when the points
+ * are linearly independent (e.g. an SRS or a set of generators); see the bn254 `pippenger_unsafe`.
+ **/
+template <typename Group>
+typename Group::element pippenger(const typename Group::subgroup_field* scalars,
+                                  const typename Group::affine_element* points,
+                                  const size_t num_initial_points,
+                                  pippenger_runtime_state<Group>& state,
+                                  bool handle_edge_cases)
+{
+    using element = typename Group::element;
+
+    if (num_initial_points == 0) {
+        return Group::point_at_infinity;
+    }
+
+    // below this, bucket bookkeeping and per-thread round overheads outweigh the savings over plain multiplication
+    const size_t threshold = std::max(get_num_msm_threads() * 8, 8UL);
+    if (num_initial_points <= threshold) {
+        std::vector<element> exponentiation_results(num_initial_points);
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+        for (size_t i = 0; i < num_initial_points; ++i) {
+            // the endomorphism multiplication does not handle a base point at infinity
+            exponentiation_results[i] =
+                points[i].is_point_at_infinity() ? Group::point_at_infinity : element(points[i]) * scalars[i];
+        }
+        for (size_t i = num_initial_points - 1; i > 0; --i) {
+            exponentiation_results[i - 1] += exponentiation_results[i];
+        }
+        return exponentiation_results[0];
+    }
+
+    const size_t num_table_points = get_num_table_points<Group>(num_initial_points);
+    if (num_table_points > 0xffffffffULL) {
+        throw_or_abort("pippenger: point indices must fit in 32 bits");
+    }
+
+    state.allocate(num_initial_points);
+    compute_point_schedule(state, scalars, points, num_initial_points);
+    organize_buckets(state, num_table_points);
+
+    const typename Group::affine_element* table = Group::USE_ENDOMORPHISM ? &state.point_table[0] : points;
+    return evaluate_pippenger_rounds(state, table, num_table_points, handle_edge_cases);
+}
+
+template <typename Group>
+typename Group::element pippenger_unsafe(const typename Group::subgroup_field* scalars,
+                                         const typename Group::affine_element* points,
+                                         const size_t num_initial_points,
+                                         pippenger_runtime_state<Group>& state)
+{
+    return pippenger(scalars, points, num_initial_points, state, false);
+}
+
+template <typename Group>
+typename Group::element pippenger(const std::vector<typename Group::subgroup_field>& scalars,
+                                  const std::vector<typename Group::affine_element>& points,
+                                  bool handle_edge_cases)
+{
+    ASSERT(scalars.size() == points.size());
+    if (points.empty()) {
+        return Group::point_at_infinity;
+    }
+    pippenger_runtime_state<Group> state(points.size());
+    return pippenger<Group>(&scalars[0], &points[0], points.size(), state, handle_edge_cases);
+}
+
+} // namespace generic
+} // namespace scalar_multiplication
+} // namespace barretenberg
@@ -111,7 +111,7 @@ void QueueWrapper::process_queue() {
             }
         }
     }
-    work_item_queue = std::vector<work_item>();
+    flush_queue();
 }   
 
 /**
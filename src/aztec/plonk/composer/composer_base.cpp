@@ -1,7 +1,10 @@
 #include "composer_base.hpp"
+#include <common/max_threads.hpp>
+#include <common/timer.hpp>
 #include <plonk/proof_system/proving_key/proving_key.hpp>
 #include <plonk/proof_system/utils/permutation.hpp>
 #include <plonk/proof_system/verification_key/verification_key.hpp>
+#include <polynomials/polynomial_arithmetic.hpp>
 
 namespace waffle {
 
@@ -44,6 +47,37 @@ void ComposerBase::assert_equal(const uint32_t a_variable_idx, const uint32_t b_
         variable_tags[a_real_idx] = variable_tags[b_real_idx];
 }
 
+namespace {
+/**
+ * Transform each of `polynomials` from the Lagrange base to monomial form in place, and return their coset FFTs over
+ * the large domain (allocated with room for `fft_max_size` coefficients). The transforms are batched across the
+ * polynomials (see `polynomial_arithmetic::ifft_batch`).
+ */
+std::vector<polynomial> compute_monomials_and_coset_ffts(std::vector<polynomial>& polynomials,
+                                                         const proving_key& key,
+                                                         const size_t fft_max_size)
+{
+    std::vector<fr*> coefficients;
+    for (auto& poly : polynomials) {
+        coefficients.push_back(poly.get_coefficients());
+    }
+    barretenberg::polynomial_arithmetic::ifft_batch(coefficients, key.small_domain);
+
+    std::vector<polynomial> ffts;
+    ffts.reserve(polynomials.size());
+    coefficients.clear();
+    for (auto& poly : polynomials) {
+        ffts.emplace_back(poly, fft_max_size);
+        coefficients.push_back(ffts.back().get_coefficients());
+    }
+    barretenberg::polynomial_arithmetic::coset_fft_batch(coefficients, key.large_domain);
+    for (auto& fft : ffts) {
+        fft.resize_unsafe(key.large_domain.size);
+    }
+    return ffts;
+}
+} // namespace
+
 /**
  * Compute wire copy cycles
  *
@@ -51,6 +85,11 @@ void ComposerBase::assert_equal(const uint32_t a_variable_idx, const uint32_t b_
  * Then go through all witnesses in w_l, w_r, w_o and w_4 (if program width is > 3) and
  * add them to cycles of their real indexes.
  *
+ * The variables are split into contiguous shards, one per thread. The wires are bucketed by the shard of their real
+ * variable with a counting sort, which keeps each bucket in wire order, and each thread only visits the wires in its
+ * own bucket. A cycle is only appended to by one thread, in gate order, so the cycles are the same as a serial pass
+ * builds.
+ *
  * @tparam program_width Program width
  * */
 template <size_t program_width> void ComposerBase::compute_wire_copy_cycles()
@@ -68,23 +107,53 @@ template <size_t program_width> void ComposerBase::compute_wire_copy_cycles()
         cycle.emplace_back(left);
         cycle.emplace_back(right);
     }
-    // Go through all witnesses and add them to the wire_copy_cycles
+
+    // Look up the real variable of every wire once
+    const size_t num_wires = n * program_width;
+    std::vector<uint32_t> real_indices(num_wires);
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
     for (size_t i = 0; i < n; ++i) {
-        const auto w_1_index = real_variable_index[w_l[i]];
-        const auto w_2_index = real_variable_index[w_r[i]];
-        const auto w_3_index = real_variable_index[w_o[i]];
+        real_indices[i * program_width] = real_variable_index[w_l[i]];
+        real_indices[i * program_width + 1] = real_variable_index[w_r[i]];
+        real_indices[i * program_width + 2] = real_variable_index[w_o[i]];
+        if constexpr (program_width > 3) {
+            real_indices[i * program_width + 3] = real_variable_index[w_4[i]];
+        }
+    }
 
-        cycle_node left{ static_cast<uint32_t>(i + num_public_inputs), WireType::LEFT };
-        cycle_node right{ static_cast<uint32_t>(i + num_public_inputs), WireType::RIGHT };
-        cycle_node out{ static_cast<uint32_t>(i + num_public_inputs), WireType::OUTPUT };
-        wire_copy_cycles[static_cast<size_t>(w_1_index)].emplace_back(left);
-        wire_copy_cycles[static_cast<size_t>(w_2_index)].emplace_back(right);
-        wire_copy_cycles[static_cast<size_t>(w_3_index)].emplace_back(out);
+    // Each shard of the real variables is owned by one thread. Bucket the wires by shard with a counting sort, which
+    // keeps each bucket in wire order, so a thread only visits the wires of its own shard and builds its cycles in the
+    // same order as a serial pass would.
+    const size_t num_variables = wire_copy_cycles.size();
+    const size_t num_shards = max_threads::compute_num_threads();
+    const size_t shard_size = std::max((num_variables + num_shards - 1) / num_shards, size_t(1));
+    std::vector<size_t> shard_offsets(num_shards + 1, 0);
+    for (size_t k = 0; k < num_wires; ++k) {
+        ++shard_offsets[real_indices[k] / shard_size + 1];
+    }
+    for (size_t shard = 0; shard < num_shards; ++shard) {
+        shard_offsets[shard + 1] += shard_offsets[shard];
+    }
+    std::vector<uint32_t> shard_wires(num_wires);
+    std::vector<size_t> shard_ends(shard_offsets.begin(), shard_offsets.end() - 1);
+    for (size_t k = 0; k < num_wires; ++k) {
+        shard_wires[shard_ends[real_indices[k] / shard_size]++] = static_cast<uint32_t>(k);
+    }
 
-        if constexpr (program_width > 3) {
-            const auto w_4_index = real_variable_index[w_4[i]];
-            cycle_node fourth{ static_cast<uint32_t>(i + num_public_inputs), WireType::FOURTH };
-            wire_copy_cycles[static_cast<size_t>(w_4_index)].emplace_back(fourth);
+    // Go through all witnesses and add them to the wire_copy_cycles
+    constexpr WireType wire_types[4] = { WireType::LEFT, WireType::RIGHT, WireType::OUTPUT, WireType::FOURTH };
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t shard = 0; shard < num_shards; ++shard) {
+        for (size_t k = shard_offsets[shard]; k < shard_offsets[shard + 1]; ++k) {
+            const size_t wire = shard_wires[k];
+            const size_t i = wire / program_width;
+            const size_t j = wire % program_width;
+            wire_copy_cycles[real_indices[wire]].emplace_back(
+                cycle_node{ static_cast<uint32_t>(i + num_public_inputs), wire_types[j] });
         }
     }
 }
@@ -100,27 +169,37 @@ template <size_t program_width> void ComposerBase::compute_wire_copy_cycles()
 template <size_t program_width, bool with_tags> void ComposerBase::compute_sigma_permutations(proving_key* key)
 {
     // Compute wire copy cycles for public and private variables
+    Timer timer;
     compute_wire_copy_cycles<program_width>();
+    key_timings.copy_cycles = timer.seconds();
+    timer.start();
+
     std::array<std::vector<permutation_subgroup_element>, program_width> sigma_mappings;
     std::array<std::vector<permutation_subgroup_element>, program_width> id_mappings;
     // std::array<uint32_t, 4> wire_offsets{ 0U, 0x40000000, 0x80000000, 0xc0000000 };
     const uint32_t num_public_inputs = static_cast<uint32_t>(public_inputs.size());
-    // Prepare the sigma and id mappings by reserving enough space
-    // and saving perumation subgroup elements that point to themselves
+    // Prepare the sigma and id mappings with permutation subgroup elements that point to themselves
     for (size_t i = 0; i < program_width; ++i) {
-        sigma_mappings[i].reserve(key->n);
+        sigma_mappings[i].resize(key->n);
         if (with_tags)
-            id_mappings[i].reserve(key->n);
+            id_mappings[i].resize(key->n);
     }
-    for (size_t i = 0; i < program_width; ++i) {
-        for (size_t j = 0; j < key->n; ++j) {
-            sigma_mappings[i].emplace_back(permutation_subgroup_element{ (uint32_t)j, (uint8_t)i, false, false });
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < key->n; ++j) {
+        for (size_t i = 0; i < program_width; ++i) {
+            sigma_mappings[i][j] = permutation_subgroup_element{ (uint32_t)j, (uint8_t)i, false, false };
             if (with_tags)
-                id_mappings[i].emplace_back(permutation_subgroup_element{ (uint32_t)j, (uint8_t)i, false, false });
+                id_mappings[i][j] = permutation_subgroup_element{ (uint32_t)j, (uint8_t)i, false, false };
         }
     }
     // Go through all wire cycles and update sigma and id mappings to point to the next element
-    // within each cycle as well as set the appropriate tags
+    // within each cycle as well as set the appropriate tags. Each node is in exactly one cycle, so
+    // the cycles can be processed in parallel.
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
     for (size_t i = 0; i < wire_copy_cycles.size(); ++i) {
         for (size_t j = 0; j < wire_copy_cycles[i].size(); ++j) {
             cycle_node current_cycle_node = wire_copy_cycles[i][j];
@@ -160,35 +239,33 @@ template <size_t program_width, bool with_tags> void ComposerBase::compute_sigma
             std::cerr << "MAPPING IS BOTH A TAG AND A PUBLIC INPUT" << std::endl;
         }
     }
+    // Compute each permutation polynomial in the Lagrange base straight into the polynomial that goes into the key,
+    // and its monomial form and coset FFT from copies of it
+    std::vector<std::string> labels;
+    std::vector<const std::vector<permutation_subgroup_element>*> mappings;
     for (size_t i = 0; i < program_width; ++i) {
         std::string index = std::to_string(i + 1);
-        barretenberg::polynomial sigma_polynomial(key->n);
-        // Construct sigma permutation polynomial
-        compute_permutation_lagrange_base_single<standard_settings>(
-            sigma_polynomial, sigma_mappings[i], key->small_domain);
-
-        barretenberg::polynomial sigma_polynomial_lagrange_base(sigma_polynomial);
-        key->permutation_selectors_lagrange_base.insert(
-            { "sigma_" + index, std::move(sigma_polynomial_lagrange_base) });
-        sigma_polynomial.ifft(key->small_domain);
-        barretenberg::polynomial sigma_fft(sigma_polynomial, key->large_domain.size);
-        sigma_fft.coset_fft(key->large_domain);
-        key->permutation_selectors.insert({ "sigma_" + index, std::move(sigma_polynomial) });
-        key->permutation_selector_ffts.insert({ "sigma_" + index + "_fft", std::move(sigma_fft) });
+        labels.push_back("sigma_" + index);
+        mappings.push_back(&sigma_mappings[i]);
         if (with_tags) {
-            barretenberg::polynomial id_polynomial(key->n);
-            compute_permutation_lagrange_base_single<standard_settings>(
-                id_polynomial, id_mappings[i], key->small_domain);
-
-            barretenberg::polynomial id_polynomial_lagrange_base(id_polynomial);
-            key->permutation_selectors_lagrange_base.insert({ "id_" + index, std::move(id_polynomial_lagrange_base) });
-            id_polynomial.ifft(key->small_domain);
-            barretenberg::polynomial id_fft(id_polynomial, key->large_domain.size);
-            id_fft.coset_fft(key->large_domain);
-            key->permutation_selectors.insert({ "id_" + index, std::move(id_polynomial) });
-            key->permutation_selector_ffts.insert({ "id_" + index + "_fft", std::move(id_fft) });
+            labels.push_back("id_" + index);
+            mappings.push_back(&id_mappings[i]);
         }
     }
+    std::vector<polynomial> monomials;
+    monomials.reserve(labels.size());
+    for (size_t i = 0; i < labels.size(); ++i) {
+        auto& lagrange_base =
+            key->permutation_selectors_lagrange_base.insert({ labels[i], polynomial(key->n) }).first->second;
+        compute_permutation_lagrange_base_single<standard_settings>(lagrange_base, *mappings[i], key->small_domain);
+        monomials.emplace_back(lagrange_base);
+    }
+    auto ffts = compute_monomials_and_coset_ffts(monomials, *key, key->large_domain.size);
+    for (size_t i = 0; i < labels.size(); ++i) {
+        key->permutation_selectors.insert({ labels[i], std::move(monomials[i]) });
+        key->permutation_selector_ffts.insert({ labels[i] + "_fft", std::move(ffts[i]) });
+    }
+    key_timings.sigma_permutations = timer.seconds();
 }
 
 /**
@@ -223,10 +300,19 @@ std::shared_ptr<proving_key> ComposerBase::compute_proving_key_base(const size_t
     // Initialize circuit_proving_key
     circuit_proving_key = std::make_shared<proving_key>(subgroup_size, public_inputs.size(), crs);
 
+    Timer timer;
+    std::vector<polynomial> selector_polynomials;
+    selector_polynomials.reserve(selector_num);
+    for (size_t i = 0; i < selector_num; ++i) {
+        selector_polynomials.emplace_back(subgroup_size);
+    }
+
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
     for (size_t i = 0; i < selector_num; ++i) {
 
         std::vector<barretenberg::fr>& coeffs = selectors[i];
-        const auto& properties = selector_properties[i];
         ASSERT(n == coeffs.size());
 
         // Fill unfilled gates coefficients with zeroes
@@ -243,7 +329,7 @@ std::shared_ptr<proving_key> ComposerBase::compute_proving_key_base(const size_t
         // system; observe that we cut out 4 roots and only use 3 for zero knowledge. The last root, corresponds to this
         // position.
         coeffs.emplace_back(1);
-        polynomial poly(subgroup_size);
+        polynomial& poly = selector_polynomials[i];
 
         for (size_t k = 0; k < public_inputs.size(); ++k) {
             poly[k] = fr::zero();
@@ -251,19 +337,27 @@ std::shared_ptr<proving_key> ComposerBase::compute_proving_key_base(const size_t
         for (size_t k = public_inputs.size(); k < subgroup_size; ++k) {
             poly[k] = coeffs[k - public_inputs.size()];
         }
+    }
 
+    for (size_t i = 0; i < selector_num; ++i) {
+        const auto& properties = selector_properties[i];
         if (properties.requires_lagrange_base_polynomial) {
-            polynomial lagrange_base_poly(poly, subgroup_size);
+            polynomial lagrange_base_poly(selector_polynomials[i], subgroup_size);
             circuit_proving_key->constraint_selectors_lagrange_base.insert(
                 { properties.name, std::move(lagrange_base_poly) });
         }
-        poly.ifft(circuit_proving_key->small_domain);
-        polynomial poly_fft(poly, subgroup_size * 4 + 4);
-        poly_fft.coset_fft(circuit_proving_key->large_domain);
+    }
 
-        circuit_proving_key->constraint_selectors.insert({ properties.name, std::move(poly) });
-        circuit_proving_key->constraint_selector_ffts.insert({ properties.name + "_fft", std::move(poly_fft) });
+    // Transform the selectors to monomial form and to the coset of the large domain, all at once
+    auto selector_ffts =
+        compute_monomials_and_coset_ffts(selector_polynomials, *circuit_proving_key, subgroup_size * 4 + 4);
+    for (size_t i = 0; i < selector_num; ++i) {
+        const auto& properties = selector_properties[i];
+        circuit_proving_key->constraint_selectors.insert({ properties.name, std::move(selector_polynomials[i]) });
+        circuit_proving_key->constraint_selector_ffts.insert(
+            { properties.name + "_fft", std::move(selector_ffts[i]) });
     }
+    key_timings.selectors = timer.seconds();
     return circuit_proving_key;
 }
 
@@ -406,6 +406,14 @@ class ComposerBase {
     std::shared_ptr<proving_key> circuit_proving_key;
     std::shared_ptr<verification_key> circuit_verification_key;
 
+    // Seconds spent in each stage of `compute_proving_key`, for reporting
+    struct proving_key_timings {
+        double selectors = 0;
+        double copy_cycles = 0;
+        double sigma_permutations = 0;
+    };
+    proving_key_timings key_timings;
+
     bool computed_witness = false;
     std::shared_ptr<program_witness> witness;
 
@@ -7,6 +7,7 @@
 #include <plonk/proof_system/widgets/transition_widgets/turbo_logic_widget.hpp>
 #include <plonk/proof_system/widgets/transition_widgets/genperm_sort_widget.hpp>
 #include <plonk/proof_system/widgets/transition_widgets/elliptic_widget.hpp>
+#include <plonk/proof_system/widgets/transition_widgets/fused_transition_widget.hpp>
 #include <plonk/proof_system/widgets/random_widgets/permutation_widget.hpp>
 #include <plonk/proof_system/widgets/random_widgets/plookup_widget.hpp>
 #include <plonk/proof_system/types/polynomial_manifest.hpp>
@@ -916,6 +917,7 @@ std::shared_ptr<proving_key> PlookupComposer::compute_proving_key()
     std::copy(plookup_polynomial_manifest,
               plookup_polynomial_manifest + 34,
               std::back_inserter(circuit_proving_key->polynomial_manifest));
+    circuit_proving_key->init_polynomial_store();
 
     return circuit_proving_key;
 }
@@ -1058,6 +1060,16 @@ std::shared_ptr<program_witness> PlookupComposer::compute_witness()
     return witness;
 }
 
+// The transition widgets' quotient contributions are computed in a single pass over the large domain
+template <typename Settings>
+using ProverPlookupTransitionWidgets = widget::FusedTransitionWidget<barretenberg::fr,
+                                                                     Settings,
+                                                                     widget::TurboArithmeticKernel,
+                                                                     widget::TurboFixedBaseKernel,
+                                                                     widget::GenPermSortKernel,
+                                                                     widget::TurboLogicKernel,
+                                                                     widget::EllipticKernel>;
+
 PlookupProver PlookupComposer::create_prover()
 {
     compute_proving_key();
@@ -1069,25 +1081,13 @@ PlookupProver PlookupComposer::create_prover()
     std::unique_ptr<ProverPlookupWidget<>> plookup_widget =
         std::make_unique<ProverPlookupWidget<>>(circuit_proving_key.get(), witness.get());
 
-    std::unique_ptr<ProverTurboArithmeticWidget<plookup_settings>> arithmetic_widget =
-        std::make_unique<ProverTurboArithmeticWidget<plookup_settings>>(circuit_proving_key.get(), witness.get());
-    std::unique_ptr<ProverTurboFixedBaseWidget<plookup_settings>> fixed_base_widget =
-        std::make_unique<ProverTurboFixedBaseWidget<plookup_settings>>(circuit_proving_key.get(), witness.get());
-    std::unique_ptr<ProverGenPermSortWidget<plookup_settings>> sort_widget =
-        std::make_unique<ProverGenPermSortWidget<plookup_settings>>(circuit_proving_key.get(), witness.get());
-    std::unique_ptr<ProverTurboLogicWidget<plookup_settings>> logic_widget =
-        std::make_unique<ProverTurboLogicWidget<plookup_settings>>(circuit_proving_key.get(), witness.get());
-    std::unique_ptr<ProverEllipticWidget<plookup_settings>> elliptic_widget =
-        std::make_unique<ProverEllipticWidget<plookup_settings>>(circuit_proving_key.get(), witness.get());
+    std::unique_ptr<ProverPlookupTransitionWidgets<plookup_settings>> transition_widgets =
+        std::make_unique<ProverPlookupTransitionWidgets<plookup_settings>>(circuit_proving_key.get(), witness.get());
 
     output_state.random_widgets.emplace_back(std::move(permutation_widget));
     output_state.random_widgets.emplace_back(std::move(plookup_widget));
 
-    output_state.transition_widgets.emplace_back(std::move(arithmetic_widget));
-    output_state.transition_widgets.emplace_back(std::move(fixed_base_widget));
-    output_state.transition_widgets.emplace_back(std::move(sort_widget));
-    output_state.transition_widgets.emplace_back(std::move(logic_widget));
-    output_state.transition_widgets.emplace_back(std::move(elliptic_widget));
+    output_state.transition_widgets.emplace_back(std::move(transition_widgets));
 
     std::unique_ptr<KateCommitmentScheme<plookup_settings>> kate_commitment_scheme =
         std::make_unique<KateCommitmentScheme<plookup_settings>>();
@@ -1109,27 +1109,14 @@ UnrolledPlookupProver PlookupComposer::create_unrolled_prover()
     std::unique_ptr<ProverPlookupWidget<>> plookup_widget =
         std::make_unique<ProverPlookupWidget<>>(circuit_proving_key.get(), witness.get());
 
-    std::unique_ptr<ProverTurboArithmeticWidget<unrolled_plookup_settings>> arithmetic_widget =
-        std::make_unique<ProverTurboArithmeticWidget<unrolled_plookup_settings>>(circuit_proving_key.get(),
-                                                                                 witness.get());
-    std::unique_ptr<ProverTurboFixedBaseWidget<unrolled_plookup_settings>> fixed_base_widget =
-        std::make_unique<ProverTurboFixedBaseWidget<unrolled_plookup_settings>>(circuit_proving_key.get(),
-                                                                                witness.get());
-    std::unique_ptr<ProverGenPermSortWidget<unrolled_plookup_settings>> sort_widget =
-        std::make_unique<ProverGenPermSortWidget<unrolled_plookup_settings>>(circuit_proving_key.get(), witness.get());
-    std::unique_ptr<ProverTurboLogicWidget<unrolled_plookup_settings>> logic_widget =
-        std::make_unique<ProverTurboLogicWidget<unrolled_plookup_settings>>(circuit_proving_key.get(), witness.get());
-    std::unique_ptr<ProverEllipticWidget<unrolled_plookup_settings>> elliptic_widget =
-        std::make_unique<ProverEllipticWidget<unrolled_plookup_settings>>(circuit_proving_key.get(), witness.get());
+    std::unique_ptr<ProverPlookupTransitionWidgets<unrolled_plookup_settings>> transition_widgets =
+        std::make_unique<ProverPlookupTransitionWidgets<unrolled_plookup_settings>>(circuit_proving_key.get(),
+                                                                                    witness.get());
 
     output_state.random_widgets.emplace_back(std::move(permutation_widget));
     output_state.random_widgets.emplace_back(std::move(plookup_widget));
 
-    output_state.transition_widgets.emplace_back(std::move(arithmetic_widget));
-    output_state.transition_widgets.emplace_back(std::move(fixed_base_widget));
-    output_state.transition_widgets.emplace_back(std::move(sort_widget));
-    output_state.transition_widgets.emplace_back(std::move(logic_widget));
-    output_state.transition_widgets.emplace_back(std::move(elliptic_widget));
+    output_state.transition_widgets.emplace_back(std::move(transition_widgets));
 
     std::unique_ptr<KateCommitmentScheme<unrolled_plookup_settings>> kate_commitment_scheme =
         std::make_unique<KateCommitmentScheme<unrolled_plookup_settings>>();
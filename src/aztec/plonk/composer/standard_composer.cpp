@@ -745,6 +745,7 @@ std::shared_ptr<proving_key> StandardComposer::compute_proving_key()
     std::copy(standard_polynomial_manifest,
               standard_polynomial_manifest + 12,
               std::back_inserter(circuit_proving_key->polynomial_manifest));
+    circuit_proving_key->init_polynomial_store();
 
     circuit_proving_key->recursive_proof_public_input_indices =
         std::vector<uint32_t>(recursive_proof_public_input_indices.begin(), recursive_proof_public_input_indices.end());
@@ -3,6 +3,7 @@
 #include <numeric/bitop/get_msb.hpp>
 #include <plonk/composer/turbo/compute_verification_key.hpp>
 #include <plonk/proof_system/widgets/random_widgets/permutation_widget.hpp>
+#include <plonk/proof_system/widgets/transition_widgets/fused_transition_widget.hpp>
 #include <plonk/proof_system/widgets/transition_widgets/turbo_arithmetic_widget.hpp>
 #include <plonk/proof_system/widgets/transition_widgets/turbo_fixed_base_widget.hpp>
 #include <plonk/proof_system/widgets/transition_widgets/turbo_logic_widget.hpp>
@@ -932,6 +933,7 @@ std::shared_ptr<proving_key> TurboComposer::compute_proving_key()
     std::copy(turbo_polynomial_manifest,
               turbo_polynomial_manifest + 20,
               std::back_inserter(circuit_proving_key->polynomial_manifest));
+    circuit_proving_key->init_polynomial_store();
 
     circuit_proving_key->recursive_proof_public_input_indices =
         std::vector<uint32_t>(recursive_proof_public_input_indices.begin(), recursive_proof_public_input_indices.end());
@@ -964,6 +966,15 @@ std::shared_ptr<program_witness> TurboComposer::compute_witness()
     return ComposerBase::compute_witness_base<turbo_settings>();
 }
 
+// The transition widgets' quotient contributions are computed in a single pass over the large domain
+template <typename Settings>
+using ProverTurboTransitionWidgets = widget::FusedTransitionWidget<barretenberg::fr,
+                                                                   Settings,
+                                                                   widget::TurboArithmeticKernel,
+                                                                   widget::TurboFixedBaseKernel,
+                                                                   widget::TurboRangeKernel,
+                                                                   widget::TurboLogicKernel>;
+
 TurboProver TurboComposer::create_prover()
 {
     compute_proving_key();
@@ -974,22 +985,12 @@ TurboProver TurboComposer::create_prover()
 
     std::unique_ptr<ProverPermutationWidget<4, false>> permutation_widget =
         std::make_unique<ProverPermutationWidget<4, false>>(circuit_proving_key.get(), witness.get());
-    std::unique_ptr<ProverTurboRangeWidget<turbo_settings>> range_widget =
-        std::make_unique<ProverTurboRangeWidget<turbo_settings>>(circuit_proving_key.get(), witness.get());
-    std::unique_ptr<ProverTurboLogicWidget<turbo_settings>> logic_widget =
-        std::make_unique<ProverTurboLogicWidget<turbo_settings>>(circuit_proving_key.get(), witness.get());
-
-    std::unique_ptr<ProverTurboArithmeticWidget<turbo_settings>> arithmetic_widget =
-        std::make_unique<ProverTurboArithmeticWidget<turbo_settings>>(circuit_proving_key.get(), witness.get());
-    std::unique_ptr<ProverTurboFixedBaseWidget<turbo_settings>> fixed_base_widget =
-        std::make_unique<ProverTurboFixedBaseWidget<turbo_settings>>(circuit_proving_key.get(), witness.get());
+    std::unique_ptr<ProverTurboTransitionWidgets<turbo_settings>> transition_widgets =
+        std::make_unique<ProverTurboTransitionWidgets<turbo_settings>>(circuit_proving_key.get(), witness.get());
 
     output_state.random_widgets.emplace_back(std::move(permutation_widget));
 
-    output_state.transition_widgets.emplace_back(std::move(arithmetic_widget));
-    output_state.transition_widgets.emplace_back(std::move(fixed_base_widget));
-    output_state.transition_widgets.emplace_back(std::move(range_widget));
-    output_state.transition_widgets.emplace_back(std::move(logic_widget));
+    output_state.transition_widgets.emplace_back(std::move(transition_widgets));
 
     std::unique_ptr<KateCommitmentScheme<turbo_settings>> kate_commitment_scheme =
         std::make_unique<KateCommitmentScheme<turbo_settings>>();
@@ -1009,23 +1010,13 @@ UnrolledTurboProver TurboComposer::create_unrolled_prover()
     std::unique_ptr<ProverPermutationWidget<4, false>> permutation_widget =
         std::make_unique<ProverPermutationWidget<4, false>>(circuit_proving_key.get(), witness.get());
 
-    std::unique_ptr<ProverTurboRangeWidget<unrolled_turbo_settings>> range_widget =
-        std::make_unique<ProverTurboRangeWidget<unrolled_turbo_settings>>(circuit_proving_key.get(), witness.get());
-    std::unique_ptr<ProverTurboLogicWidget<unrolled_turbo_settings>> logic_widget =
-        std::make_unique<ProverTurboLogicWidget<unrolled_turbo_settings>>(circuit_proving_key.get(), witness.get());
-
-    std::unique_ptr<ProverTurboArithmeticWidget<unrolled_turbo_settings>> arithmetic_widget =
-        std::make_unique<ProverTurboArithmeticWidget<unrolled_turbo_settings>>(circuit_proving_key.get(),
-                                                                               witness.get());
-    std::unique_ptr<ProverTurboFixedBaseWidget<unrolled_turbo_settings>> fixed_base_widget =
-        std::make_unique<ProverTurboFixedBaseWidget<unrolled_turbo_settings>>(circuit_proving_key.get(), witness.get());
+    std::unique_ptr<ProverTurboTransitionWidgets<unrolled_turbo_settings>> transition_widgets =
+        std::make_unique<ProverTurboTransitionWidgets<unrolled_turbo_settings>>(circuit_proving_key.get(),
+                                                                                witness.get());
 
     output_state.random_widgets.emplace_back(std::move(permutation_widget));
 
-    output_state.transition_widgets.emplace_back(std::move(arithmetic_widget));
-    output_state.transition_widgets.emplace_back(std::move(fixed_base_widget));
-    output_state.transition_widgets.emplace_back(std::move(range_widget));
-    output_state.transition_widgets.emplace_back(std::move(logic_widget));
+    output_state.transition_widgets.emplace_back(std::move(transition_widgets));
 
     std::unique_ptr<KateCommitmentScheme<unrolled_turbo_settings>> kate_commitment_scheme =
         std::make_unique<KateCommitmentScheme<unrolled_turbo_settings>>();
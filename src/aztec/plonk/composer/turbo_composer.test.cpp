@@ -2,6 +2,10 @@
 #include <crypto/pedersen/pedersen.hpp>
 #include <gtest/gtest.h>
 #include <plonk/proof_system/proving_key/serialize.hpp>
+#include <plonk/proof_system/widgets/transition_widgets/turbo_arithmetic_widget.hpp>
+#include <plonk/proof_system/widgets/transition_widgets/turbo_fixed_base_widget.hpp>
+#include <plonk/proof_system/widgets/transition_widgets/turbo_logic_widget.hpp>
+#include <plonk/proof_system/widgets/transition_widgets/turbo_range_widget.hpp>
 
 using namespace barretenberg;
 using namespace crypto::pedersen;
@@ -67,6 +71,130 @@ TEST(turbo_composer, composer_from_serialized_keys)
     EXPECT_EQ(result, true);
 }
 
+TEST(turbo_composer, out_of_core_proof)
+{
+    waffle::TurboComposer composer = waffle::TurboComposer();
+    fr a = fr::one();
+    fr b = fr::one();
+    fr c = a + b;
+    uint32_t a_idx = composer.add_variable(a);
+    uint32_t b_idx = composer.add_variable(b);
+    uint32_t c_idx = composer.add_variable(c);
+
+    // enough gates for the quotient to be computed over several chunks of the large domain
+    for (size_t i = 0; i < 2048; ++i) {
+        composer.create_add_gate({ a_idx, b_idx, c_idx, fr::one(), fr::one(), fr::neg_one(), fr::zero() });
+    }
+    uint32_t zero_idx = composer.add_variable(fr::zero());
+    composer.create_big_add_gate(
+        { zero_idx, zero_idx, zero_idx, a_idx, fr::one(), fr::one(), fr::one(), fr::one(), fr::neg_one() });
+
+    auto proving_key = composer.compute_proving_key();
+    proving_key->enable_out_of_core_proving(".", 1);
+    EXPECT_LT(proving_key->get_quotient_chunk_size(), proving_key->large_domain.size);
+
+    waffle::TurboProver prover = composer.create_prover();
+    waffle::TurboVerifier verifier = composer.create_verifier();
+
+    waffle::plonk_proof proof = prover.construct_proof();
+    EXPECT_EQ(proving_key->wire_ffts.at("w_1_fft").is_mapped(), true);
+    EXPECT_EQ(proving_key->quotient_polynomial_parts[0].is_mapped(), true);
+
+    bool result = verifier.verify_proof(proof);
+    EXPECT_EQ(result, true);
+}
+
+TEST(turbo_composer, out_of_core_proof_after_reset)
+{
+    waffle::TurboComposer composer = waffle::TurboComposer();
+    fr a = fr::one();
+    fr b = fr::one();
+    fr c = a + b;
+    uint32_t a_idx = composer.add_variable(a);
+    uint32_t b_idx = composer.add_variable(b);
+    uint32_t c_idx = composer.add_variable(c);
+    for (size_t i = 0; i < 16; ++i) {
+        composer.create_add_gate({ a_idx, b_idx, c_idx, fr::one(), fr::one(), fr::neg_one(), fr::zero() });
+    }
+
+    auto proving_key = composer.compute_proving_key();
+    proving_key->enable_out_of_core_proving(".", 1);
+
+    // reset() maps new wire FFTs, which need room for the coefficients the prover appends to them
+    proving_key->reset();
+    EXPECT_EQ(proving_key->wire_ffts.size(), 5UL);
+    EXPECT_EQ(proving_key->wire_ffts.at("z_fft").is_mapped(), true);
+
+    waffle::TurboProver prover = composer.create_prover();
+    waffle::TurboVerifier verifier = composer.create_verifier();
+
+    waffle::plonk_proof proof = prover.construct_proof();
+
+    bool result = verifier.verify_proof(proof);
+    EXPECT_EQ(result, true);
+}
+
+TEST(turbo_composer, fused_transition_widget_quotient)
+{
+    waffle::TurboComposer composer = waffle::TurboComposer();
+    uint32_t a_idx = composer.add_variable(fr(engine.get_random_uint32()));
+    uint32_t b_idx = composer.add_variable(fr(engine.get_random_uint32()));
+    composer.decompose_into_base4_accumulators(a_idx, 32);
+    composer.create_and_constraint(a_idx, b_idx, 32);
+    composer.create_xor_constraint(a_idx, b_idx, 32);
+
+    waffle::TurboProver prover = composer.create_prover();
+    prover.execute_preamble_round();
+    prover.queue->process_queue();
+    prover.execute_first_round();
+    prover.queue->process_queue();
+    prover.execute_second_round();
+    prover.queue->process_queue();
+    prover.execute_third_round();
+    prover.queue->process_queue();
+    prover.queue->flush_queue();
+    prover.transcript.apply_fiat_shamir("alpha");
+    const fr alpha = fr::serialize_from_buffer(prover.transcript.get_challenge("alpha").begin());
+
+    auto* key = prover.key.get();
+    const size_t large_domain_size = key->large_domain.size;
+    auto get_quotient = [key]() {
+        std::vector<fr> quotient;
+        for (auto& part : key->quotient_polynomial_parts) {
+            for (size_t i = 0; i < key->n; ++i) {
+                quotient.push_back(part[i]);
+                part[i] = fr::zero();
+            }
+        }
+        return quotient;
+    };
+    get_quotient();
+
+    // The composer's prover evaluates every transition widget in one pass
+    ASSERT_EQ(prover.transition_widgets.size(), 1UL);
+    const fr fused_alpha =
+        prover.transition_widgets[0]->compute_quotient_contribution(alpha, prover.transcript, 0, large_domain_size);
+    const std::vector<fr> fused_quotient = get_quotient();
+
+    waffle::ProverTurboArithmeticWidget<waffle::turbo_settings> arithmetic_widget(key, prover.witness.get());
+    waffle::ProverTurboFixedBaseWidget<waffle::turbo_settings> fixed_base_widget(key, prover.witness.get());
+    waffle::ProverTurboRangeWidget<waffle::turbo_settings> range_widget(key, prover.witness.get());
+    waffle::ProverTurboLogicWidget<waffle::turbo_settings> logic_widget(key, prover.witness.get());
+    fr separate_alpha = alpha;
+    separate_alpha =
+        arithmetic_widget.compute_quotient_contribution(separate_alpha, prover.transcript, 0, large_domain_size);
+    separate_alpha =
+        fixed_base_widget.compute_quotient_contribution(separate_alpha, prover.transcript, 0, large_domain_size);
+    separate_alpha =
+        range_widget.compute_quotient_contribution(separate_alpha, prover.transcript, 0, large_domain_size);
+    separate_alpha =
+        logic_widget.compute_quotient_contribution(separate_alpha, prover.transcript, 0, large_domain_size);
+    const std::vector<fr> separate_quotient = get_quotient();
+
+    EXPECT_EQ(fused_alpha, separate_alpha);
+    EXPECT_EQ(fused_quotient, separate_quotient);
+}
+
 TEST(turbo_composer, test_add_gate_proofs)
 {
     waffle::TurboComposer composer = waffle::TurboComposer();
@@ -36,19 +36,7 @@ void KateCommitmentScheme<settings>::compute_opening_polynomial(
     // Under these conditions we can perform this polynomial division in linear time with good constants.
     // Note that the opening polynomial always has (n+1) coefficients for Standard/Turbo/Ultra due to
     // the blinding of the quotient polynomial parts.
-    fr f = polynomial_arithmetic::evaluate(src, z_point, n + 1);
-
-    // compute (1 / -z)
-    fr divisor = -z_point.invert();
-
-    // we're about to shove these coefficients into a pippenger multi-exponentiation routine, where we need
-    // to convert out of montgomery form. So, we can use lazy reduction techniques here without triggering overflows
-    dest[0] = src[0] - f;
-    dest[0] *= divisor;
-    for (size_t i = 1; i < n; ++i) {
-        dest[i] = src[i] - dest[i - 1];
-        dest[i] *= divisor;
-    }
+    polynomial_arithmetic::compute_kate_opening_polynomials({ { { { src, fr::one() } }, src[n], z_point, dest } }, n);
 
     // commit to the opened polynomial
     commit(dest, tag, item_constant, queue);
@@ -87,44 +75,32 @@ void KateCommitmentScheme<settings>::generic_batch_open(const fr* src,
     // P.S. This function isn't actually used anywhere in PLONK but was written as a generic batch
     // opening test case.
 
-    // compute [-z, -z', ... ]
-    fr divisors[num_z_points];
+    // compute the linear combinations F_i(X) = \sum_{j = 1, 2, ..., num_poly} \gamma^{j - 1} * f_{i, j}(X) and the
+    // coefficients of h_i(X) = (F_i(X) - F_i(z))/(X - z) together. F_i(X) has n coefficients, so the last one is
+    // passed as its top coefficient, and h_i(X) has n - 1.
+    std::vector<polynomial_arithmetic::kate_opening> openings(num_z_points);
     for (size_t i = 0; i < num_z_points; ++i) {
-        divisors[i] = -z_points[i];
+        auto& opening = openings[i];
+        const size_t src_offset = (i * n * num_polynomials);
+        fr challenge_pow = 1;
+        opening.top_coefficient = 0;
+        for (size_t j = 0; j < num_polynomials; ++j) {
+            const fr* poly = &src[src_offset + (j * n)];
+            opening.terms.push_back({ poly, challenge_pow });
+            opening.top_coefficient += poly[n - 1] * challenge_pow;
+            challenge_pow *= challenges[i];
+        }
+        opening.z = z_points[i];
+        opening.dest = &dest[i * n];
     }
-    fr::batch_invert(divisors, num_z_points);
+    polynomial_arithmetic::compute_kate_opening_polynomials(openings, n - 1);
 
     for (size_t i = 0; i < num_z_points; ++i) {
-        fr challenge = challenges[i];
-        fr divisor = divisors[i];
-        size_t src_offset = (i * n * num_polynomials);
-        size_t dest_offset = (i * n);
-
-        // compute i-th linear combination polynomial
-        // F_i(X) = \sum_{j = 1, 2, ..., num_poly} \gamma^{j - 1} * f_{i, j}(X)
-        for (size_t k = 0; k < n; ++k) {
-            fr coeff_sum = 0;
-            fr challenge_pow = 1;
-            for (size_t j = 0; j < num_polynomials; ++j) {
-                coeff_sum += challenge_pow * src[src_offset + (j * n) + k];
-                challenge_pow *= challenge;
-            }
-            dest[dest_offset + k] = coeff_sum;
-        }
-
-        // evaluation of the i-th linear combination polynomial F_i(X) at z
-        fr d_i_eval = polynomial_arithmetic::evaluate(&dest[dest_offset], z_points[i], n);
-
-        // compute coefficients of h_i(X) = (F_i(X) - F_i(z))/(X - z) as done in the previous function
-        dest[dest_offset] -= d_i_eval;
-        dest[dest_offset] *= divisor;
-        for (size_t k = 1; k < n; ++k) {
-            dest[dest_offset + k] -= dest[dest_offset + k - 1];
-            dest[dest_offset + k] *= divisor;
-        }
+        // F_i(X) - F_i(z) is divisible by (X - z), so the remainder left in the last coefficient is 0
+        dest[(i * n) + n - 1] = 0;
 
         // commit to the i-th opened polynomial
-        KateCommitmentScheme::commit(&dest[dest_offset], tags[i], item_constants[i], queue);
+        KateCommitmentScheme::commit(&dest[i * n], tags[i], item_constants[i], queue);
     }
 }
 
@@ -198,42 +174,47 @@ void KateCommitmentScheme<settings>::batch_open(const transcript::StandardTransc
         }
     }
 
-    // Add up things to get coefficients of opening polynomials.
-    ITERATE_OVER_DOMAIN_START(input_key->small_domain);
-    opening_poly[i] =
-        settings::use_linearisation ? input_key->linear_poly[i] : input_key->quotient_polynomial_parts[0][i];
-    for (const auto& [poly, challenge] : opened_polynomials_at_zeta) {
-        opening_poly[i] += poly[i] * challenge;
-    }
-    shifted_opening_poly[i] = 0;
-    for (const auto& [poly, challenge] : opened_polynomials_at_zeta_omega) {
-        shifted_opening_poly[i] += poly[i] * challenge;
-    }
-    ITERATE_OVER_DOMAIN_END;
-
-    // Adjust the (n + 1)th coefficient of t_{0,1,2}(X) or r(X) (Note: t_4 (Turbo/Ultra) has only n coefficients)
+    // The opening polynomials are the linear combinations
+    //
+    //   F(X) = r(X) (or t_{low}(X)) + \sum nu_i * f_i(X)   opened at \zeta
+    //   Z(X) = \sum nu'_i * f_i(X)                        opened at \zeta \omega
+    //
+    // which are built and divided by (X - \zeta) and (X - \zeta \omega) in one pass over their coefficients.
+    polynomial_arithmetic::kate_opening opening;
+    opening.terms.push_back(
+        { settings::use_linearisation ? &input_key->linear_poly[0] : &input_key->quotient_polynomial_parts[0][0],
+          fr::one() });
+    opening.terms.insert(opening.terms.end(), opened_polynomials_at_zeta.begin(), opened_polynomials_at_zeta.end());
+    opening.z = zeta;
+    opening.dest = &opening_poly[0];
+
+    // Set the (n + 1)th coefficient from t_{0,1,2}(X) or r(X) (Note: t_4 (Turbo/Ultra) has only n coefficients)
     if (!settings::use_linearisation) {
-        opening_poly[input_key->n] = 0;
+        opening.top_coefficient = 0;
         const fr zeta_pow_n = zeta.pow(static_cast<uint64_t>(input_key->n));
 
         const size_t num_deg_n_poly =
             settings::program_width == 3 ? settings::program_width : settings::program_width - 1;
         fr scalar_mult = 1;
         for (size_t i = 0; i < num_deg_n_poly; i++) {
-            opening_poly[input_key->n] += input_key->quotient_polynomial_parts[i][input_key->n] * scalar_mult;
+            opening.top_coefficient += input_key->quotient_polynomial_parts[i][input_key->n] * scalar_mult;
             scalar_mult *= zeta_pow_n;
         }
     } else {
-        opening_poly[input_key->n] = input_key->linear_poly[input_key->n];
+        opening.top_coefficient = input_key->linear_poly[input_key->n];
     }
 
+    polynomial_arithmetic::kate_opening shifted_opening;
+    shifted_opening.terms.assign(opened_polynomials_at_zeta_omega.begin(), opened_polynomials_at_zeta_omega.end());
+    shifted_opening.top_coefficient = 0;
+    shifted_opening.z = zeta * input_key->small_domain.root;
+    shifted_opening.dest = &shifted_opening_poly[0];
+
     // Compute the W_{\zeta}(X) and W_{\zeta \omega}(X) and commitments to them.
-    const auto zeta_omega = zeta * input_key->small_domain.root;
+    polynomial_arithmetic::compute_kate_opening_polynomials({ opening, shifted_opening }, input_key->n);
 
-    KateCommitmentScheme::compute_opening_polynomial(
-        &opening_poly[0], &opening_poly[0], zeta, input_key->n, "PI_Z", fr(0), queue);
-    KateCommitmentScheme::compute_opening_polynomial(
-        &shifted_opening_poly[0], &shifted_opening_poly[0], zeta_omega, input_key->n, "PI_Z_OMEGA", fr(0), queue);
+    KateCommitmentScheme::commit(&opening_poly[0], "PI_Z", fr(0), queue);
+    KateCommitmentScheme::commit(&shifted_opening_poly[0], "PI_Z_OMEGA", fr(0), queue);
 }
 
 template <typename settings>
@@ -2,6 +2,7 @@
 #include "../public_inputs/public_inputs.hpp"
 #include "../utils/linearizer.hpp"
 #include <chrono>
+#include <common/resource_usage.hpp>
 #include <ecc/curves/bn254/scalar_multiplication/scalar_multiplication.hpp>
 #include <polynomials/iterate_over_domain.hpp>
 #include <polynomials/polynomial_arithmetic.hpp>
@@ -28,6 +29,7 @@ ProverBase<settings>::ProverBase(std::shared_ptr<proving_key> input_key,
     , transcript(input_manifest, settings::hash_type, settings::num_challenge_bytes)
     , key(input_key)
     , witness(input_witness)
+    , queue(new work_queue(key.get(), witness.get(), &transcript))
 {
     if (input_witness && witness->wires.count("z") == 0) {
         witness->wires.insert({ "z", polynomial(n, n) });
@@ -41,6 +43,7 @@ ProverBase<settings>::ProverBase(ProverBase<settings>&& other)
     , key(std::move(other.key))
     , witness(std::move(other.witness))
     , commitment_scheme(std::move(other.commitment_scheme))
+    , queue(new work_queue(key.get(), witness.get(), &transcript))
 {
     for (size_t i = 0; i < other.random_widgets.size(); ++i) {
         random_widgets.emplace_back(std::move(other.random_widgets[i]));
@@ -315,6 +318,9 @@ template <typename settings> void ProverBase<settings>::execute_fourth_round()
 {
     queue->flush_queue();
     transcript.apply_fiat_shamir("alpha");
+
+    // Selector FFTs are left out of keys written without them, and are only needed from here on
+    key->compute_missing_selector_ffts();
 #ifdef DEBUG_TIMING
     std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 #endif
@@ -340,21 +346,29 @@ template <typename settings> void ProverBase<settings>::execute_fourth_round()
     diff = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     std::cerr << "compute permutation grand product coeffs: " << diff.count() << "ms" << std::endl;
 #endif
-    fr alpha_base = fr::serialize_from_buffer(transcript.get_challenge("alpha").begin());
-
-    for (auto& widget : random_widgets) {
+    const fr alpha = fr::serialize_from_buffer(transcript.get_challenge("alpha").begin());
+
+    // The quotient is computed over one chunk of the large domain at a time, so that when the polynomials are mmap'd
+    // only the rows of the current chunk need to be in memory. Every widget starts each chunk from the same alpha.
+    const size_t chunk_size = key->get_quotient_chunk_size();
+    for (size_t chunk_start = 0; chunk_start < key->large_domain.size; chunk_start += chunk_size) {
+        const size_t chunk_end = chunk_start + chunk_size;
+        fr alpha_base = alpha;
+        for (auto& widget : random_widgets) {
 #ifdef DEBUG_TIMING
-        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 #endif
-        alpha_base = widget->compute_quotient_contribution(alpha_base, transcript);
+            alpha_base = widget->compute_quotient_contribution(alpha_base, transcript, chunk_start, chunk_end);
 #ifdef DEBUG_TIMING
-        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-        std::chrono::milliseconds diff = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-        std::cerr << "widget " << i << " quotient compute time: " << diff.count() << "ms" << std::endl;
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            std::chrono::milliseconds diff = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+            std::cerr << "widget " << i << " quotient compute time: " << diff.count() << "ms" << std::endl;
 #endif
-    }
-    for (auto& widget : transition_widgets) {
-        alpha_base = widget->compute_quotient_contribution(alpha_base, transcript);
+        }
+        for (auto& widget : transition_widgets) {
+            alpha_base = widget->compute_quotient_contribution(alpha_base, transcript, chunk_start, chunk_end);
+        }
+        key->release_large_domain_rows(chunk_start, chunk_end);
     }
 
 #ifdef DEBUG_TIMING
@@ -541,6 +555,8 @@ template <typename settings> waffle::plonk_proof& ProverBase<settings>::export_p
 
 template <typename settings> waffle::plonk_proof& ProverBase<settings>::construct_proof()
 {
+    const ResourceUsage initial_usage = ResourceUsage::get();
+
     // Execute init round. Randomize witness polynomials.
     execute_preamble_round();
     queue->process_queue();
@@ -562,6 +578,17 @@ template <typename settings> waffle::plonk_proof& ProverBase<settings>::construc
     execute_fifth_round();
     execute_sixth_round();
     queue->process_queue();
+
+    if (!key->out_of_core_path.empty()) {
+        const ResourceUsage usage = ResourceUsage::get();
+        info("Out-of-core proof: peak resident memory ",
+             usage.peak_resident_bytes >> 20,
+             "MB, read ",
+             (usage.bytes_read - initial_usage.bytes_read) >> 20,
+             "MB, written ",
+             (usage.bytes_written - initial_usage.bytes_written) >> 20,
+             "MB");
+    }
     return export_proof();
 }
 
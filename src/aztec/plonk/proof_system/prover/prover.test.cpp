@@ -311,3 +311,30 @@ TEST(prover, compute_quotient_polynomial)
         EXPECT_EQ((state.key->quotient_polynomial_parts[3].at(i) == fr::zero()), true);
     }
 }
+
+TEST(prover, work_queue_dependency_levels)
+{
+    waffle::Prover state = prover_helpers::generate_test_data(1 << 4);
+    using waffle::work_queue;
+    work_queue queue(state.key.get(), state.witness.get(), &state.transcript);
+    fr* w_1 = state.witness->wires.at("w_1").get_coefficients();
+    fr* w_2 = state.witness->wires.at("w_2").get_coefficients();
+
+    EXPECT_EQ(queue.add_to_queue({ work_queue::WorkType::IFFT, nullptr, "w_1", fr(0), 0 }), 0UL);
+    EXPECT_EQ(queue.add_to_queue({ work_queue::WorkType::IFFT, nullptr, "w_2", fr(0), 0 }), 1UL);
+    const fr msm_size = work_queue::MSMSize::N;
+    EXPECT_EQ(queue.add_to_queue({ work_queue::WorkType::SCALAR_MULTIPLICATION, w_1, "W_1", msm_size, 0 }), 0UL);
+    EXPECT_EQ(queue.add_to_queue({ work_queue::WorkType::SCALAR_MULTIPLICATION, w_2, "W_2", msm_size, 0 }), 1UL);
+    queue.add_to_queue({ work_queue::WorkType::FFT, nullptr, "w_3", fr(0), 0 });
+
+    // The scalar multiplications wait for the IFFTs of their inputs, and then share a level.
+    std::vector<std::vector<size_t>> expected_levels{ { 0, 1, 4 }, { 2, 3 } };
+    EXPECT_EQ(queue.get_dependency_levels(), expected_levels);
+
+    auto item_info = queue.get_queued_work_item_info();
+    EXPECT_EQ(item_info.num_scalar_multiplications, 2U);
+    EXPECT_EQ(item_info.num_iffts, 2U);
+    EXPECT_EQ(queue.get_scalar_multiplication_data(1), w_2);
+    EXPECT_EQ(queue.get_scalar_multiplication_data(2), nullptr);
+    EXPECT_EQ(queue.get_ifft_data(0), w_1);
+}
@@ -4,10 +4,13 @@
 #include "../proving_key/proving_key.hpp"
 #include "../types/program_witness.hpp"
 
+#include <algorithm>
+#include <common/max_threads.hpp>
 #include <ecc/curves/bn254/scalar_multiplication/scalar_multiplication.hpp>
 #include <polynomials/iterate_over_domain.hpp>
 #include <polynomials/polynomial_arithmetic.hpp>
 #include <iostream>
+#include <unordered_map>
 
 namespace waffle {
 class work_queue {
@@ -35,6 +38,15 @@ class work_queue {
         barretenberg::fr shift_factor;
     };
 
+    /**
+     * The memory a work item reads from and writes to. Two items conflict if one of them writes memory the other
+     * touches; conflicting items are run in the order they were queued, everything else may run concurrently.
+     */
+    struct work_item_accesses {
+        std::vector<const void*> reads;
+        std::vector<const void*> writes;
+    };
+
     work_queue(proving_key* prover_key = nullptr,
                program_witness* program_witness = nullptr,
                transcript::StandardTranscript* prover_transcript = nullptr)
@@ -42,6 +54,9 @@ class work_queue {
         , witness(program_witness)
         , transcript(prover_transcript)
         , work_item_queue()
+        , work_item_handles()
+        , scratch_spaces()
+        , scratch_space_size(0)
     {}
 
     work_queue(const work_queue& other) = default;
@@ -53,133 +68,86 @@ class work_queue {
 
     work_item_info get_queued_work_item_info() const
     {
-        uint32_t scalar_mul_count = 0;
-        uint32_t fft_count = 0;
-        uint32_t ifft_count = 0;
-        for (const auto& item : work_item_queue) {
-            if (item.work_type == WorkType::SCALAR_MULTIPLICATION) {
-                ++scalar_mul_count;
-            }
-            if (item.work_type == WorkType::SMALL_FFT) {
-                ++fft_count;
-            }
-            if (item.work_type == WorkType::IFFT) {
-                ++ifft_count;
-            }
-        }
-        return work_item_info{ scalar_mul_count, fft_count, ifft_count };
+        return work_item_info{ static_cast<uint32_t>(work_item_handles[WorkType::SCALAR_MULTIPLICATION].size()),
+                               static_cast<uint32_t>(work_item_handles[WorkType::SMALL_FFT].size()),
+                               static_cast<uint32_t>(work_item_handles[WorkType::IFFT].size()) };
     }
 
     barretenberg::fr* get_scalar_multiplication_data(const size_t work_item_number) const
     {
-        size_t count = 0;
-        for (const auto& item : work_item_queue) {
-            if (item.work_type == WorkType::SCALAR_MULTIPLICATION) {
-                if (count == work_item_number) {
-                    return item.mul_scalars;
-                }
-                ++count;
-            }
-        }
-        return nullptr;
+        const work_item* item = get_work_item(WorkType::SCALAR_MULTIPLICATION, work_item_number);
+        return item ? item->mul_scalars : nullptr;
     }
 
     size_t get_scalar_multiplication_size(const size_t work_item_number) const
     {
-        size_t count = 0;
-        for (const auto& item : work_item_queue) {
-            if (item.work_type == WorkType::SCALAR_MULTIPLICATION) {
-                if (count == work_item_number) {
-                    return item.constant == MSMSize::N ? key->n : key->n + 1;
-                }
-                ++count;
-            }
+        const work_item* item = get_work_item(WorkType::SCALAR_MULTIPLICATION, work_item_number);
+        if (!item) {
+            return 0;
         }
-        return 0;
+        return item->constant == MSMSize::N ? key->n : key->n + 1;
     }
 
     barretenberg::fr* get_ifft_data(const size_t work_item_number) const
     {
-        size_t count = 0;
-        for (const auto& item : work_item_queue) {
-            if (item.work_type == WorkType::IFFT) {
-                if (count == work_item_number) {
-                    auto w = witness->wires.at(item.tag);
-                    barretenberg::polynomial& wire = witness->wires.at(item.tag);
-                    return wire.get_coefficients();
-                }
-                ++count;
-            }
-        }
-        return nullptr;
+        const work_item* item = get_work_item(WorkType::IFFT, work_item_number);
+        return item ? witness->wires.at(item->tag).get_coefficients() : nullptr;
     }
 
     void put_ifft_data(barretenberg::fr* result, const size_t work_item_number)
     {
-        size_t count = 0;
-        for (const auto& item : work_item_queue) {
-            if (item.work_type == WorkType::IFFT) {
-                if (count == work_item_number) {
-                    barretenberg::polynomial& wire = witness->wires.at(item.tag);
-                    memcpy((void*)wire.get_coefficients(), result, key->n * sizeof(barretenberg::fr));
-                    return;
-                }
-                ++count;
-            }
+        const work_item* item = get_work_item(WorkType::IFFT, work_item_number);
+        if (item) {
+            barretenberg::polynomial& wire = witness->wires.at(item->tag);
+            memcpy((void*)wire.get_coefficients(), result, key->n * sizeof(barretenberg::fr));
         }
     }
 
     queued_fft_inputs get_fft_data(const size_t work_item_number) const
     {
-        size_t count = 0;
-        for (const auto& item : work_item_queue) {
-            if (item.work_type == WorkType::SMALL_FFT) {
-                if (count == work_item_number) {
-                    barretenberg::polynomial& wire = witness->wires.at(item.tag);
-                    return { wire.get_coefficients(), key->large_domain.root.pow(static_cast<uint64_t>(item.index)) };
-                }
-                ++count;
-            }
+        const work_item* item = get_work_item(WorkType::SMALL_FFT, work_item_number);
+        if (!item) {
+            return { nullptr, barretenberg::fr(0) };
         }
-        return { nullptr, barretenberg::fr(0) };
+        barretenberg::polynomial& wire = witness->wires.at(item->tag);
+        return { wire.get_coefficients(), key->large_domain.root.pow(static_cast<uint64_t>(item->index)) };
     }
 
     void put_fft_data(barretenberg::fr* result, const size_t work_item_number)
     {
-        size_t count = 0;
-        for (const auto& item : work_item_queue) {
-            if (item.work_type == WorkType::SMALL_FFT) {
-                if (count == work_item_number) {
-                    const size_t n = key->n;
-                    barretenberg::polynomial& wire_fft = key->wire_ffts.at(item.tag + "_fft");
-                    for (size_t i = 0; i < n; ++i) {
-                        wire_fft[4 * i + item.index] = result[i];
-                    }
-                    wire_fft[4 * n + item.index] = result[0];
-                    return;
-                }
-                ++count;
+        const work_item* item = get_work_item(WorkType::SMALL_FFT, work_item_number);
+        if (item) {
+            const size_t n = key->n;
+            barretenberg::polynomial& wire_fft = key->wire_ffts.at(item->tag + "_fft");
+            for (size_t i = 0; i < n; ++i) {
+                wire_fft[4 * i + item->index] = result[i];
             }
+            wire_fft[4 * n + item->index] = result[0];
         }
     }
 
     void put_scalar_multiplication_data(const barretenberg::g1::affine_element result, const size_t work_item_number)
     {
-        size_t count = 0;
-        for (const auto& item : work_item_queue) {
-            if (item.work_type == WorkType::SCALAR_MULTIPLICATION) {
-                if (count == work_item_number) {
-                    transcript->add_element(item.tag, result.to_buffer());
-                    return;
-                }
-                ++count;
-            }
+        const work_item* item = get_work_item(WorkType::SCALAR_MULTIPLICATION, work_item_number);
+        if (item) {
+            transcript->add_element(item->tag, result.to_buffer());
         }
     }
 
-    void flush_queue() { work_item_queue = std::vector<work_item>(); }
+    void flush_queue()
+    {
+        work_item_queue = std::vector<work_item>();
+        for (auto& handles : work_item_handles) {
+            handles.clear();
+        }
+    }
 
-    void add_to_queue(const work_item& item)
+    /**
+     * Queue a work item. Returns its handle, i.e. the `work_item_number` under which its inputs and outputs are
+     * exposed by the `get_*_data` / `put_*_data` methods. On wasm an FFT is split into four SMALL_FFTs, in which
+     * case the handle of the first one is returned.
+     */
+    size_t add_to_queue(const work_item& item)
     {
 #if defined(__wasm__)
         if (item.work_type == WorkType::FFT) {
@@ -187,127 +155,310 @@ class work_queue {
             barretenberg::fr coset_shifts[4]{
                 barretenberg::fr(1), large_root, large_root.sqr(), large_root.sqr() * large_root
             };
-            work_item_queue.push_back({
+            const size_t handle = push_work_item({
                 WorkType::SMALL_FFT,
                 nullptr,
                 item.tag,
                 coset_shifts[0],
                 0,
             });
-            work_item_queue.push_back({
+            push_work_item({
                 WorkType::SMALL_FFT,
                 nullptr,
                 item.tag,
                 coset_shifts[1],
                 1,
             });
-            work_item_queue.push_back({
+            push_work_item({
                 WorkType::SMALL_FFT,
                 nullptr,
                 item.tag,
                 coset_shifts[2],
                 2,
             });
-            work_item_queue.push_back({
+            push_work_item({
                 WorkType::SMALL_FFT,
                 nullptr,
                 item.tag,
                 coset_shifts[3],
                 3,
             });
-        } else {
-            work_item_queue.push_back(item);
+            return handle;
         }
-#else
-        work_item_queue.push_back(item);
 #endif
+        return push_work_item(item);
     }
 
-    virtual void process_queue()
+    /**
+     * The memory read and written by a queued item.
+     * Scalar multiplications only read their scalars: the scalar multiplications of one level are run one after the
+     * other, on all threads, before the rest of the level (see `process_scalar_multiplications`), so they never
+     * compete for the pippenger runtime state. FFTs and IFFTs of different polynomials are independent.
+     */
+    work_item_accesses get_work_item_accesses(const work_item& item) const
     {
-        for (const auto& item : work_item_queue) {
-            switch (item.work_type) {
-            // most expensive op
-            case WorkType::SCALAR_MULTIPLICATION: {
-
-                // We use the variable work_item::constant to set the size of the multi-scalar multiplication.
-                // Note that a size (n+1) MSM is always needed to commit to the quotient polynomial parts t_1, t_2
-                // and t_3 for Standard/Turbo/Ultra due to the addition of blinding factors
-                if (item.constant == MSMSize::N_PLUS_ONE) {
-                    if (key->reference_string->get_size() < key->small_domain.size + 1) {
-                        info("Reference string too small for Pippenger.");
-                    }
-                    auto runtime_state =
-                        barretenberg::scalar_multiplication::pippenger_runtime_state(key->small_domain.size + 1);
-                    barretenberg::g1::affine_element result(
-                        barretenberg::scalar_multiplication::pippenger_unsafe(item.mul_scalars,
-                                                                              key->reference_string->get_monomials(),
-                                                                              key->small_domain.size + 1,
-                                                                              runtime_state));
-
-                    transcript->add_element(item.tag, result.to_buffer());
-                } else {
-                    ASSERT(item.constant == MSMSize::N);
-                    if (key->reference_string->get_size() < key->small_domain.size) {
-                        info("Reference string too small for Pippenger.");
-                    }
-                    barretenberg::g1::affine_element result(
-                        barretenberg::scalar_multiplication::pippenger_unsafe(item.mul_scalars,
-                                                                              key->reference_string->get_monomials(),
-                                                                              key->small_domain.size,
-                                                                              key->pippenger_runtime_state));
-
-                    transcript->add_element(item.tag, result.to_buffer());
-                }
+        switch (item.work_type) {
+        case WorkType::SCALAR_MULTIPLICATION: {
+            return { { item.mul_scalars }, {} };
+        }
+        case WorkType::SMALL_FFT:
+        case WorkType::FFT: {
+            return { { witness->wires.at(item.tag).get_coefficients() },
+                     { key->wire_ffts.at(item.tag + "_fft").get_coefficients() } };
+        }
+        case WorkType::IFFT: {
+            return { {}, { witness->wires.at(item.tag).get_coefficients() } };
+        }
+        default: {
+            return {};
+        }
+        }
+    }
+
+    /**
+     * Partition the queue into levels of the dependency graph: every item only conflicts with items queued before it
+     * in strictly lower levels, so the items of one level can be processed concurrently once all lower levels are
+     * done. Items are listed by queue position and each level preserves queue order.
+     */
+    std::vector<std::vector<size_t>> get_dependency_levels() const
+    {
+        // An item has to run after the last writer of everything it touches, and after every reader, since that
+        // write, of what it writes. Earlier accesses are already ordered before those, so one pass over the queue
+        // keeping the latest such levels per memory location is enough.
+        struct memory_levels {
+            size_t num_writes = 0;
+            size_t last_write_level = 0;
+            size_t num_reads_since_write = 0;
+            size_t max_read_level_since_write = 0;
+        };
+        std::unordered_map<const void*, memory_levels> memory;
 
-                break;
+        std::vector<std::vector<size_t>> levels;
+        for (size_t i = 0; i < work_item_queue.size(); ++i) {
+            const work_item_accesses accesses = get_work_item_accesses(work_item_queue[i]);
+            size_t level = 0;
+            for (const void* ptr : accesses.reads) {
+                const auto& m = memory[ptr];
+                if (m.num_writes) {
+                    level = std::max(level, m.last_write_level + 1);
+                }
             }
-            // About 20% of the cost of a scalar multiplication. For WASM, might be a bit more expensive
-            // due to the need to copy memory between web workers
-            case WorkType::SMALL_FFT: {
-                const size_t n = key->n;
-                barretenberg::polynomial& wire = witness->wires.at(item.tag);
-                barretenberg::polynomial& wire_fft = key->wire_ffts.at(item.tag + "_fft");
-
-                barretenberg::polynomial wire_copy(wire, n);
-                wire_copy.coset_fft_with_generator_shift(key->small_domain, item.constant);
-
-                for (size_t i = 0; i < n; ++i) {
-                    wire_fft[4 * i + item.index] = wire_copy[i];
+            for (const void* ptr : accesses.writes) {
+                const auto& m = memory[ptr];
+                if (m.num_writes) {
+                    level = std::max(level, m.last_write_level + 1);
+                }
+                if (m.num_reads_since_write) {
+                    level = std::max(level, m.max_read_level_since_write + 1);
                 }
-                wire_fft[4 * n + item.index] = wire_copy[0];
-                break;
             }
-            case WorkType::FFT: {
-                barretenberg::polynomial& wire = witness->wires.at(item.tag);
-                barretenberg::polynomial& wire_fft = key->wire_ffts.at(item.tag + "_fft");
-                barretenberg::polynomial_arithmetic::copy_polynomial(&wire[0], &wire_fft[0], key->n, 4 * key->n + 4);
-                wire_fft.coset_fft(key->large_domain);
-                wire_fft.add_lagrange_base_coefficient(wire_fft[0]);
-                wire_fft.add_lagrange_base_coefficient(wire_fft[1]);
-                wire_fft.add_lagrange_base_coefficient(wire_fft[2]);
-                wire_fft.add_lagrange_base_coefficient(wire_fft[3]);
-                break;
+
+            for (const void* ptr : accesses.reads) {
+                auto& m = memory[ptr];
+                m.max_read_level_since_write = m.num_reads_since_write ? std::max(m.max_read_level_since_write, level)
+                                                                       : level;
+                ++m.num_reads_since_write;
             }
-            // 1/4 the cost of an fft (each fft has 1/4 the number of elements)
-            case WorkType::IFFT: {
-                barretenberg::polynomial& wire = witness->wires.at(item.tag);
-                wire.ifft(key->small_domain);
-                break;
+            for (const void* ptr : accesses.writes) {
+                auto& m = memory[ptr];
+                ++m.num_writes;
+                m.last_write_level = level;
+                m.num_reads_since_write = 0;
             }
-            default: {
+
+            if (level == levels.size()) {
+                levels.push_back({});
             }
+            levels[level].push_back(i);
+        }
+        return levels;
+    }
+
+    /**
+     * Process all queued items, level by level of the dependency graph (see `get_dependency_levels`).
+     * The scalar multiplications of a level are run first, one at a time on all threads. The remaining items of the
+     * level share the available threads: each one runs on its own team of threads, using nested parallelism, and
+     * teams pick up the next item of the level as they finish. Transcript elements are added once all items are
+     * done, in queue order.
+     */
+    virtual void process_queue()
+    {
+        std::vector<barretenberg::g1::affine_element> msm_results(work_item_queue.size());
+
+        for (const auto& level : get_dependency_levels()) {
+            std::vector<size_t> scalar_multiplications;
+            std::vector<size_t> concurrent_items;
+            for (const size_t index : level) {
+                if (work_item_queue[index].work_type == WorkType::SCALAR_MULTIPLICATION) {
+                    scalar_multiplications.push_back(index);
+                } else {
+                    concurrent_items.push_back(index);
+                }
+            }
+            process_scalar_multiplications(scalar_multiplications, msm_results);
+#ifndef NO_MULTITHREADING
+            const size_t num_threads = max_threads::compute_num_threads();
+            if (concurrent_items.size() > 1 && num_threads > 1) {
+                const size_t num_teams = std::min(concurrent_items.size(), num_threads);
+                const int threads_per_team = static_cast<int>(num_threads / num_teams);
+                reserve_scratch_spaces(num_teams);
+                const int max_active_levels = omp_get_max_active_levels();
+                omp_set_max_active_levels(std::max(max_active_levels, 2));
+#pragma omp parallel for num_threads(static_cast<int>(num_teams)) schedule(dynamic, 1)
+                for (size_t i = 0; i < concurrent_items.size(); ++i) {
+                    omp_set_num_threads(threads_per_team);
+                    const auto team = static_cast<size_t>(omp_get_thread_num());
+                    barretenberg::polynomial_arithmetic::scratch_space_override scratch_space(
+                        scratch_spaces[team].get(), scratch_space_size);
+                    process_work_item(work_item_queue[concurrent_items[i]]);
+                }
+                omp_set_max_active_levels(max_active_levels);
+                continue;
+            }
+#endif
+            for (const size_t index : concurrent_items) {
+                process_work_item(work_item_queue[index]);
             }
         }
-        work_item_queue = std::vector<work_item>();
+
+        for (size_t i = 0; i < work_item_queue.size(); ++i) {
+            if (work_item_queue[i].work_type == WorkType::SCALAR_MULTIPLICATION) {
+                transcript->add_element(work_item_queue[i].tag, msm_results[i].to_buffer());
+            }
+        }
+        flush_queue();
     }
 
     std::vector<work_item> get_queue() const { return work_item_queue; }
 
+  private:
+    /**
+     * Make sure there is FFT scratch space for `num_teams` items running at once. It is kept for the lifetime of the
+     * queue, so that it is allocated once per prover rather than once per round.
+     */
+    void reserve_scratch_spaces(const size_t num_teams)
+    {
+        const size_t size = key->large_domain.size;
+        if (size > scratch_space_size) {
+            scratch_spaces.clear();
+            scratch_space_size = size;
+        }
+        while (scratch_spaces.size() < num_teams) {
+            scratch_spaces.emplace_back(
+                static_cast<barretenberg::fr*>(aligned_alloc(64, scratch_space_size * sizeof(barretenberg::fr))),
+                aligned_free);
+        }
+    }
+
+    size_t push_work_item(const work_item& item)
+    {
+        auto& handles = work_item_handles[item.work_type];
+        handles.push_back(work_item_queue.size());
+        work_item_queue.push_back(item);
+        return handles.size() - 1;
+    }
+
+    const work_item* get_work_item(const WorkType work_type, const size_t work_item_number) const
+    {
+        const auto& handles = work_item_handles[work_type];
+        return work_item_number < handles.size() ? &work_item_queue[handles[work_item_number]] : nullptr;
+    }
+
+    /**
+     * Compute the scalar multiplications at `indices` in the queue, writing the results to `msm_results`, which the
+     * caller adds to the transcript (the transcript is not thread safe).
+     */
+    void process_scalar_multiplications(const std::vector<size_t>& indices,
+                                        std::vector<barretenberg::g1::affine_element>& msm_results)
+    {
+        for (const size_t index : indices) {
+            const work_item& item = work_item_queue[index];
+
+            // We use the variable work_item::constant to set the size of the multi-scalar multiplication.
+            // Note that a size (n+1) MSM is always needed to commit to the quotient polynomial parts t_1, t_2
+            // and t_3 for Standard/Turbo/Ultra due to the addition of blinding factors
+            if (item.constant == MSMSize::N_PLUS_ONE) {
+                if (key->reference_string->get_size() < key->small_domain.size + 1) {
+                    info("Reference string too small for Pippenger.");
+                }
+                auto runtime_state =
+                    barretenberg::scalar_multiplication::pippenger_runtime_state(key->small_domain.size + 1);
+                msm_results[index] =
+                    barretenberg::scalar_multiplication::pippenger_unsafe(item.mul_scalars,
+                                                                          key->reference_string->get_monomials(),
+                                                                          key->small_domain.size + 1,
+                                                                          runtime_state);
+            } else {
+                ASSERT(item.constant == MSMSize::N);
+                if (key->reference_string->get_size() < key->small_domain.size) {
+                    info("Reference string too small for Pippenger.");
+                }
+                msm_results[index] =
+                    barretenberg::scalar_multiplication::pippenger_unsafe(item.mul_scalars,
+                                                                          key->reference_string->get_monomials(),
+                                                                          key->small_domain.size,
+                                                                          key->pippenger_runtime_state);
+            }
+        }
+    }
+
+    /**
+     * Process a single FFT or IFFT item.
+     */
+    void process_work_item(const work_item& item)
+    {
+        switch (item.work_type) {
+        // About 20% of the cost of a scalar multiplication. For WASM, might be a bit more expensive
+        // due to the need to copy memory between web workers
+        case WorkType::SMALL_FFT: {
+            const size_t n = key->n;
+            barretenberg::polynomial& wire = witness->wires.at(item.tag);
+            barretenberg::polynomial& wire_fft = key->wire_ffts.at(item.tag + "_fft");
+
+            barretenberg::polynomial wire_copy(wire, n);
+            wire_copy.coset_fft_with_generator_shift(key->small_domain, item.constant);
+
+            for (size_t i = 0; i < n; ++i) {
+                wire_fft[4 * i + item.index] = wire_copy[i];
+            }
+            wire_fft[4 * n + item.index] = wire_copy[0];
+            break;
+        }
+        case WorkType::FFT: {
+            barretenberg::polynomial& wire = witness->wires.at(item.tag);
+            barretenberg::polynomial& wire_fft = key->wire_ffts.at(item.tag + "_fft");
+            barretenberg::polynomial_arithmetic::copy_polynomial(&wire[0], &wire_fft[0], key->n, 4 * key->n + 4);
+            wire_fft.coset_fft(key->large_domain);
+            wire_fft.add_lagrange_base_coefficient(wire_fft[0]);
+            wire_fft.add_lagrange_base_coefficient(wire_fft[1]);
+            wire_fft.add_lagrange_base_coefficient(wire_fft[2]);
+            wire_fft.add_lagrange_base_coefficient(wire_fft[3]);
+            // Out of core, write the FFT back to its file until the quotient computation reads it
+            wire_fft.release(0, wire_fft.get_size());
+            break;
+        }
+        // 1/4 the cost of an fft (each fft has 1/4 the number of elements)
+        case WorkType::IFFT: {
+            barretenberg::polynomial& wire = witness->wires.at(item.tag);
+            wire.ifft(key->small_domain);
+            break;
+        }
+        default: {
+        }
+        }
+    }
+
   public:
     proving_key* key;
     program_witness* witness;
     transcript::StandardTranscript* transcript;
     std::vector<work_item> work_item_queue;
+
+  private:
+    // Queue positions of the items of each work type, indexed by handle.
+    std::array<std::vector<size_t>, 4> work_item_handles;
+    // FFT scratch space of each team of threads in process_queue, of `scratch_space_size` elements each.
+    std::vector<std::shared_ptr<barretenberg::fr>> scratch_spaces;
+    size_t scratch_space_size;
 };
-} // namespace waffle
\ No newline at end of file
+} // namespace waffle
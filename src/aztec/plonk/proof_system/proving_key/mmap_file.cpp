@@ -0,0 +1,278 @@
+#include "mmap_file.hpp"
+#include <common/mem.hpp>
+#include <common/throw_or_abort.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifndef __wasm__
+#include <sys/mman.h>
+#endif
+
+namespace waffle {
+
+namespace {
+
+struct file_header {
+    static constexpr uint64_t MAGIC = 0x3130594b454b5042ULL; // "BPKEKY01"
+    static constexpr uint32_t VERSION = 1;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t composer_type;
+    uint32_t n;
+    uint32_t num_public_inputs;
+    uint32_t contains_recursive_proof;
+    uint32_t num_recursive_proof_public_input_indices;
+    uint32_t num_polynomials;
+    uint32_t reserved;
+    // Checksum of the header (with this field zeroed), the recursive proof public input indices and the table
+    uint64_t checksum;
+};
+
+struct file_entry {
+    static constexpr size_t MAX_NAME_SIZE = 47;
+
+    char name[MAX_NAME_SIZE + 1];
+    // Index into `get_maps`
+    uint32_t map;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t num_coefficients;
+    uint64_t checksum;
+};
+
+constexpr size_t POLYNOMIAL_ALIGNMENT = 64;
+constexpr size_t NUM_MAPS = 5;
+
+// The maps that hold the polynomials in a key, in file order. Entries 1 and 4 are the coset FFTs.
+template <typename Key> auto get_maps(Key& key)
+{
+    return std::array{ &key.constraint_selectors,
+                       &key.constraint_selector_ffts,
+                       &key.permutation_selectors,
+                       &key.permutation_selectors_lagrange_base,
+                       &key.permutation_selector_ffts };
+}
+
+constexpr bool is_fft_map(const size_t map)
+{
+    return map == 1 || map == 4;
+}
+
+size_t align(const size_t offset, const size_t alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * 64-bit FNV-1a over 64-bit words. `size` is a multiple of 8.
+ * This detects truncated or corrupted files, it is not meant to be collision resistant.
+ */
+uint64_t update_checksum(uint64_t hash, void const* data, const size_t size)
+{
+    const uint64_t* words = static_cast<uint64_t const*>(data);
+    for (size_t i = 0; i < size / sizeof(uint64_t); ++i) {
+        hash = (hash ^ words[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+constexpr uint64_t CHECKSUM_INIT = 0xcbf29ce484222325ULL;
+
+// The size of the indices, padded so that the table that follows them is 8 byte aligned
+size_t get_indices_size(const size_t num_indices)
+{
+    return align(num_indices * sizeof(uint32_t), sizeof(uint64_t));
+}
+
+uint64_t compute_metadata_checksum(file_header header, uint8_t const* indices, size_t num_indices, void const* table)
+{
+    header.checksum = 0;
+    uint64_t hash = update_checksum(CHECKSUM_INIT, &header, sizeof(header));
+    hash = update_checksum(hash, indices, get_indices_size(num_indices));
+    return update_checksum(hash, table, header.num_polynomials * sizeof(file_entry));
+}
+
+/**
+ * Read the whole file into memory that lives as long as the returned pointer. Outside of wasm it is mapped read only,
+ * and its pages are only read from disk on first access.
+ */
+std::shared_ptr<void> map_file(std::string const& filename, size_t& size)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw_or_abort("Filename not found: " + filename);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw_or_abort("Could not stat: " + filename);
+    }
+    size = (size_t)st.st_size;
+#ifndef __wasm__
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw_or_abort("Could not map: " + filename);
+    }
+    const size_t mapped_size = size;
+    return std::shared_ptr<void>(data, [mapped_size](void* p) { munmap(p, mapped_size); });
+#else
+    void* data = aligned_alloc(POLYNOMIAL_ALIGNMENT, align(size, POLYNOMIAL_ALIGNMENT));
+    size_t bytes_read = 0;
+    while (bytes_read < size) {
+        auto result = ::read(fd, static_cast<uint8_t*>(data) + bytes_read, size - bytes_read);
+        if (result <= 0) {
+            break;
+        }
+        bytes_read += (size_t)result;
+    }
+    close(fd);
+    if (bytes_read != size) {
+        aligned_free(data);
+        throw_or_abort("Could not read: " + filename);
+    }
+    return std::shared_ptr<void>(data, aligned_free);
+#endif
+}
+
+} // namespace
+
+void write_mmap_file(std::string const& filename, proving_key const& key, const bool include_ffts)
+{
+    const auto maps = get_maps(key);
+    std::vector<file_entry> table;
+    std::vector<barretenberg::polynomial const*> polynomials;
+    const size_t num_indices = key.recursive_proof_public_input_indices.size();
+    const size_t table_start = sizeof(file_header) + get_indices_size(num_indices);
+
+    size_t num_polynomials = 0;
+    for (size_t i = 0; i < NUM_MAPS; ++i) {
+        num_polynomials += (include_ffts || !is_fft_map(i)) ? maps[i]->size() : 0;
+    }
+    size_t offset = align(table_start + num_polynomials * sizeof(file_entry), POLYNOMIAL_ALIGNMENT);
+    for (size_t i = 0; i < NUM_MAPS; ++i) {
+        if (!include_ffts && is_fft_map(i)) {
+            continue;
+        }
+        for (auto& value : *maps[i]) {
+            if (value.first.size() > file_entry::MAX_NAME_SIZE) {
+                throw_or_abort("Polynomial name too long for a proving key file: " + value.first);
+            }
+            file_entry entry{};
+            std::memcpy(entry.name, value.first.data(), value.first.size());
+            entry.map = static_cast<uint32_t>(i);
+            entry.offset = offset;
+            entry.num_coefficients = value.second.get_size();
+            table.push_back(entry);
+            polynomials.push_back(&value.second);
+            offset = align(offset + entry.num_coefficients * sizeof(barretenberg::fr), POLYNOMIAL_ALIGNMENT);
+        }
+    }
+
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i].checksum = update_checksum(CHECKSUM_INIT,
+                                            polynomials[i]->get_coefficients(),
+                                            table[i].num_coefficients * sizeof(barretenberg::fr));
+    }
+
+    std::vector<uint8_t> indices(get_indices_size(num_indices), 0);
+    std::memcpy(indices.data(), key.recursive_proof_public_input_indices.data(), num_indices * sizeof(uint32_t));
+
+    file_header header{};
+    header.magic = file_header::MAGIC;
+    header.version = file_header::VERSION;
+    header.composer_type = key.composer_type;
+    header.n = static_cast<uint32_t>(key.n);
+    header.num_public_inputs = static_cast<uint32_t>(key.num_public_inputs);
+    header.contains_recursive_proof = key.contains_recursive_proof;
+    header.num_recursive_proof_public_input_indices = static_cast<uint32_t>(num_indices);
+    header.num_polynomials = static_cast<uint32_t>(table.size());
+    header.checksum = compute_metadata_checksum(header, indices.data(), num_indices, table.data());
+
+    // Write to a temporary file and rename it into place, so that a reader never maps a partial key.
+    const std::string tmp_filename = filename + ".tmp." + std::to_string(getpid());
+    std::ofstream file(tmp_filename, std::ios::binary);
+    file.write((char*)&header, sizeof(header));
+    file.write((char*)indices.data(), (std::streamsize)indices.size());
+    file.write((char*)table.data(), (std::streamsize)(table.size() * sizeof(file_entry)));
+    size_t position = table_start + table.size() * sizeof(file_entry);
+    const std::vector<char> padding(POLYNOMIAL_ALIGNMENT, 0);
+    for (size_t i = 0; i < table.size(); ++i) {
+        file.write(padding.data(), (std::streamsize)(table[i].offset - position));
+        const size_t size = table[i].num_coefficients * sizeof(barretenberg::fr);
+        file.write((char*)polynomials[i]->get_coefficients(), (std::streamsize)size);
+        position = table[i].offset + size;
+    }
+    file.close();
+    if (!file || std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        std::remove(tmp_filename.c_str());
+        throw_or_abort("Failed to write: " + filename);
+    }
+}
+
+void read_mmap_file(std::string const& filename, proving_key_data& key, const bool verify_checksums)
+{
+    size_t file_size = 0;
+    auto mapped_file = map_file(filename, file_size);
+    auto* data = static_cast<uint8_t*>(mapped_file.get());
+
+    file_header header;
+    if (file_size < sizeof(header)) {
+        throw_or_abort("Not a proving key file: " + filename);
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != file_header::MAGIC) {
+        throw_or_abort("Not a proving key file: " + filename);
+    }
+    if (header.version != file_header::VERSION) {
+        throw_or_abort(format("Unsupported proving key file version ", header.version, ": ", filename));
+    }
+    const size_t num_indices = header.num_recursive_proof_public_input_indices;
+    const size_t table_start = sizeof(file_header) + get_indices_size(num_indices);
+    const size_t table_end = table_start + header.num_polynomials * sizeof(file_entry);
+    if (table_end > file_size ||
+        header.checksum != compute_metadata_checksum(header, data + sizeof(header), num_indices, data + table_start)) {
+        throw_or_abort("Corrupt proving key file: " + filename);
+    }
+
+    key.composer_type = header.composer_type;
+    key.n = header.n;
+    key.num_public_inputs = header.num_public_inputs;
+    key.contains_recursive_proof = header.contains_recursive_proof != 0;
+    key.recursive_proof_public_input_indices.resize(num_indices);
+    std::memcpy(key.recursive_proof_public_input_indices.data(), data + sizeof(header), num_indices * sizeof(uint32_t));
+
+    const auto maps = get_maps(key);
+    for (auto* map : maps) {
+        map->clear();
+    }
+    auto const* table = reinterpret_cast<file_entry const*>(data + table_start);
+    for (size_t i = 0; i < header.num_polynomials; ++i) {
+        const auto& entry = table[i];
+        const size_t max_coefficients = (file_size - table_end) / sizeof(barretenberg::fr);
+        if (entry.map >= NUM_MAPS || entry.name[file_entry::MAX_NAME_SIZE] != 0 ||
+            entry.offset % POLYNOMIAL_ALIGNMENT != 0 || entry.offset < table_end ||
+            entry.num_coefficients > max_coefficients ||
+            entry.offset + entry.num_coefficients * sizeof(barretenberg::fr) > file_size) {
+            throw_or_abort("Corrupt proving key file: " + filename);
+        }
+        auto* coefficients = reinterpret_cast<barretenberg::fr*>(data + entry.offset);
+        if (verify_checksums &&
+            entry.checksum != update_checksum(CHECKSUM_INIT,
+                                              coefficients,
+                                              entry.num_coefficients * sizeof(barretenberg::fr))) {
+            throw_or_abort(format("Corrupt polynomial ", entry.name, " in proving key file: ", filename));
+        }
+        maps[entry.map]->emplace(entry.name, barretenberg::polynomial::view(coefficients, entry.num_coefficients));
+    }
+    key.mapped_file = std::move(mapped_file);
+}
+
+} // namespace waffle
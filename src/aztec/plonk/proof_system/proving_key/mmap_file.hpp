@@ -0,0 +1,27 @@
+#pragma once
+#include "proving_key.hpp"
+#include <string>
+
+namespace waffle {
+
+/**
+ * Single file proving key format.
+ *
+ * A header holding the key's metadata is followed by a table of the polynomials in the key, giving each one's map,
+ * name, offset and checksum, and then by the coefficients of each polynomial, starting on a 64 byte boundary. Loading
+ * maps the whole file once, and each polynomial in the key points into the mapping rather than being copied out of it,
+ * so a key loads in the time it takes to read its header and table. Coefficients are paged in as the prover touches
+ * them.
+ *
+ * The selector coset FFTs are 4x the size of everything else in the key, and can be left out with `include_ffts`.
+ * The prover then computes them on first use (see `proving_key::compute_missing_selector_ffts`).
+ */
+void write_mmap_file(std::string const& filename, proving_key const& key, const bool include_ffts = true);
+
+/**
+ * Map the proving key in `filename` into `key`. The header and table are always checked; the checksums of the
+ * polynomials are only checked when `verify_checksums` is set, as it reads the whole file.
+ */
+void read_mmap_file(std::string const& filename, proving_key_data& key, const bool verify_checksums = false);
+
+} // namespace waffle
@@ -0,0 +1,65 @@
+#include "polynomial_store.hpp"
+#include <common/mem.hpp>
+#ifndef __wasm__
+#include <sys/mman.h>
+#endif
+
+namespace waffle {
+
+namespace {
+// Transparent huge pages are 2MB on x86-64 (and on aarch64 with 4KB base pages)
+constexpr size_t HUGE_PAGE_SIZE = 2UL << 20;
+
+std::shared_ptr<barretenberg::fr> allocate_arena(const size_t size)
+{
+#ifndef __wasm__
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+        // Only a hint: without THP support we still get one contiguous mapping
+        madvise(memory, size, MADV_HUGEPAGE);
+#endif
+        return std::shared_ptr<barretenberg::fr>(static_cast<barretenberg::fr*>(memory),
+                                                 [size](barretenberg::fr* arena) { munmap(arena, size); });
+    }
+#endif
+    return std::shared_ptr<barretenberg::fr>(static_cast<barretenberg::fr*>(aligned_alloc(64, size)), aligned_free);
+}
+
+// Every polynomial starts on a cache line boundary
+size_t get_packed_size(const barretenberg::polynomial& polynomial)
+{
+    return (polynomial.get_max_size() + 1) & ~1UL;
+}
+} // namespace
+
+void PolynomialStore::pack()
+{
+    size_t num_elements = 0;
+    for (const auto* polynomial : slots) {
+        if (polynomial != nullptr && !polynomial->is_mapped()) {
+            num_elements += get_packed_size(*polynomial);
+        }
+    }
+    if (num_elements == 0) {
+        return;
+    }
+
+    const size_t num_bytes = num_elements * sizeof(barretenberg::fr);
+    const size_t size = ((num_bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
+    std::shared_ptr<barretenberg::fr> new_arena = allocate_arena(size);
+    barretenberg::fr* next = new_arena.get();
+    for (auto* polynomial : slots) {
+        if (polynomial != nullptr && !polynomial->is_mapped()) {
+            const size_t packed_size = get_packed_size(*polynomial);
+            polynomial->relocate(next);
+            next += packed_size;
+        }
+    }
+
+    // Any previous arena is only released once everything has moved out of it
+    arena = std::move(new_arena);
+    arena_size = size;
+}
+
+} // namespace waffle
@@ -0,0 +1,78 @@
+#pragma once
+#include <array>
+#include <common/assert.hpp>
+#include <memory>
+#include <polynomials/polynomial.hpp>
+
+#include "../types/polynomial_manifest.hpp"
+
+namespace waffle {
+
+/**
+ * Compile-time indexed view of a proving key's polynomials.
+ *
+ * Every polynomial described by the polynomial manifest has one slot per form (monomial, Lagrange base and coset FFT),
+ * keyed by its `PolynomialIndex`, so a lookup is an array access rather than a string comparison and a map walk. The
+ * polynomials themselves are still the entries of the proving key's string-keyed maps (`constraint_selectors`,
+ * `permutation_selector_ffts`, ...), which remain the API for code that has not moved over to the store.
+ *
+ * `pack` moves the indexed polynomials into a single contiguous arena, backed by transparent huge pages where the
+ * kernel supports them. A 2^20 gate TurboPLONK key holds 15 selector and permutation polynomials in each form, and
+ * their coset FFTs alone take 1.9GB; on 4KB pages the widgets' interleaved walks over them are dominated by TLB misses.
+ *
+ * The slots are raw pointers to the map entries. They stay valid while entries are only added to the maps (the maps are
+ * node based), but erasing an entry or assigning a new map leaves a dangling slot. Code that does either must call
+ * `proving_key::init_polynomial_store()` afterwards to re-index the polynomials.
+ **/
+class PolynomialStore {
+  public:
+    enum Form {
+        MONOMIAL,
+        LAGRANGE,
+        FFT,
+        NUM_FORMS,
+    };
+
+    bool contains(const PolynomialIndex index, const Form form) const
+    {
+        return slots[get_slot(index, form)] != nullptr;
+    }
+
+    barretenberg::polynomial& get(const PolynomialIndex index, const Form form) const
+    {
+        barretenberg::polynomial* result = slots[get_slot(index, form)];
+        ASSERT(result != nullptr);
+        return *result;
+    }
+
+    void set(const PolynomialIndex index, const Form form, barretenberg::polynomial* polynomial)
+    {
+        slots[get_slot(index, form)] = polynomial;
+    }
+
+    // Forget every polynomial (but not the arena, which may still hold the coefficients of some of them)
+    void clear() { slots.fill(nullptr); }
+
+    /**
+     * Move the coefficients of every indexed polynomial into one contiguous arena. Read-only, mmap'd polynomials are
+     * left where they are. Polynomials that grow later move back out into memory of their own.
+     **/
+    void pack();
+
+    // Size of the arena in bytes
+    size_t get_arena_size() const { return arena_size; }
+
+  private:
+    static constexpr size_t get_slot(const PolynomialIndex index, const Form form)
+    {
+        return static_cast<size_t>(index) * NUM_FORMS + static_cast<size_t>(form);
+    }
+
+    static constexpr size_t NUM_SLOTS = static_cast<size_t>(PolynomialIndex::MAX_NUM_POLYNOMIALS) * NUM_FORMS;
+
+    std::array<barretenberg::polynomial*, NUM_SLOTS> slots{};
+    std::shared_ptr<barretenberg::fr> arena;
+    size_t arena_size = 0;
+};
+
+} // namespace waffle
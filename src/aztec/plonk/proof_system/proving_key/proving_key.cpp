@@ -4,6 +4,56 @@
 
 namespace waffle {
 
+namespace {
+/**
+ * The string-keyed map that holds the given form of polynomials from `source`. Witness polynomials are not part of the
+ * key (and their FFTs are rewritten for every proof), so they are not indexed.
+ **/
+std::map<std::string, barretenberg::polynomial>* get_polynomial_map(proving_key& key,
+                                                                    const PolynomialSource source,
+                                                                    const PolynomialStore::Form form)
+{
+    switch (source) {
+    case PolynomialSource::SELECTOR: {
+        return std::array{ &key.constraint_selectors,
+                           &key.constraint_selectors_lagrange_base,
+                           &key.constraint_selector_ffts }[form];
+    }
+    case PolynomialSource::PERMUTATION: {
+        return std::array{ &key.permutation_selectors,
+                           &key.permutation_selectors_lagrange_base,
+                           &key.permutation_selector_ffts }[form];
+    }
+    default: {
+        return nullptr;
+    }
+    }
+}
+
+std::string get_polynomial_label(const PolynomialDescriptor& descriptor, const PolynomialStore::Form form)
+{
+    const std::string label(descriptor.polynomial_label);
+    return (form == PolynomialStore::FFT) ? label + "_fft" : label;
+}
+
+// The FFTs written by every prover: those of the wires (standard composers leave w_4 unused) and of the permutation
+// grand product. `reset` creates these on a new key, and keeps any FFTs a composer adds on top of them.
+const std::array<std::string, 5> DEFAULT_WIRE_FFT_LABELS = { "w_1_fft", "w_2_fft", "w_3_fft", "w_4_fft", "z_fft" };
+
+// A copy of `polynomial` (including any coefficients beyond its size) in a file-backed polynomial
+barretenberg::polynomial map_to_file(const barretenberg::polynomial& polynomial, std::string const& filename)
+{
+    barretenberg::polynomial result(filename, polynomial.get_size(), polynomial.get_max_size());
+    memcpy(static_cast<void*>(result.get_coefficients()),
+           static_cast<void*>(polynomial.get_coefficients()),
+           sizeof(barretenberg::fr) * polynomial.get_max_size());
+    return result;
+}
+
+// The quotient is computed over at least this many rows of the large domain at a time (128KB of each polynomial)
+constexpr size_t MIN_QUOTIENT_CHUNK_SIZE = 1UL << 12;
+} // namespace
+
 // In all the constructors below, the pippenger_runtime_state takes (n + 1) as the input
 // as the degree of t_{high}(X) is (n + 1) for standard plonk. Refer to
 // ./src/aztec/plonk/proof_system/prover/prover.cpp/ProverBase::compute_quotient_pre_commitment
@@ -49,6 +99,7 @@ proving_key::proving_key(proving_key_data&& data, std::shared_ptr<ProverReferenc
     , pippenger_runtime_state(n + 1)
     , contains_recursive_proof(data.contains_recursive_proof)
     , recursive_proof_public_input_indices(std::move(data.recursive_proof_public_input_indices))
+    , mapped_file(std::move(data.mapped_file))
 {
     init();
     switch (composer_type) {
@@ -70,6 +121,7 @@ proving_key::proving_key(proving_key_data&& data, std::shared_ptr<ProverReferenc
         throw_or_abort("Received invalid composer type");
     }
     };
+    init_polynomial_store();
 }
 /**
  * Initialize proving key.
@@ -136,37 +188,155 @@ void proving_key::init()
     lagrange_1.add_lagrange_base_coefficient(lagrange_1[7]);
 }
 
+void proving_key::init_polynomial_store(const bool pack)
+{
+    polynomial_store.clear();
+    for (const auto& descriptor : polynomial_manifest) {
+        for (size_t i = 0; i < PolynomialStore::NUM_FORMS; ++i) {
+            const auto form = static_cast<PolynomialStore::Form>(i);
+            auto* map = get_polynomial_map(*this, descriptor.source, form);
+            if (map == nullptr) {
+                continue;
+            }
+            auto it = map->find(get_polynomial_label(descriptor, form));
+            if (it != map->end()) {
+                polynomial_store.set(descriptor.index, form, &it->second);
+            }
+        }
+    }
+    if (pack) {
+        polynomial_store.pack();
+    }
+}
+
+barretenberg::polynomial& proving_key::get_polynomial(const PolynomialDescriptor& descriptor,
+                                                      const PolynomialStore::Form form)
+{
+    if (!polynomial_store.contains(descriptor.index, form)) {
+        auto* map = get_polynomial_map(*this, descriptor.source, form);
+        if (map == nullptr) {
+            throw_or_abort("Witness polynomials are not held by the polynomial store");
+        }
+        polynomial_store.set(descriptor.index, form, &map->at(get_polynomial_label(descriptor, form)));
+    }
+    return polynomial_store.get(descriptor.index, form);
+}
+
+void proving_key::compute_missing_selector_ffts()
+{
+    for (auto [monomials, ffts] : { std::pair{ &constraint_selectors, &constraint_selector_ffts },
+                                    std::pair{ &permutation_selectors, &permutation_selector_ffts } }) {
+        for (const auto& value : *monomials) {
+            const std::string label = value.first + "_fft";
+            if (ffts->find(label) != ffts->end()) {
+                continue;
+            }
+            barretenberg::polynomial fft(value.second, large_domain.size);
+            fft.coset_fft(large_domain);
+            ffts->insert({ label, std::move(fft) });
+        }
+    }
+}
+
+void proving_key::enable_out_of_core_proving(std::string const& path, const size_t budget)
+{
+    out_of_core_path = path;
+    memory_budget = budget;
+
+    for (auto& value : wire_ffts) {
+        value.second = map_to_file(value.second, format(path, "/", value.first));
+    }
+    lagrange_1 = map_to_file(lagrange_1, format(path, "/lagrange_1"));
+    for (size_t i = 0; i < NUM_QUOTIENT_PARTS; ++i) {
+        quotient_polynomial_parts[i] = map_to_file(quotient_polynomial_parts[i], format(path, "/quotient_", i + 1));
+    }
+}
+
+size_t proving_key::get_quotient_chunk_size() const
+{
+    if (memory_budget == 0) {
+        return large_domain.size;
+    }
+    // Each row of the large domain is one coefficient of every coset FFT, of L_1 and of the quotient
+    const size_t num_polynomials =
+        constraint_selector_ffts.size() + permutation_selector_ffts.size() + wire_ffts.size() + 2;
+    const size_t max_chunk_size = memory_budget / (num_polynomials * sizeof(barretenberg::fr));
+
+    // Chunks are a power of two in size, so that they tile the domain
+    size_t chunk_size = MIN_QUOTIENT_CHUNK_SIZE;
+    while (chunk_size < large_domain.size && 2 * chunk_size <= max_chunk_size) {
+        chunk_size *= 2;
+    }
+    return std::min(chunk_size, large_domain.size);
+}
+
+void proving_key::release_large_domain_rows(const size_t start, const size_t end) const
+{
+    for (const auto* map : { &constraint_selector_ffts, &permutation_selector_ffts, &wire_ffts }) {
+        for (const auto& value : *map) {
+            value.second.release(start, end);
+        }
+    }
+    lagrange_1.release(start, end);
+
+    // Row i of the large domain is coefficient (i mod n) of quotient part (i / n)
+    for (size_t i = start / n; i < NUM_QUOTIENT_PARTS && i * n < end; ++i) {
+        quotient_polynomial_parts[i].release(std::max(start, i * n) - i * n, std::min(end, (i + 1) * n) - i * n);
+    }
+}
+
+size_t proving_key::get_memory_size() const
+{
+    size_t num_coefficients = lagrange_1.get_max_size() + opening_poly.get_max_size() +
+                              shifted_opening_poly.get_max_size() + linear_poly.get_max_size();
+    for (const auto& part : quotient_polynomial_parts) {
+        num_coefficients += part.get_max_size();
+    }
+    for (const auto* map : { &constraint_selectors,
+                             &constraint_selectors_lagrange_base,
+                             &constraint_selector_ffts,
+                             &permutation_selectors,
+                             &permutation_selectors_lagrange_base,
+                             &permutation_selector_ffts,
+                             &wire_ffts }) {
+        for (const auto& value : *map) {
+            num_coefficients += value.second.get_max_size();
+        }
+    }
+    return num_coefficients * sizeof(barretenberg::fr);
+}
+
 /**
  * Reset proving key
  *
- * Clear wire_ffts and fill it with new zeroed out polynomials of size (4 * n + 4) for each of:
- * (w_1_fft, w_2_fft, w_3_fft, w_4_fft, z_fft). Create opening_poly of size n.
+ * Replace each polynomial in wire_ffts (or, on a new key, each of DEFAULT_WIRE_FFT_LABELS) with a new zeroed out
+ * polynomial of size (4 * n + 4), so that composers that add FFTs of their own keep them. Create opening_poly of
+ * size n. When proving out of core, the new polynomials are backed by files in out_of_core_path.
  *
  **/
 void proving_key::reset()
 {
+    std::vector<std::string> labels;
+    for (const auto& value : wire_ffts) {
+        labels.push_back(value.first);
+    }
+    if (labels.empty()) {
+        labels.assign(DEFAULT_WIRE_FFT_LABELS.begin(), DEFAULT_WIRE_FFT_LABELS.end());
+    }
     wire_ffts.clear();
 
     opening_poly = barretenberg::polynomial(n + 1, n + 1);
     memset((void*)&opening_poly[0], 0x00, sizeof(barretenberg::fr) * (n + 1));
 
-    barretenberg::polynomial w_1_fft = barretenberg::polynomial(4 * n + 4, 4 * n + 4);
-    barretenberg::polynomial w_2_fft = barretenberg::polynomial(4 * n + 4, 4 * n + 4);
-    barretenberg::polynomial w_3_fft = barretenberg::polynomial(4 * n + 4, 4 * n + 4);
-    barretenberg::polynomial w_4_fft = barretenberg::polynomial(4 * n + 4, 4 * n + 4);
-    barretenberg::polynomial z_fft = barretenberg::polynomial(4 * n + 4, 4 * n + 4);
-
-    memset((void*)&w_1_fft[0], 0x00, sizeof(barretenberg::fr) * (4 * n + 4));
-    memset((void*)&w_2_fft[0], 0x00, sizeof(barretenberg::fr) * (4 * n + 4));
-    memset((void*)&w_3_fft[0], 0x00, sizeof(barretenberg::fr) * (4 * n + 4));
-    memset((void*)&w_4_fft[0], 0x00, sizeof(barretenberg::fr) * (4 * n + 4));
-    memset((void*)&z_fft[0], 0x00, sizeof(barretenberg::fr) * (4 * n + 4));
-
-    wire_ffts.insert({ "w_1_fft", std::move(w_1_fft) });
-    wire_ffts.insert({ "w_2_fft", std::move(w_2_fft) });
-    wire_ffts.insert({ "w_3_fft", std::move(w_3_fft) });
-    wire_ffts.insert({ "w_4_fft", std::move(w_4_fft) });
-    wire_ffts.insert({ "z_fft", std::move(z_fft) });
+    for (const auto& label : labels) {
+        if (!out_of_core_path.empty()) {
+            wire_ffts.insert({ label, barretenberg::polynomial(format(out_of_core_path, "/", label), 4 * n + 4) });
+            continue;
+        }
+        barretenberg::polynomial fft = barretenberg::polynomial(4 * n + 4, 4 * n + 4);
+        memset((void*)&fft[0], 0x00, sizeof(barretenberg::fr) * (4 * n + 4));
+        wire_ffts.insert({ label, std::move(fft) });
+    }
 }
 
 proving_key::proving_key(const proving_key& other)
@@ -196,19 +366,21 @@ proving_key::proving_key(const proving_key& other)
     quotient_polynomial_parts[1] = other.quotient_polynomial_parts[1];
     quotient_polynomial_parts[2] = other.quotient_polynomial_parts[2];
     quotient_polynomial_parts[3] = other.quotient_polynomial_parts[3];
+    init_polynomial_store(false);
 }
 
 proving_key::proving_key(proving_key&& other)
     : composer_type(other.composer_type)
     , n(other.n)
     , num_public_inputs(other.num_public_inputs)
-    , constraint_selectors(other.constraint_selectors)
-    , constraint_selectors_lagrange_base(other.constraint_selectors_lagrange_base)
-    , constraint_selector_ffts(other.constraint_selector_ffts)
-    , permutation_selectors(other.permutation_selectors)
-    , permutation_selectors_lagrange_base(other.permutation_selectors_lagrange_base)
-    , permutation_selector_ffts(other.permutation_selector_ffts)
-    , wire_ffts(other.wire_ffts)
+    , constraint_selectors(std::move(other.constraint_selectors))
+    , constraint_selectors_lagrange_base(std::move(other.constraint_selectors_lagrange_base))
+    , constraint_selector_ffts(std::move(other.constraint_selector_ffts))
+    , permutation_selectors(std::move(other.permutation_selectors))
+    , permutation_selectors_lagrange_base(std::move(other.permutation_selectors_lagrange_base))
+    , permutation_selector_ffts(std::move(other.permutation_selector_ffts))
+    , wire_ffts(std::move(other.wire_ffts))
+    , polynomial_store(std::move(other.polynomial_store))
     , small_domain(std::move(other.small_domain))
     , large_domain(std::move(other.large_domain))
     , reference_string(std::move(other.reference_string))
@@ -220,6 +392,9 @@ proving_key::proving_key(proving_key&& other)
     , polynomial_manifest(std::move(other.polynomial_manifest))
     , contains_recursive_proof(other.contains_recursive_proof)
     , recursive_proof_public_input_indices(std::move(other.recursive_proof_public_input_indices))
+    , out_of_core_path(std::move(other.out_of_core_path))
+    , memory_budget(other.memory_budget)
+    , mapped_file(std::move(other.mapped_file))
 {}
 
 proving_key& proving_key::operator=(proving_key&& other)
@@ -234,6 +409,7 @@ proving_key& proving_key::operator=(proving_key&& other)
     permutation_selectors_lagrange_base = std::move(other.permutation_selectors_lagrange_base);
     permutation_selector_ffts = std::move(other.permutation_selector_ffts);
     wire_ffts = std::move(other.wire_ffts);
+    polynomial_store = std::move(other.polynomial_store);
     small_domain = std::move(other.small_domain);
     large_domain = std::move(other.large_domain);
     reference_string = std::move(other.reference_string);
@@ -245,6 +421,9 @@ proving_key& proving_key::operator=(proving_key&& other)
     polynomial_manifest = std::move(other.polynomial_manifest);
     contains_recursive_proof = other.contains_recursive_proof;
     recursive_proof_public_input_indices = std::move(other.recursive_proof_public_input_indices);
+    out_of_core_path = std::move(other.out_of_core_path);
+    memory_budget = other.memory_budget;
+    mapped_file = std::move(other.mapped_file);
 
     return *this;
 }
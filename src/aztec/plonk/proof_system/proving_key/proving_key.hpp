@@ -7,6 +7,7 @@
 #include <plonk/proof_system/constants.hpp>
 
 #include "../types/polynomial_manifest.hpp"
+#include "polynomial_store.hpp"
 
 namespace waffle {
 
@@ -21,6 +22,8 @@ struct proving_key_data {
     std::map<std::string, barretenberg::polynomial> permutation_selectors;
     std::map<std::string, barretenberg::polynomial> permutation_selectors_lagrange_base;
     std::map<std::string, barretenberg::polynomial> permutation_selector_ffts;
+    // The mapped file the polynomials point into, when the key was read with `read_mmap_file`
+    std::shared_ptr<void> mapped_file;
 };
 
 inline bool operator==(proving_key_data const& lhs, proving_key_data const& rhs)
@@ -59,6 +62,33 @@ struct proving_key {
 
     void init();
 
+    // Index the selector and permutation polynomials described by `polynomial_manifest` in `polynomial_store`, and
+    // move them into its contiguous arena if `pack` is set. Composers call this once the key is complete.
+    void init_polynomial_store(const bool pack = true);
+
+    // Fetch a selector or permutation polynomial from `polynomial_store`. Polynomials that were added to the string
+    // keyed maps after `init_polynomial_store` are looked up by label (and indexed) on first use.
+    barretenberg::polynomial& get_polynomial(const PolynomialDescriptor& descriptor, const PolynomialStore::Form form);
+
+    // Compute the coset FFT of each selector and permutation polynomial whose FFT is not in the key, i.e. when the key
+    // was written without them by `write_mmap_file`. The prover calls this before computing the quotient.
+    void compute_missing_selector_ffts();
+
+    // Out-of-core proving: back the large domain polynomials that are rewritten for every proof (the witness and grand
+    // product coset FFTs, L_1 and the quotient) with files in the directory `path`, and compute the quotient over as
+    // many rows of the large domain at a time as fit in `memory_budget` bytes. When the selectors do not fit in memory
+    // either, load the key with `read_mmap`.
+    void enable_out_of_core_proving(std::string const& path, const size_t memory_budget);
+
+    // Number of rows of the large domain the quotient is computed over at a time
+    size_t get_quotient_chunk_size() const;
+
+    // Drop rows [start, end) of every mmap'd large domain polynomial from memory (see `polynomial::release`)
+    void release_large_domain_rows(const size_t start, const size_t end) const;
+
+    // Approximate number of bytes held by the key's polynomials, counting mmap'd polynomials as if they were resident
+    size_t get_memory_size() const;
+
     uint32_t composer_type;
     size_t n;
     size_t num_public_inputs;
@@ -73,6 +103,8 @@ struct proving_key {
 
     std::map<std::string, barretenberg::polynomial> wire_ffts;
 
+    PolynomialStore polynomial_store;
+
     barretenberg::evaluation_domain small_domain;
     barretenberg::evaluation_domain large_domain;
 
@@ -91,6 +123,15 @@ struct proving_key {
 
     bool contains_recursive_proof = false;
     std::vector<uint32_t> recursive_proof_public_input_indices;
+
+    // Directory of the files backing out-of-core polynomials (empty when proving in memory), and the memory budget
+    // of the quotient computation in bytes (0 if unbounded)
+    std::string out_of_core_path;
+    size_t memory_budget = 0;
+
+    // Keeps the file the key was read from with `read_mmap_file` mapped, as its polynomials point into it
+    std::shared_ptr<void> mapped_file;
+
     static constexpr size_t min_thread_block = 4UL;
 };
 
@@ -1,7 +1,10 @@
 #include <common/test.hpp>
 #include <common/streams.hpp>
 #include "proving_key.hpp"
+#include "mmap_file.hpp"
 #include "serialize.hpp"
+#include "../../composer/standard_composer.hpp"
+#include <cstdio>
 
 using namespace barretenberg;
 using namespace waffle;
@@ -15,6 +18,18 @@ polynomial create_polynomial(size_t size)
     return p;
 }
 
+void create_add_gates(StandardComposer& composer)
+{
+    for (size_t i = 0; i < 16; ++i) {
+        fr a = fr(i);
+        fr b = fr(i + 1);
+        uint32_t a_idx = composer.add_variable(a);
+        uint32_t b_idx = composer.add_variable(b);
+        uint32_t c_idx = composer.add_variable(a + b);
+        composer.create_add_gate({ a_idx, b_idx, c_idx, fr::one(), fr::one(), fr::neg_one(), fr::zero() });
+    }
+}
+
 TEST(proving_key, buffer_serialization)
 {
     proving_key_data key;
@@ -51,4 +66,114 @@ TEST(proving_key, stream_serialization)
     read(static_cast<std::istream&>(s), result);
 
     EXPECT_EQ(key, result);
-}
\ No newline at end of file
+}
+
+TEST(proving_key, polynomial_store)
+{
+    const size_t n = 16;
+    proving_key key(n, 0, nullptr);
+    std::copy(
+        standard_polynomial_manifest, standard_polynomial_manifest + 12, std::back_inserter(key.polynomial_manifest));
+    key.constraint_selectors["q_m"] = create_polynomial(n);
+    key.constraint_selector_ffts["q_m_fft"] = create_polynomial(4 * n);
+    key.permutation_selectors["sigma_1"] = create_polynomial(n);
+    const polynomial q_m(key.constraint_selectors.at("q_m"));
+    const polynomial sigma_1(key.permutation_selectors.at("sigma_1"));
+
+    key.init_polynomial_store();
+    EXPECT_TRUE(key.polynomial_store.contains(Q_M, PolynomialStore::MONOMIAL));
+    EXPECT_TRUE(key.polynomial_store.contains(Q_M, PolynomialStore::FFT));
+    EXPECT_TRUE(key.polynomial_store.contains(SIGMA_1, PolynomialStore::MONOMIAL));
+    EXPECT_FALSE(key.polynomial_store.contains(Q_1, PolynomialStore::MONOMIAL));
+    EXPECT_GT(key.polynomial_store.get_arena_size(), 0UL);
+
+    // The string-keyed maps and the store share the (packed) polynomials.
+    polynomial& packed_q_m = key.polynomial_store.get(Q_M, PolynomialStore::MONOMIAL);
+    EXPECT_EQ(&packed_q_m, &key.constraint_selectors.at("q_m"));
+    EXPECT_EQ(packed_q_m, q_m);
+    EXPECT_EQ(key.polynomial_store.get(SIGMA_1, PolynomialStore::MONOMIAL), sigma_1);
+
+    // Polynomials added after the store was built are found by label.
+    key.constraint_selector_ffts["q_1_fft"] = create_polynomial(4 * n);
+    const PolynomialDescriptor& q_1_descriptor = standard_polynomial_manifest[4];
+    EXPECT_EQ(&key.get_polynomial(q_1_descriptor, PolynomialStore::FFT), &key.constraint_selector_ffts.at("q_1_fft"));
+    EXPECT_TRUE(key.polynomial_store.contains(Q_1, PolynomialStore::FFT));
+
+    // Growing a packed polynomial moves it out of the arena, and keeps its coefficients.
+    packed_q_m.resize(packed_q_m.get_max_size() + 1);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(packed_q_m[i], q_m[i]);
+    }
+
+    // Moving the key keeps the store (and its arena) valid.
+    proving_key moved_key(std::move(key));
+    EXPECT_EQ(&moved_key.polynomial_store.get(SIGMA_1, PolynomialStore::MONOMIAL),
+              &moved_key.permutation_selectors.at("sigma_1"));
+    EXPECT_EQ(moved_key.polynomial_store.get(SIGMA_1, PolynomialStore::MONOMIAL), sigma_1);
+}
+
+TEST(proving_key, mmap_file_without_ffts)
+{
+    StandardComposer composer;
+    create_add_gates(composer);
+    auto key = composer.compute_proving_key();
+    auto verification_key = composer.compute_verification_key();
+
+    const std::string filename = "proving_key_mmap_file_test.dat";
+    write_mmap_file(filename, *key, false);
+    proving_key_data data;
+    read_mmap_file(filename, data, true);
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(data.composer_type, key->composer_type);
+    EXPECT_EQ(data.n, key->n);
+    EXPECT_EQ(data.constraint_selectors, key->constraint_selectors);
+    EXPECT_EQ(data.permutation_selectors, key->permutation_selectors);
+    EXPECT_EQ(data.permutation_selectors_lagrange_base, key->permutation_selectors_lagrange_base);
+    EXPECT_TRUE(data.constraint_selector_ffts.empty());
+    EXPECT_TRUE(data.permutation_selector_ffts.empty());
+    // The polynomials point into the mapped file, which outlives the file's directory entry.
+    EXPECT_TRUE(data.constraint_selectors.at("q_m").is_mapped());
+
+    auto loaded_key = std::make_shared<proving_key>(std::move(data), key->reference_string);
+    loaded_key->compute_missing_selector_ffts();
+    EXPECT_EQ(loaded_key->constraint_selector_ffts, key->constraint_selector_ffts);
+    EXPECT_EQ(loaded_key->permutation_selector_ffts, key->permutation_selector_ffts);
+
+    // A proof from the loaded key verifies, computing the FFTs it left out on the way.
+    loaded_key->constraint_selector_ffts.clear();
+    loaded_key->permutation_selector_ffts.clear();
+    StandardComposer loaded_composer(loaded_key, verification_key);
+    create_add_gates(loaded_composer);
+    auto prover = loaded_composer.create_prover();
+    auto verifier = loaded_composer.create_verifier();
+    waffle::plonk_proof proof = prover.construct_proof();
+    EXPECT_TRUE(verifier.verify_proof(proof));
+}
+
+TEST(proving_key, mmap_file_checksums)
+{
+    StandardComposer composer;
+    create_add_gates(composer);
+    auto key = composer.compute_proving_key();
+
+    const std::string filename = "proving_key_mmap_file_checksum_test.dat";
+    write_mmap_file(filename, *key);
+    {
+        proving_key_data data;
+        read_mmap_file(filename, data, true);
+        EXPECT_EQ(data.constraint_selector_ffts, key->constraint_selector_ffts);
+        EXPECT_EQ(data.permutation_selector_ffts, key->permutation_selector_ffts);
+    }
+
+    // Corrupt the last coefficient in the file. Only a read that verifies the polynomial checksums notices.
+    {
+        std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put(0x55);
+    }
+    proving_key_data data;
+    read_mmap_file(filename, data);
+    EXPECT_ANY_THROW(read_mmap_file(filename, data, true));
+    std::remove(filename.c_str());
+}
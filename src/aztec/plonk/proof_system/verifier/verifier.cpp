@@ -8,6 +8,7 @@
 #include <ecc/curves/bn254/pairing.hpp>
 #include <ecc/curves/bn254/scalar_multiplication/scalar_multiplication.hpp>
 #include <polynomials/polynomial_arithmetic.hpp>
+#include <algorithm>
 
 using namespace barretenberg;
 
@@ -37,9 +38,12 @@ VerifierBase<program_settings>& VerifierBase<program_settings>::operator=(Verifi
     return *this;
 }
 
-template <typename program_settings> bool VerifierBase<program_settings>::verify_proof(const waffle::plonk_proof& proof)
+template <typename program_settings>
+void VerifierBase<program_settings>::append_pairing_msm_inputs(const waffle::plonk_proof& proof,
+                                                               const barretenberg::fr& batch_weight,
+                                                               pairing_msm_inputs& inputs)
 {
-    // This function verifies a PLONK proof for given program settings.
+    // This function runs the verifier for a PLONK proof for given program settings, up to the final pairing check.
     // A PLONK proof for standard PLONK with linearisation as on page 31 in the paper is of the form:
     //
     // π_SNARK =   { [a]_1,[b]_1,[c]_1,[z]_1,[t_{low}]_1,[t_{mid}]_1,[t_{high}]_1,[W_z]_1,[W_zω]_1 \in G,
@@ -47,6 +51,9 @@ template <typename program_settings> bool VerifierBase<program_settings>::verify
     //
     // Proof π_SNARK must be first added in the transcrip with other program settings.
     //
+    // The two G1 points of the pairing check are not computed here: their scalar multiplication inputs, scaled by
+    // `batch_weight`, are appended to `inputs` so that several proofs can share one MSM and one pairing.
+    //
 
     key->program_width = program_settings::program_width;
     transcript::StandardTranscript transcript = transcript::StandardTranscript(
@@ -68,6 +75,9 @@ template <typename program_settings> bool VerifierBase<program_settings>::verify
     transcript.apply_fiat_shamir("alpha");
     transcript.apply_fiat_shamir("z");
 
+    kate_g1_elements.clear();
+    kate_fr_elements.clear();
+
     const auto alpha = fr::serialize_from_buffer(transcript.get_challenge("alpha").begin());
     const auto zeta = fr::serialize_from_buffer(transcript.get_challenge("z").begin());
 
@@ -143,7 +153,7 @@ template <typename program_settings> bool VerifierBase<program_settings>::verify
     if (!PI_Z.on_curve() || PI_Z.is_point_at_infinity()) {
         throw_or_abort("opening proof group element PI_Z not a valid point");
     }
-    if (!PI_Z_OMEGA.on_curve() || PI_Z.is_point_at_infinity()) {
+    if (!PI_Z_OMEGA.on_curve() || PI_Z_OMEGA.is_point_at_infinity()) {
         throw_or_abort("opening proof group element PI_Z_OMEGA not a valid point");
     }
 
@@ -154,35 +164,36 @@ template <typename program_settings> bool VerifierBase<program_settings>::verify
     kate_g1_elements.insert({ "PI_Z", PI_Z });
     kate_fr_elements.insert({ "PI_Z", zeta });
 
-    std::vector<fr> scalars;
-    std::vector<g1::affine_element> elements;
-
-    for (const auto& [key, value] : kate_g1_elements) {
-        if (value.on_curve() && !value.is_point_at_infinity()) {
-            scalars.emplace_back(kate_fr_elements.at(key));
-            elements.emplace_back(value);
+    for (const auto& [label, value] : kate_g1_elements) {
+        if (!value.on_curve() || value.is_point_at_infinity()) {
+            continue;
+        }
+        const fr scalar = kate_fr_elements.at(label) * batch_weight;
+        const auto shared_term = inputs.shared_lhs_terms.find(label);
+        if (shared_term != inputs.shared_lhs_terms.end() && inputs.lhs_elements[shared_term->second] == value) {
+            inputs.lhs_scalars[shared_term->second] += scalar;
+        } else {
+            inputs.shared_lhs_terms.insert({ label, inputs.lhs_elements.size() });
+            inputs.lhs_scalars.emplace_back(scalar);
+            inputs.lhs_elements.emplace_back(value);
         }
     }
 
-    size_t num_elements = elements.size();
-    elements.resize(num_elements * 2);
-    barretenberg::scalar_multiplication::generate_pippenger_point_table(&elements[0], &elements[0], num_elements);
-    scalar_multiplication::pippenger_runtime_state state(num_elements);
-
-    g1::element P[2];
-
-    P[0] = barretenberg::scalar_multiplication::pippenger(&scalars[0], &elements[0], num_elements, state);
-    P[1] = -(g1::element(PI_Z_OMEGA) * separator_challenge + PI_Z);
+    // P[1] = -([W_zω]_1 * separator + [W_z]_1)
+    inputs.rhs_scalars.emplace_back(-(separator_challenge * batch_weight));
+    inputs.rhs_elements.emplace_back(PI_Z_OMEGA);
+    inputs.rhs_scalars.emplace_back(-batch_weight);
+    inputs.rhs_elements.emplace_back(PI_Z);
 
     if (key->contains_recursive_proof) {
         ASSERT(key->recursive_proof_public_input_indices.size() == 16);
-        const auto& inputs = transcript.get_field_element_vector("public_inputs");
+        const auto& public_inputs = transcript.get_field_element_vector("public_inputs");
         const auto recover_fq_from_public_inputs =
-            [&inputs](const size_t idx0, const size_t idx1, const size_t idx2, const size_t idx3) {
-                const uint256_t l0 = inputs[idx0];
-                const uint256_t l1 = inputs[idx1];
-                const uint256_t l2 = inputs[idx2];
-                const uint256_t l3 = inputs[idx3];
+            [&public_inputs](const size_t idx0, const size_t idx1, const size_t idx2, const size_t idx3) {
+                const uint256_t l0 = public_inputs[idx0];
+                const uint256_t l1 = public_inputs[idx1];
+                const uint256_t l2 = public_inputs[idx2];
+                const uint256_t l3 = public_inputs[idx3];
 
                 const uint256_t limb = l0 + (l1 << NUM_LIMB_BITS_IN_FIELD_SIMULATION) +
                                        (l2 << (NUM_LIMB_BITS_IN_FIELD_SIMULATION * 2)) +
@@ -208,9 +219,31 @@ template <typename program_settings> bool VerifierBase<program_settings>::verify
                                                       key->recursive_proof_public_input_indices[13],
                                                       key->recursive_proof_public_input_indices[14],
                                                       key->recursive_proof_public_input_indices[15]);
-        P[0] += g1::element(x0, y0, 1) * recursion_separator_challenge;
-        P[1] += g1::element(x1, y1, 1) * recursion_separator_challenge;
+        inputs.lhs_scalars.emplace_back(recursion_separator_challenge * batch_weight);
+        inputs.lhs_elements.emplace_back(x0, y0);
+        inputs.rhs_scalars.emplace_back(recursion_separator_challenge * batch_weight);
+        inputs.rhs_elements.emplace_back(x1, y1);
     }
+}
+
+template <typename program_settings> bool VerifierBase<program_settings>::check_pairing(pairing_msm_inputs& inputs)
+{
+    const auto multi_scalar_mul = [](std::vector<fr>& scalars, std::vector<g1::affine_element>& elements) {
+        const size_t num_elements = elements.size();
+        if (num_elements == 0) {
+            return g1::element(g1::point_at_infinity);
+        }
+        elements.resize(num_elements * 2);
+        barretenberg::scalar_multiplication::generate_pippenger_point_table(
+            &elements[0], &elements[0], num_elements);
+        scalar_multiplication::pippenger_runtime_state state(num_elements);
+        return barretenberg::scalar_multiplication::pippenger(&scalars[0], &elements[0], num_elements, state);
+    };
+
+    g1::element P[2];
+
+    P[0] = multi_scalar_mul(inputs.lhs_scalars, inputs.lhs_elements);
+    P[1] = multi_scalar_mul(inputs.rhs_scalars, inputs.rhs_elements);
 
     g1::element::batch_normalize(P, 2);
 
@@ -226,6 +259,70 @@ template <typename program_settings> bool VerifierBase<program_settings>::verify
     return (result == barretenberg::fq12::one());
 }
 
+template <typename program_settings> bool VerifierBase<program_settings>::verify_proof(const waffle::plonk_proof& proof)
+{
+    pairing_msm_inputs inputs;
+    append_pairing_msm_inputs(proof, fr::one(), inputs);
+    return check_pairing(inputs);
+}
+
+template <typename program_settings>
+bool VerifierBase<program_settings>::verify_proofs(const std::vector<waffle::plonk_proof>& proofs,
+                                                   std::vector<size_t>& failed_proofs)
+{
+    // Given pairing points (P_0^i, P_1^i) for each proof i, we check
+    //
+    //   e(\sum_i r_i.P_0^i, [x]_2).e(\sum_i r_i.P_1^i, [1]_2) == 1
+    //
+    // for random weights r_i (r_0 = 1). A batch containing an invalid proof passes with probability ~1/|F_r|.
+    // The weighted scalars of every proof are accumulated into a single MSM per pairing point, which lets us share
+    // one pippenger call and one pairing across the whole batch.
+    failed_proofs.clear();
+    if (proofs.empty()) {
+        return true;
+    }
+
+    // A malformed proof (wrong transcript length, invalid group element) is reported as failed rather than aborting
+    // the whole batch. append_pairing_msm_inputs does all of its validation before it writes to `inputs`, so a proof
+    // that throws leaves the accumulated inputs untouched.
+    pairing_msm_inputs inputs;
+    std::vector<size_t> well_formed_proofs;
+    well_formed_proofs.reserve(proofs.size());
+    for (size_t i = 0; i < proofs.size(); ++i) {
+        const fr batch_weight = well_formed_proofs.empty() ? fr::one() : fr::random_element();
+#ifndef __wasm__
+        try {
+            append_pairing_msm_inputs(proofs[i], batch_weight, inputs);
+        } catch (const std::exception&) {
+            failed_proofs.push_back(i);
+            continue;
+        }
+#else
+        append_pairing_msm_inputs(proofs[i], batch_weight, inputs);
+#endif
+        well_formed_proofs.push_back(i);
+    }
+    if (check_pairing(inputs)) {
+        return failed_proofs.empty();
+    }
+
+    // The batch failed. Fall back to verifying each proof on its own to identify the culprits.
+    for (const size_t i : well_formed_proofs) {
+        if (!verify_proof(proofs[i])) {
+            failed_proofs.push_back(i);
+        }
+    }
+    std::sort(failed_proofs.begin(), failed_proofs.end());
+    return false;
+}
+
+template <typename program_settings>
+bool VerifierBase<program_settings>::verify_proofs(const std::vector<waffle::plonk_proof>& proofs)
+{
+    std::vector<size_t> failed_proofs;
+    return verify_proofs(proofs, failed_proofs);
+}
+
 template class VerifierBase<unrolled_standard_verifier_settings>;
 template class VerifierBase<unrolled_turbo_verifier_settings>;
 template class VerifierBase<unrolled_plookup_verifier_settings>;
@@ -8,6 +8,21 @@
 #include <plonk/proof_system/commitment_scheme/commitment_scheme.hpp>
 
 namespace waffle {
+
+/**
+ * Scalar multiplication inputs for the two G1 points of the final pairing check,
+ * e(P_0, [x]_2).e(P_1, [1]_2) == 1, accumulated over one or more proofs.
+ * `shared_lhs_terms` maps a kate label to its index in `lhs_elements`, so that group elements common to every proof
+ * (e.g. selector commitments from the verification key) are only added to the MSM once.
+ **/
+struct pairing_msm_inputs {
+    std::vector<barretenberg::fr> lhs_scalars;
+    std::vector<barretenberg::g1::affine_element> lhs_elements;
+    std::vector<barretenberg::fr> rhs_scalars;
+    std::vector<barretenberg::g1::affine_element> rhs_elements;
+    std::map<std::string, size_t> shared_lhs_terms;
+};
+
 template <typename program_settings> class VerifierBase {
 
   public:
@@ -22,6 +37,21 @@ template <typename program_settings> class VerifierBase {
     bool validate_scalars();
 
     bool verify_proof(const waffle::plonk_proof& proof);
+
+    /**
+     * Verify a batch of proofs against `key` using a single pairing.
+     * Each proof's pairing points are scaled by a random weight and folded into one pair of MSMs.
+     * Proofs that cannot be deserialized or contain invalid group elements are dropped from the batch. If any proof
+     * is dropped or the batch does not verify, the indices of the failing proofs are written into `failed_proofs`.
+     **/
+    bool verify_proofs(const std::vector<waffle::plonk_proof>& proofs, std::vector<size_t>& failed_proofs);
+    bool verify_proofs(const std::vector<waffle::plonk_proof>& proofs);
+
+    void append_pairing_msm_inputs(const waffle::plonk_proof& proof,
+                                   const barretenberg::fr& batch_weight,
+                                   pairing_msm_inputs& inputs);
+    bool check_pairing(pairing_msm_inputs& inputs);
+
     transcript::Manifest manifest;
 
     std::shared_ptr<verification_key> key;
@@ -336,4 +336,32 @@ TEST(verifier, verify_damaged_proof)
 
     // verify proof
     EXPECT_ANY_THROW(verifier.verify_proof(proof));
-}
\ No newline at end of file
+}
+
+TEST(verifier, verify_batch_of_arithmetic_proofs)
+{
+    size_t n = 8;
+
+    waffle::Prover state = verifier_helpers::generate_test_data(n);
+    waffle::Verifier verifier = verifier_helpers::generate_verifier(state.key);
+    waffle::plonk_proof proof = state.construct_proof();
+
+    // a proof for a different circuit of the same size, which must not verify against `verifier.key`
+    waffle::Prover other_state = verifier_helpers::generate_test_data(n);
+    waffle::plonk_proof other_proof = other_state.construct_proof();
+
+    std::vector<size_t> failed_proofs;
+    EXPECT_EQ(verifier.verify_proofs({ proof, proof, proof }, failed_proofs), true);
+    EXPECT_EQ(failed_proofs.size(), 0UL);
+
+    EXPECT_EQ(verifier.verify_proofs({ proof, other_proof, proof, other_proof }, failed_proofs), false);
+    EXPECT_EQ(failed_proofs, std::vector<size_t>({ 1, 3 }));
+
+    // malformed proofs are reported by index rather than throwing out of the batch
+    waffle::plonk_proof truncated_proof = proof;
+    truncated_proof.proof_data.resize(truncated_proof.proof_data.size() - 1);
+    waffle::plonk_proof empty_proof = {};
+
+    EXPECT_EQ(verifier.verify_proofs({ truncated_proof, proof, empty_proof }, failed_proofs), false);
+    EXPECT_EQ(failed_proofs, std::vector<size_t>({ 0, 2 }));
+}
@@ -43,7 +43,9 @@ class ProverPermutationWidget : public ProverRandomWidget {
                                    std::unique_ptr<work_queue>& queue) override;
 
     barretenberg::fr compute_quotient_contribution(const barretenberg::fr& alpha_base,
-                                                   const transcript::StandardTranscript& transcript) override;
+                                                   const transcript::StandardTranscript& transcript,
+                                                   const size_t start,
+                                                   const size_t end) override;
     barretenberg::fr compute_linear_contribution(const barretenberg::fr& alpha_base,
                                                  const transcript::StandardTranscript& transcript,
                                                  barretenberg::polynomial& r) override;
@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <common/mem.hpp>
 #include <ecc/curves/bn254/scalar_multiplication/scalar_multiplication.hpp>
 #include <plonk/proof_system/proving_key/proving_key.hpp>
@@ -60,35 +61,10 @@ void ProverPermutationWidget<program_width, idpolys, num_roots_cut_out_of_vanish
     polynomial& z = witness->wires.at("z");
     polynomial& z_fft = key->wire_ffts.at("z_fft");
 
-    fr* accumulators[(program_width == 1) ? 3 : program_width * 2];
-    accumulators[0] = &z[1];
-    accumulators[1] = &z_fft[0];
-    accumulators[2] = &z_fft[n];
-
-    if constexpr (program_width * 2 > 2) { // program_width >= 2
-        accumulators[3] = &z_fft[n + n];
-    }
-    if constexpr (program_width > 2) { // program_width >= 3
-        accumulators[4] = &z_fft[n + n + n];
-        accumulators[5] = &key->opening_poly[0];
-    }
-    if constexpr (program_width > 3) { // program_width >= 4
-        accumulators[6] = &key->shifted_opening_poly[0];
-        accumulators[7] = &key->quotient_polynomial_parts[0][0];
-    }
-    if constexpr (program_width > 4) { // program_width >= 5
-        accumulators[8] = &key->linear_poly[0];
-        accumulators[9] = &key->quotient_polynomial_parts[1][0];
-    }
-    if constexpr (program_width > 5) { // program_width >= 6
-        accumulators[10] = &key->quotient_polynomial_parts[2][0];
-        accumulators[11] = &key->quotient_polynomial_parts[3][0];
-    }
-    for (size_t k = 7; k < program_width; ++k) { // program_width >= 7
-        // we're out of temporary memory!
-        accumulators[(k - 1) * 2] = static_cast<fr*>(aligned_alloc(64, sizeof(fr) * n));
-        accumulators[(k - 1) * 2 + 1] = static_cast<fr*>(aligned_alloc(64, sizeof(fr) * n));
-    }
+    // z_fft is not needed until the wire ffts are computed, so we borrow its memory for the grand product
+    fr* numerators = &z[1];
+    fr* denominators = &z_fft[0];
+    fr* scratch = &z_fft[n];
 
     barretenberg::fr beta = fr::serialize_from_buffer(transcript.get_challenge("beta").begin());
     barretenberg::fr gamma = fr::serialize_from_buffer(transcript.get_challenge("beta", 1).begin());
@@ -107,154 +83,80 @@ void ProverPermutationWidget<program_width, idpolys, num_roots_cut_out_of_vanish
             lagrange_base_ids[i] = &key->permutation_selectors_lagrange_base.at("id_" + std::to_string(i + 1))[0];
     }
 
+    // step 1: compute the individual terms in the permutation poylnomial.
+    //
+    // Consider the case in which we use identity permutation polynomials and let program width = 3.
+    // (extending it to the case when the permutation polynomials is not identity is trivial).
+    //
+    // coefficient of L_1: 1
+    // coefficient of L_2:
+    //                (w_1 + \gamma + \beta.w^{0}) . (w_{n+1} + \gamma + \beta.k_1.w^{0}) . (w_{2n+1} + \gamma +
+    //                \beta.k_2.w^{0})
+    //  coeff_of_L1 *
+    //  ----------------------------------------------------------------------------------------------------------------
+    //                (w_1 + \gamma + \beta.\sigma(1)) . (w_{n+1} + \gamma + \beta.\sigma(n+1)) . (w_{2n+1} + \gamma
+    //                + \beta.\sigma(2n+1))
+    // coefficient of L_3:
+    //                (w_2 + \gamma + \beta.w^{1}) . (w_{n+2} + \gamma + \beta.k_1.w^{1}) . (w_{2n+2} + \gamma +
+    //                \beta.k_2.w^{1})
+    //  coeff_of_L2 *
+    //  ----------------------------------------------------------------------------------------------------------------
+    //                (w_2 + \gamma + \beta.\sigma(2)) . (w_{n+2} + \gamma + \beta.\sigma(n+2)) . (w_{2n+2} + \gamma
+    //                + \beta.\sigma(2n+2))
+    // and so on...
+    //
+    // numerators[i] is the product over the wires of the (w + \gamma + \beta.k.w^{i}) terms of row i, and
+    // denominators[i] the product of the (w + \gamma + \beta.\sigma) terms.
 #ifndef NO_MULTITHREADING
-#pragma omp parallel
-#endif
-    {
-        // step 1: compute the individual terms in the permutation poylnomial.
-        //
-        // Consider the case in which we use identity permutation polynomials and let program width = 3.
-        // (extending it to the case when the permutation polynomials is not identity is trivial).
-        //
-        // coefficient of L_1: 1
-        // coefficient of L_2:
-        //                (w_1 + \gamma + \beta.w^{0}) . (w_{n+1} + \gamma + \beta.k_1.w^{0}) . (w_{2n+1} + \gamma +
-        //                \beta.k_2.w^{0})
-        //  coeff_of_L1 *
-        //  --------------------------------------------------------------------------------------------------------------------
-        //                (w_1 + \gamma + \beta.\sigma(1)) . (w_{n+1} + \gamma + \beta.\sigma(n+1)) . (w_{2n+1} + \gamma
-        //                + \beta.\sigma(2n+1))
-        // coefficient of L_3:
-        //                (w_2 + \gamma + \beta.w^{1}) . (w_{n+2} + \gamma + \beta.k_1.w^{1}) . (w_{2n+2} + \gamma +
-        //                \beta.k_2.w^{1})
-        //  coeff_of_L2 *
-        //  --------------------------------------------------------------------------------------------------------------------
-        //                (w_2 + \gamma + \beta.\sigma(2)) . (w_{n+2} + \gamma + \beta.\sigma(n+2)) . (w_{2n+2} + \gamma
-        //                + \beta.\sigma(2n+2))
-        // and so on...
-        //
-        // accumulator data structure
-        // numerators in accumulator[0: program_width-1], denominators in accumulator[program_width:]
-        //      0                                         1                                               (n-1)
-        // 0 -> (w_1 + \gamma + \beta.w^{0}),             (w_2 + \gamma + \beta.w^{1}),             ...., (w_n + \gamma
-        // + \beta.w^{n-1}) 1 -> (w_{n+1} + \gamma + \beta.k_1.w^{0}),     (w_{n+1} + \gamma + \beta.k_1.w^{2}), ....,
-        // (w_{n+1} + \gamma + \beta.k_1.w^{n-1}) 2 -> (w_{2n+1} + \gamma + \beta.k_2.w^{0}),    (w_{2n+1} + \gamma +
-        // \beta.k_2.w^{0}),    ...., (w_{2n+1} + \gamma + \beta.k_2.w^{n-1})
-        //
-        // 3 -> (w_1 + \gamma + \beta.\sigma(1)),         (w_2 + \gamma + \beta.\sigma(2)),         ...., (w_n + \gamma
-        // + \beta.\sigma(n)) 4 -> (w_{n+1} + \gamma + \beta.\sigma(n+1)),   (w_{n+1} + \gamma + \beta.\sigma{n+2}),
-        // ...., (w_{n+1} + \gamma + \beta.\sigma{n+n}) 5 -> (w_{2n+1} + \gamma + \beta.\sigma(2n+1)), (w_{2n+1} +
-        // \gamma + \beta.\sigma(2n+2)), ...., (w_{2n+1} + \gamma + \beta.\sigma(2n+n))
-        //
-        // Thus, to obtain coefficient_of_L2, we need to use accumulators[:][0].
-        // To obtain coefficient_of_L3, we need to use accumulator[:][0] and accumulator[:][1]
-        // and so on upto coefficient_of_Ln.
-#ifndef NO_MULTITHREADING
-#pragma omp for
+#pragma omp parallel for
 #endif
-        for (size_t j = 0; j < key->small_domain.num_threads; ++j) {
-            barretenberg::fr thread_root =
-                key->small_domain.root.pow(static_cast<uint64_t>(j * key->small_domain.thread_size));
-            [[maybe_unused]] barretenberg::fr cur_root_times_beta = thread_root * beta;
-            barretenberg::fr T0;
-            barretenberg::fr wire_plus_gamma;
-            size_t start = j * key->small_domain.thread_size;
-            size_t end = (j + 1) * key->small_domain.thread_size;
-            for (size_t i = start; i < end; ++i) {
-                wire_plus_gamma = gamma + lagrange_base_wires[0][i];
-                if constexpr (!idpolys) {
-                    accumulators[0][i] = wire_plus_gamma + cur_root_times_beta;
-                }
-                if constexpr (idpolys) {
-                    T0 = lagrange_base_ids[0][i] * beta;
-                    accumulators[0][i] = T0 + wire_plus_gamma;
-                }
-
-                T0 = lagrange_base_sigmas[0][i] * beta;
-                accumulators[program_width][i] = T0 + wire_plus_gamma;
-
-                for (size_t k = 1; k < program_width; ++k) {
-                    wire_plus_gamma = gamma + lagrange_base_wires[k][i];
-                    if constexpr (idpolys) {
-                        T0 = lagrange_base_ids[k][i] * beta;
-                    } else {
-                        T0 = fr::coset_generator(k - 1) * cur_root_times_beta;
-                    }
-                    accumulators[k][i] = T0 + wire_plus_gamma;
-
-                    T0 = lagrange_base_sigmas[k][i] * beta;
-                    accumulators[k + program_width][i] = T0 + wire_plus_gamma;
-                }
-                if constexpr (!idpolys)
-                    cur_root_times_beta *= key->small_domain.root;
+    for (size_t j = 0; j < key->small_domain.num_threads; ++j) {
+        barretenberg::fr thread_root =
+            key->small_domain.root.pow(static_cast<uint64_t>(j * key->small_domain.thread_size));
+        [[maybe_unused]] barretenberg::fr cur_root_times_beta = thread_root * beta;
+        barretenberg::fr T0;
+        barretenberg::fr wire_plus_gamma;
+        size_t start = j * key->small_domain.thread_size;
+        size_t end = (j + 1) * key->small_domain.thread_size;
+        for (size_t i = start; i < end; ++i) {
+            wire_plus_gamma = gamma + lagrange_base_wires[0][i];
+            if constexpr (!idpolys) {
+                numerators[i] = wire_plus_gamma + cur_root_times_beta;
             }
-        }
-
-        // step 2: compute the constituent components of Z(X). This is a small multithreading bottleneck, as we have
-        // program_width * 2 non-parallelizable processes
-        //
-        // update the accumulator matrix a[:][:] to:
-        //      0          1                    2                         3
-        // 0 -> (a[0][0]), (a[0][1] * a[0][0]), (a[0][2] * a[0][1]), ..., (a[0][n-1] * a[0][n-2])
-        // 1 -> (a[1][0]), (a[1][1] * a[1][0]), (a[1][2] * a[1][1]), ..., (a[1][n-1] * a[1][n-2])
-        //
-        // and so on...
-#ifndef NO_MULTITHREADING
-#pragma omp for
-#endif
-        for (size_t i = 0; i < program_width * 2; ++i) {
-            fr* coeffs = &accumulators[i][0]; // start from the beginning of a row
-            for (size_t j = 0; j < key->small_domain.size - 1; ++j) {
-                coeffs[j + 1] *= coeffs[j]; // iteratively update elements in subsequent columns
+            if constexpr (idpolys) {
+                T0 = lagrange_base_ids[0][i] * beta;
+                numerators[i] = T0 + wire_plus_gamma;
             }
-        }
 
-        // step 3: concatenate together the accumulator elements into Z(X)
-        //
-        // update the accumulator rows a[0] and a[program_width] to:
-        //       0                                     1                                           (n-1)
-        // 0 ->  (a[0][0] * a[1][0] * a[2][0]),        (a[0][1] * a[1][1] * a[2][1]),        ...., (a[0][n-1] *
-        // a[1][n-1] * a[2][n-1]) pw -> (a[pw][0] * a[pw+1][0] * a[pw+2][0]), (a[pw][1] * a[pw+1][1] * a[pw+2][1]),
-        // ...., (a[pw][n-1] * a[pw+1][n-1] * a[pw+2][n-1])
-        //
-        // note that pw = program_width
-        // Hereafter, we can compute
-        // coefficient_Lj = a[0][j]/a[pw][j]
-        //
-        // Naive way of computing these coefficients would result in n inversions, which is pretty expensive.
-        // Instead we use Montgomery's trick for batch inversion.
-        // Montgomery's trick documentation:
-        // ./src/aztec/ecc/curves/bn254/scalar_multiplication/scalar_multiplication.hpp/L286
-#ifndef NO_MULTITHREADING
-#pragma omp for
-#endif
-        for (size_t j = 0; j < key->small_domain.num_threads; ++j) {
-            const size_t start = j * key->small_domain.thread_size;
-            const size_t end =
-                ((j + 1) * key->small_domain.thread_size) - ((j == key->small_domain.num_threads - 1) ? 1 : 0);
-            barretenberg::fr inversion_accumulator = fr::one();
-            constexpr size_t inversion_index = (program_width == 1) ? 2 : program_width * 2 - 1;
-            fr* inversion_coefficients = &accumulators[inversion_index][0];
-            for (size_t i = start; i < end; ++i) {
-
-                for (size_t k = 1; k < program_width; ++k) {
-                    accumulators[0][i] *= accumulators[k][i];
-                    accumulators[program_width][i] *= accumulators[program_width + k][i];
+            T0 = lagrange_base_sigmas[0][i] * beta;
+            denominators[i] = T0 + wire_plus_gamma;
+
+            for (size_t k = 1; k < program_width; ++k) {
+                wire_plus_gamma = gamma + lagrange_base_wires[k][i];
+                if constexpr (idpolys) {
+                    T0 = lagrange_base_ids[k][i] * beta;
+                } else {
+                    T0 = fr::coset_generator(k - 1) * cur_root_times_beta;
                 }
-                inversion_coefficients[i] = accumulators[0][i] * inversion_accumulator;
-                inversion_accumulator *= accumulators[program_width][i];
-            }
-            inversion_accumulator = inversion_accumulator.invert();
-            for (size_t i = end - 1; i != start - 1; --i) {
+                numerators[i] *= T0 + wire_plus_gamma;
 
-                // N.B. accumulators[0][i] = z[i + 1]
-                // We can avoid fully reducing z[i + 1] as the inverse fft will take care of that for us
-                accumulators[0][i] = inversion_accumulator * inversion_coefficients[i];
-                inversion_accumulator *= accumulators[program_width][i];
+                T0 = lagrange_base_sigmas[k][i] * beta;
+                denominators[i] *= T0 + wire_plus_gamma;
             }
+            if constexpr (!idpolys)
+                cur_root_times_beta *= key->small_domain.root;
         }
     }
 
+    // step 2: coefficient_Lj = (numerators[0] * ... * numerators[j - 2]) / (denominators[0] * ... *
+    // denominators[j - 2]). The running products are computed as a parallel prefix product, and divided using
+    // Montgomery's trick for batch inversion, so this scales with the number of threads.
+    // Montgomery's trick documentation:
+    // ./src/aztec/ecc/curves/bn254/scalar_multiplication/scalar_multiplication.hpp/L286
+    //
+    // N.B. numerators[i] = z[i + 1]
+    barretenberg::polynomial_arithmetic::compute_grand_product(numerators, denominators, scratch, n - 1);
+
     // coefficient_L1 = 1
     z[0] = fr::one();
 
@@ -307,11 +209,6 @@ void ProverPermutationWidget<program_width, idpolys, num_roots_cut_out_of_vanish
 
     z.ifft(key->small_domain);
 
-    for (size_t k = 7; k < program_width; ++k) {
-        aligned_free(accumulators[(k - 1) * 2]);
-        aligned_free(accumulators[(k - 1) * 2 + 1]);
-    }
-
     queue->add_to_queue({
         work_queue::WorkType::SCALAR_MULTIPLICATION,
         z.get_coefficients(),
@@ -330,7 +227,10 @@ void ProverPermutationWidget<program_width, idpolys, num_roots_cut_out_of_vanish
 
 template <size_t program_width, bool idpolys, const size_t num_roots_cut_out_of_vanishing_polynomial>
 barretenberg::fr ProverPermutationWidget<program_width, idpolys, num_roots_cut_out_of_vanishing_polynomial>::
-    compute_quotient_contribution(const fr& alpha_base, const transcript::StandardTranscript& transcript)
+    compute_quotient_contribution(const fr& alpha_base,
+                                  const transcript::StandardTranscript& transcript,
+                                  const size_t start,
+                                  const size_t end)
 {
     polynomial& z_fft = key->wire_ffts.at("z_fft");
 
@@ -393,62 +293,94 @@ barretenberg::fr ProverPermutationWidget<program_width, idpolys, num_roots_cut_o
     // Step 4: Set the quotient polynomial to be equal to
     // (w_l(X) + \beta.sigma1(X) + \gamma).(w_r(X) + \beta.sigma2(X) + \gamma).(w_o(X) + \beta.sigma3(X) +
     // \gamma).Z(X).alpha
+    //
+    // The quotient is evaluated in tiles of `quotient_tile_size` points, so that every product and sum is a pointwise
+    // operation over a tile (`fr::mul_batch`, `fr::add_batch`, ...), which uses SIMD arithmetic where available.
+    // Challenges that multiply every point of a tile are broadcast into a tile of their own.
+    constexpr size_t quotient_tile_size = 64;
 #ifndef NO_MULTITHREADING
 #pragma omp parallel for
 #endif
     for (size_t j = 0; j < key->large_domain.num_threads; ++j) {
-        const size_t start = j * key->large_domain.thread_size;
-        const size_t end = (j + 1) * key->large_domain.thread_size;
+        const size_t thread_start = start + (j * (end - start)) / key->large_domain.num_threads;
+        const size_t thread_end = start + ((j + 1) * (end - start)) / key->large_domain.num_threads;
 
         // leverage multi-threading by computing quotient polynomial at points
-        // (w^{j * num_threads}, w^{j * num_threads + 1}, ..., w^{j * num_threads + num_threads})
+        // (w^{thread_start}, w^{thread_start + 1}, ..., w^{thread_end - 1})
         //
-        // curr_root = w^{j * num_threads} * g_{small} * beta
+        // curr_root = w^{thread_start} * g_{small} * beta
         // curr_root will be used in denominator
-        barretenberg::fr cur_root_times_beta =
-            key->large_domain.root.pow(static_cast<uint64_t>(j * key->large_domain.thread_size));
+        barretenberg::fr cur_root_times_beta = key->large_domain.root.pow(static_cast<uint64_t>(thread_start));
         cur_root_times_beta *= key->small_domain.generator;
         cur_root_times_beta *= beta;
 
-        barretenberg::fr wire_plus_gamma;
-        barretenberg::fr T0;
-        barretenberg::fr denominator;
-        barretenberg::fr numerator;
-        for (size_t i = start; i < end; ++i) {
-            wire_plus_gamma = gamma + wire_ffts[0][i];
+        std::array<fr, quotient_tile_size> beta_tile;
+        std::array<fr, quotient_tile_size> gamma_tile;
+        std::array<fr, quotient_tile_size> alpha_tile;
+        std::array<fr, quotient_tile_size> alpha_squared_tile;
+        beta_tile.fill(beta);
+        gamma_tile.fill(gamma);
+        alpha_tile.fill(alpha_base);
+        alpha_squared_tile.fill(alpha_squared);
+        [[maybe_unused]] std::array<fr, quotient_tile_size> roots_times_beta;
+        [[maybe_unused]] std::array<fr, quotient_tile_size> coset_generator_tile;
+
+        std::array<fr, quotient_tile_size> wire_plus_gamma;
+        std::array<fr, quotient_tile_size> T0;
+        std::array<fr, quotient_tile_size> T1;
+        std::array<fr, quotient_tile_size> numerator;
+        std::array<fr, quotient_tile_size> denominator;
+        std::array<fr, quotient_tile_size> shifted_z;
+        for (size_t tile_start = thread_start; tile_start < thread_end; tile_start += quotient_tile_size) {
+            const size_t tile_size = std::min(quotient_tile_size, thread_end - tile_start);
 
             // Numerator computation
-            if constexpr (!idpolys)
+            fr::add_batch(&gamma_tile[0], &wire_ffts[0][tile_start], &wire_plus_gamma[0], tile_size);
+            if constexpr (!idpolys) {
                 // identity polynomial used as a monomial: S_{id1} = x, S_{id2} = k_1.x, S_{id3} = k_2.x
                 // start with (w_l(X) + \beta.X + \gamma)
-                numerator = cur_root_times_beta + wire_plus_gamma;
-            else
-                numerator = id_ffts[0][i] * beta + wire_plus_gamma;
+                for (size_t i = 0; i < tile_size; ++i) {
+                    roots_times_beta[i] = cur_root_times_beta;
+                    // Update our working root of unity
+                    cur_root_times_beta *= key->large_domain.root;
+                }
+                fr::add_batch(&roots_times_beta[0], &wire_plus_gamma[0], &numerator[0], tile_size);
+            } else {
+                fr::mul_batch(&id_ffts[0][tile_start], &beta_tile[0], &numerator[0], tile_size);
+                fr::add_batch(&numerator[0], &wire_plus_gamma[0], &numerator[0], tile_size);
+            }
 
             // Denominator computation
             // start with (w_l(X) + \beta.\sigma1(X) + \gamma)
-            denominator = sigma_ffts[0][i] * beta;
-            denominator += wire_plus_gamma;
+            fr::mul_batch(&sigma_ffts[0][tile_start], &beta_tile[0], &denominator[0], tile_size);
+            fr::add_batch(&denominator[0], &wire_plus_gamma[0], &denominator[0], tile_size);
 
             for (size_t k = 1; k < program_width; ++k) {
-                wire_plus_gamma = gamma + wire_ffts[k][i];
-                if constexpr (!idpolys)
+                fr::add_batch(&gamma_tile[0], &wire_ffts[k][tile_start], &wire_plus_gamma[0], tile_size);
+                if constexpr (!idpolys) {
                     // (w_r(X) + \beta.(k_{k}.X) + \gamma)
-                    T0 = fr::coset_generator(k - 1) * cur_root_times_beta;
-                if constexpr (idpolys)
-                    T0 = id_ffts[k][i] * beta;
-
-                T0 += wire_plus_gamma;
-                numerator *= T0;
+                    coset_generator_tile.fill(fr::coset_generator(k - 1));
+                    fr::mul_batch(&coset_generator_tile[0], &roots_times_beta[0], &T0[0], tile_size);
+                } else {
+                    fr::mul_batch(&id_ffts[k][tile_start], &beta_tile[0], &T0[0], tile_size);
+                }
+                fr::add_batch(&T0[0], &wire_plus_gamma[0], &T0[0], tile_size);
+                fr::mul_batch(&numerator[0], &T0[0], &numerator[0], tile_size);
 
                 // (w_r(X) + \beta.\sigma_{k}(X) + \gamma)
-                T0 = sigma_ffts[k][i] * beta;
-                T0 += wire_plus_gamma;
-                denominator *= T0;
+                fr::mul_batch(&sigma_ffts[k][tile_start], &beta_tile[0], &T0[0], tile_size);
+                fr::add_batch(&T0[0], &wire_plus_gamma[0], &T0[0], tile_size);
+                fr::mul_batch(&denominator[0], &T0[0], &denominator[0], tile_size);
             }
 
-            numerator *= z_fft[i];
-            denominator *= z_fft[(i + 4) & block_mask];
+            // z_fft already contains evaluations of Z(X).(\alpha^2)
+            // at the (4n)'th roots of unity
+            // => to get Z(X.w) instead of Z(X), index element (i+4) instead of i
+            for (size_t i = 0; i < tile_size; ++i) {
+                shifted_z[i] = z_fft[(tile_start + i + 4) & block_mask];
+            }
+            fr::mul_batch(&numerator[0], &z_fft[tile_start], &numerator[0], tile_size);
+            fr::mul_batch(&denominator[0], &shifted_z[0], &denominator[0], tile_size);
 
             /**
              * Permutation bounds check
@@ -483,12 +415,6 @@ barretenberg::fr ProverPermutationWidget<program_width, idpolys, num_roots_cut_o
             // => add linearly independent term (Z(X.w) - 1).(\alpha^3).L{n-1}(X) into the quotient polynomial to check
             // this
 
-            // z_fft already contains evaluations of Z(X).(\alpha^2)
-            // at the (4n)'th roots of unity
-            // => to get Z(X.w) instead of Z(X), index element (i+4) instead of i
-            T0 = z_fft[(i + 4) & block_mask] - public_input_delta; // T0 = (Z(X.w) - (delta)).(\alpha^2)
-            T0 *= alpha_base;                                      // T0 = (Z(X.w) - (delta)).(\alpha^3)
-
             // T0 = (Z(X.w) - delta).(\alpha^3).L_{end}
             // where L_{end} = L{n - num_roots_cut_out_of_vanishing_polynomial}.
             //
@@ -498,24 +424,32 @@ barretenberg::fr ProverPermutationWidget<program_width, idpolys, num_roots_cut_o
             // the factor of 4 is because l_1 is a 4n-size fft.
             //
             // Recall, we use l_start for l_1 for consistency in notation.
-            T0 *= l_start[(i + 4 + 4 * num_roots_cut_out_of_vanishing_polynomial) & block_mask];
-            numerator += T0;
+            for (size_t i = 0; i < tile_size; ++i) {
+                T0[i] = shifted_z[i] - public_input_delta; // T0 = (Z(X.w) - (delta)).(\alpha^2)
+                T1[i] = l_start[(tile_start + i + 4 + 4 * num_roots_cut_out_of_vanishing_polynomial) & block_mask];
+            }
+            fr::mul_batch(&T0[0], &alpha_tile[0], &T0[0], tile_size); // T0 = (Z(X.w) - (delta)).(\alpha^3)
+            fr::mul_batch(&T0[0], &T1[0], &T0[0], tile_size);
+            fr::add_batch(&numerator[0], &T0[0], &numerator[0], tile_size);
 
             // Step 2: Compute (Z(X) - 1).(\alpha^4).L1(X)
             // We need to verify that Z(X) equals `1` when evaluated at the first element of our subgroup H
             // i.e. Z(X) starts at 1 and ends at 1
             // The `alpha^4` term is so that we can add this as a linearly independent term in our quotient polynomial
-            T0 = z_fft[i] - fr(1); // T0 = (Z(X) - 1).(\alpha^2)
-            T0 *= alpha_squared;   // T0 = (Z(X) - 1).(\alpha^4)
-            T0 *= l_start[i];      // T0 = (Z(X) - 1).(\alpha^2).L1(X)
-            numerator += T0;
+            for (size_t i = 0; i < tile_size; ++i) {
+                T0[i] = z_fft[tile_start + i] - fr(1); // T0 = (Z(X) - 1).(\alpha^2)
+            }
+            fr::mul_batch(&T0[0], &alpha_squared_tile[0], &T0[0], tile_size); // T0 = (Z(X) - 1).(\alpha^4)
+            fr::mul_batch(&T0[0], &l_start[tile_start], &T0[0], tile_size);   // T0 = (Z(X) - 1).(\alpha^2).L1(X)
+            fr::add_batch(&numerator[0], &T0[0], &numerator[0], tile_size);
 
             // Combine into quotient polynomial
-            T0 = numerator - denominator;
-            key->quotient_polynomial_parts[i >> key->small_domain.log2_size][i & (key->n - 1)] = T0 * alpha_base;
-
-            // Update our working root of unity
-            cur_root_times_beta *= key->large_domain.root;
+            fr::sub_batch(&numerator[0], &denominator[0], &T0[0], tile_size);
+            fr::mul_batch(&T0[0], &alpha_tile[0], &T0[0], tile_size);
+            for (size_t i = 0; i < tile_size; ++i) {
+                const size_t index = tile_start + i;
+                key->quotient_polynomial_parts[index >> key->small_domain.log2_size][index & (key->n - 1)] = T0[i];
+            }
         }
     }
     return alpha_base.sqr().sqr();
@@ -45,7 +45,9 @@ class ProverPlookupWidget : public ProverRandomWidget {
                                           std::unique_ptr<work_queue>& queue) override;
 
     inline barretenberg::fr compute_quotient_contribution(const barretenberg::fr& alpha_base,
-                                                          const transcript::StandardTranscript& transcript) override;
+                                                          const transcript::StandardTranscript& transcript,
+                                                          const size_t start,
+                                                          const size_t end) override;
     inline barretenberg::fr compute_linear_contribution(const barretenberg::fr& alpha_base,
                                                         const transcript::StandardTranscript& transcript,
                                                         barretenberg::polynomial& r) override;
@@ -94,11 +94,10 @@ void ProverPlookupWidget<num_roots_cut_out_of_vanishing_polynomial>::compute_gra
     polynomial& s = witness->wires.at("s_lagrange_base");
     polynomial& z_fft = key->wire_ffts.at("z_lookup_fft");
 
-    fr* accumulators[4];
-    accumulators[0] = &z[1];
-    accumulators[1] = &z_fft[0];
-    accumulators[2] = &z_fft[n];
-    accumulators[3] = &z_fft[n + n];
+    // z_fft is not needed until z is transformed, so we borrow its memory for the grand product
+    fr* numerators = &z[1];
+    fr* denominators = &z_fft[0];
+    fr* scratch = &z_fft[n];
 
     fr* column_1_step_size = &key->constraint_selectors_lagrange_base.at("q_2")[0];
     fr* column_2_step_size = &key->constraint_selectors_lagrange_base.at("q_m")[0];
@@ -130,100 +129,56 @@ void ProverPlookupWidget<num_roots_cut_out_of_vanishing_polynomial>::compute_gra
     const fr beta_constant = beta + fr(1);
 
 #ifndef NO_MULTITHREADING
-#pragma omp parallel
-#endif
-    {
-#ifndef NO_MULTITHREADING
-#pragma omp for
+#pragma omp parallel for
 #endif
-        for (size_t j = 0; j < key->small_domain.num_threads; ++j) {
-            fr T0;
-            fr T1;
-            fr T2;
-            fr T3;
-            size_t start = j * key->small_domain.thread_size;
-            size_t end = (j + 1) * key->small_domain.thread_size;
-            // fr accumulating_beta = beta_constant.pow(start + 1);
-            const size_t block_mask = key->small_domain.size - 1;
-
-            fr next_table = lagrange_base_tables[0][start] + lagrange_base_tables[1][start] * eta +
-                            lagrange_base_tables[2][start] * eta_sqr + lagrange_base_tables[3][start] * eta_cube;
-            for (size_t i = start; i < end; ++i) {
-                T0 = lookup_index_selector[i];
-                T0 *= eta;
-                T0 += lagrange_base_wires[2][(i + 1) & block_mask] * column_3_step_size[i];
-                T0 += lagrange_base_wires[2][i];
-                T0 *= eta;
-                T0 += lagrange_base_wires[1][(i + 1) & block_mask] * column_2_step_size[i];
-                T0 += lagrange_base_wires[1][i];
-                T0 *= eta;
-                T0 += lagrange_base_wires[0][(i + 1) & block_mask] * column_1_step_size[i];
-                T0 += lagrange_base_wires[0][i];
-                T0 *= lookup_selector[i];
-
-                accumulators[0][i] = T0;
-                accumulators[0][i] += gamma;
-
-                T0 = lagrange_base_tables[3][(i + 1) & block_mask];
-                T0 *= eta;
-                T0 += lagrange_base_tables[2][(i + 1) & block_mask];
-                T0 *= eta;
-                T0 += lagrange_base_tables[1][(i + 1) & block_mask];
-                T0 *= eta;
-                T0 += lagrange_base_tables[0][(i + 1) & block_mask];
-
-                accumulators[1][i] = T0 * beta + next_table;
-                next_table = T0;
-                accumulators[1][i] += gamma_beta_constant;
-
-                accumulators[2][i] = beta_constant;
-                // accumulating_beta *= (beta_constant);
-                accumulators[3][i] = s[(i + 1) & block_mask];
-                accumulators[3][i] *= beta;
-                accumulators[3][i] += s[i];
-                accumulators[3][i] += gamma_beta_constant;
-            }
-        }
+    for (size_t j = 0; j < key->small_domain.num_threads; ++j) {
+        fr T0;
+        size_t start = j * key->small_domain.thread_size;
+        size_t end = (j + 1) * key->small_domain.thread_size;
+        const size_t block_mask = key->small_domain.size - 1;
 
-// step 2: compute the constituent components of Z(X). This is a small multithreading bottleneck, as we have
-// only 4 parallelizable processes
-#ifndef NO_MULTITHREADING
-#pragma omp for
-#endif
-        for (size_t i = 0; i < 4; ++i) {
-            fr* coeffs = &accumulators[i][0];
-            for (size_t j = 0; j < key->small_domain.size - 1; ++j) {
-                coeffs[j + 1] *= coeffs[j];
-            }
-        }
+        fr next_table = lagrange_base_tables[0][start] + lagrange_base_tables[1][start] * eta +
+                        lagrange_base_tables[2][start] * eta_sqr + lagrange_base_tables[3][start] * eta_cube;
+        for (size_t i = start; i < end; ++i) {
+            T0 = lookup_index_selector[i];
+            T0 *= eta;
+            T0 += lagrange_base_wires[2][(i + 1) & block_mask] * column_3_step_size[i];
+            T0 += lagrange_base_wires[2][i];
+            T0 *= eta;
+            T0 += lagrange_base_wires[1][(i + 1) & block_mask] * column_2_step_size[i];
+            T0 += lagrange_base_wires[1][i];
+            T0 *= eta;
+            T0 += lagrange_base_wires[0][(i + 1) & block_mask] * column_1_step_size[i];
+            T0 += lagrange_base_wires[0][i];
+            T0 *= lookup_selector[i];
 
-// step 3: concatenate together the accumulator elements into Z(X)
-#ifndef NO_MULTITHREADING
-#pragma omp for
-#endif
-        for (size_t j = 0; j < key->small_domain.num_threads; ++j) {
-            const size_t start = j * key->small_domain.thread_size;
-            const size_t end = (j == key->small_domain.num_threads - 1) ? (j + 1) * key->small_domain.thread_size - 1
-                                                                        : (j + 1) * key->small_domain.thread_size;
-            // const size_t end =
-            //     ((j + 1) * key->small_domain.thread_size) - ((j == key->small_domain.num_threads - 1) ? 1 : 0);
-            fr inversion_accumulator = fr::one();
-            for (size_t i = start; i < end; ++i) {
-                accumulators[0][i] *= accumulators[2][i];
-                accumulators[0][i] *= accumulators[1][i];
-                accumulators[0][i] *= inversion_accumulator;
-                inversion_accumulator *= accumulators[3][i];
-            }
-            inversion_accumulator = inversion_accumulator.invert();
-            for (size_t i = end - 1; i != start - 1; --i) {
-
-                // N.B. accumulators[0][i] = z[i + 1]
-                // We can avoid fully reducing z[i + 1] as the inverse fft will take care of that for us
-                accumulators[0][i] *= inversion_accumulator;
-                inversion_accumulator *= accumulators[3][i];
-            }
+            numerators[i] = T0;
+            numerators[i] += gamma;
+            numerators[i] *= beta_constant;
+
+            T0 = lagrange_base_tables[3][(i + 1) & block_mask];
+            T0 *= eta;
+            T0 += lagrange_base_tables[2][(i + 1) & block_mask];
+            T0 *= eta;
+            T0 += lagrange_base_tables[1][(i + 1) & block_mask];
+            T0 *= eta;
+            T0 += lagrange_base_tables[0][(i + 1) & block_mask];
+
+            numerators[i] *= T0 * beta + next_table + gamma_beta_constant;
+            next_table = T0;
+
+            denominators[i] = s[(i + 1) & block_mask];
+            denominators[i] *= beta;
+            denominators[i] += s[i];
+            denominators[i] += gamma_beta_constant;
         }
     }
+
+    // The running products are computed with the same parallel prefix product and batch inversion as the
+    // permutation grand product.
+    // N.B. numerators[i] = z[i + 1]
+    barretenberg::polynomial_arithmetic::compute_grand_product(numerators, denominators, scratch, n - 1);
+
     z[0] = fr::one();
 
     // Since `z_plookup` needs to be evaluated at 2 points in UltraPLONK, we need to add a degree-2 random
@@ -287,7 +242,7 @@ void ProverPlookupWidget<num_roots_cut_out_of_vanishing_polynomial>::compute_rou
 
 template <const size_t num_roots_cut_out_of_vanishing_polynomial>
 barretenberg::fr ProverPlookupWidget<num_roots_cut_out_of_vanishing_polynomial>::compute_quotient_contribution(
-    const fr& alpha_base, const transcript::StandardTranscript& transcript)
+    const fr& alpha_base, const transcript::StandardTranscript& transcript, const size_t start, const size_t end)
 {
     polynomial& z_fft = key->wire_ffts.at("z_lookup_fft");
 
@@ -352,8 +307,8 @@ barretenberg::fr ProverPlookupWidget<num_roots_cut_out_of_vanishing_polynomial>:
 #pragma omp parallel for
 #endif
     for (size_t j = 0; j < key->large_domain.num_threads; ++j) {
-        const size_t start = j * key->large_domain.thread_size;
-        const size_t end = (j + 1) * key->large_domain.thread_size;
+        const size_t thread_start = start + (j * (end - start)) / key->large_domain.num_threads;
+        const size_t thread_end = start + ((j + 1) * (end - start)) / key->large_domain.num_threads;
 
         fr T0;
         fr T1;
@@ -361,17 +316,18 @@ barretenberg::fr ProverPlookupWidget<num_roots_cut_out_of_vanishing_polynomial>:
         fr denominator;
         fr numerator;
 
+        // next_ts[i & 0x03UL] holds the table entry at row i
         std::array<fr, 4> next_ts;
-        for (size_t i = 0; i < 4; ++i) {
-            next_ts[i] = table_ffts[3][(start + i) & block_mask];
-            next_ts[i] *= eta;
-            next_ts[i] += table_ffts[2][(start + i) & block_mask];
-            next_ts[i] *= eta;
-            next_ts[i] += table_ffts[1][(start + i) & block_mask];
-            next_ts[i] *= eta;
-            next_ts[i] += table_ffts[0][(start + i) & block_mask];
+        for (size_t i = thread_start; i < thread_start + 4; ++i) {
+            next_ts[i & 0x03UL] = table_ffts[3][i & block_mask];
+            next_ts[i & 0x03UL] *= eta;
+            next_ts[i & 0x03UL] += table_ffts[2][i & block_mask];
+            next_ts[i & 0x03UL] *= eta;
+            next_ts[i & 0x03UL] += table_ffts[1][i & block_mask];
+            next_ts[i & 0x03UL] *= eta;
+            next_ts[i & 0x03UL] += table_ffts[0][i & block_mask];
         }
-        for (size_t i = start; i < end; ++i) {
+        for (size_t i = thread_start; i < thread_end; ++i) {
 
             T0 = lookup_index_fft[i];
             T0 *= eta;
@@ -53,8 +53,11 @@ class ProverRandomWidget {
 
     virtual void compute_round_commitments(transcript::StandardTranscript&, const size_t, std::unique_ptr<work_queue>&){};
 
+    // Adds the widget's identities to rows [start, end) of the quotient, evaluated over the large domain
     virtual barretenberg::fr compute_quotient_contribution(const barretenberg::fr& alpha_base,
-                                                           const transcript::StandardTranscript& transcript) = 0;
+                                                           const transcript::StandardTranscript& transcript,
+                                                           const size_t start,
+                                                           const size_t end) = 0;
     virtual barretenberg::fr compute_linear_contribution(const barretenberg::fr& alpha_base,
                                                          const transcript::StandardTranscript& transcript,
                                                          barretenberg::polynomial& r) = 0;
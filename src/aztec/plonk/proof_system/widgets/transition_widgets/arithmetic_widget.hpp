@@ -56,6 +56,40 @@ template <class Field, class Getters, typename PolyContainer> class ArithmeticKe
         return result;
     }
 
+    inline static void add_tile_contribution(PolyContainer& polynomials,
+                                             const challenge_array& challenges,
+                                             Field* tile,
+                                             const size_t start,
+                                             const size_t size)
+    {
+        const Field* w_1 = &Getters::template get_polynomial<false, PolynomialIndex::W_1>(polynomials, start);
+        const Field* w_2 = &Getters::template get_polynomial<false, PolynomialIndex::W_2>(polynomials, start);
+        const Field* w_3 = &Getters::template get_polynomial<false, PolynomialIndex::W_3>(polynomials, start);
+        const Field* q_1 = &Getters::template get_polynomial<false, PolynomialIndex::Q_1>(polynomials, start);
+        const Field* q_2 = &Getters::template get_polynomial<false, PolynomialIndex::Q_2>(polynomials, start);
+        const Field* q_3 = &Getters::template get_polynomial<false, PolynomialIndex::Q_3>(polynomials, start);
+        const Field* q_m = &Getters::template get_polynomial<false, PolynomialIndex::Q_M>(polynomials, start);
+        const Field* q_c = &Getters::template get_polynomial<false, PolynomialIndex::Q_C>(polynomials, start);
+
+        std::array<Field, MAX_KERNEL_TILE_SIZE> alpha;
+        std::array<Field, MAX_KERNEL_TILE_SIZE> T0;
+        std::array<Field, MAX_KERNEL_TILE_SIZE> T1;
+        alpha.fill(challenges.alpha_powers[0]);
+
+        // (w_1.w_2.q_m + w_1.q_1 + w_2.q_2 + w_3.q_3 + q_c).alpha
+        Field::mul_batch(w_1, w_2, &T0[0], size);
+        Field::mul_batch(&T0[0], q_m, &T0[0], size);
+        Field::mul_batch(w_1, q_1, &T1[0], size);
+        Field::add_batch(&T0[0], &T1[0], &T0[0], size);
+        Field::mul_batch(w_2, q_2, &T1[0], size);
+        Field::add_batch(&T0[0], &T1[0], &T0[0], size);
+        Field::mul_batch(w_3, q_3, &T1[0], size);
+        Field::add_batch(&T0[0], &T1[0], &T0[0], size);
+        Field::add_batch(&T0[0], q_c, &T0[0], size);
+        Field::mul_batch(&T0[0], &alpha[0], &T0[0], size);
+        Field::add_batch(tile, &T0[0], tile, size);
+    }
+
     inline static void update_kate_opening_scalars(coefficient_array& linear_terms,
                                                    std::map<std::string, Field>& scalars,
                                                    const challenge_array& challenges)
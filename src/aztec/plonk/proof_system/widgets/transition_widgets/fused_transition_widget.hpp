@@ -0,0 +1,150 @@
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include "transition_widget.hpp"
+
+namespace waffle {
+namespace widget {
+
+/**
+ * Computes the quotient contributions of a list of transition widgets in a single pass over the large domain.
+ *
+ * A TransitionWidget walks the whole coset and adds its identity into the quotient polynomial parts, so a circuit with
+ * k transition widgets streams the coset FFTs and the quotient through memory k times. The fused widget is generated
+ * from the list of kernels instead: each thread splits its rows into tiles small enough for the polynomial values of a
+ * tile to stay in cache while every kernel is evaluated over it, and the sum of the kernels' contributions is added to
+ * the quotient once per row.
+ *
+ * Each kernel gets the powers of alpha that follow those of the kernel before it, so the fused widget contributes
+ * exactly what the separate widgets would in the same order.
+ **/
+template <class Field, class Settings, template <typename, typename, typename> typename... KernelBases>
+class FusedTransitionWidget : public TransitionWidgetBase<Field> {
+  protected:
+    typedef containers::poly_ptr_array<Field> poly_ptr_array;
+    typedef containers::coefficient_array<Field> coefficient_array;
+
+    // Rows per tile. A tile of TurboPLONK rows reads about 128KB of coset FFT values, which fits in L2.
+    static constexpr size_t TILE_SIZE = 256;
+
+    template <template <typename, typename, typename> typename KernelBase> struct Stage {
+        static constexpr size_t num_independent_relations = KernelBase<int, int, int>::num_independent_relations;
+        typedef getters::FFTGetter<Field, transcript::StandardTranscript, Settings, num_independent_relations>
+            FFTGetter;
+        typedef KernelBase<Field, FFTGetter, poly_ptr_array> FFTKernel;
+        typedef containers::challenge_array<Field, num_independent_relations> challenge_array;
+
+        static challenge_array get_challenges(const transcript::StandardTranscript& transcript, Field& alpha_base)
+        {
+            challenge_array challenges =
+                FFTGetter::get_challenges(transcript, alpha_base, FFTKernel::quotient_required_challenges);
+            alpha_base = FFTGetter::update_alpha(challenges, num_independent_relations);
+            return challenges;
+        }
+
+        static void add_tile_contribution(poly_ptr_array& polynomials,
+                                          const challenge_array& challenges,
+                                          Field* tile,
+                                          const size_t tile_start,
+                                          const size_t tile_end)
+        {
+            if constexpr (requires {
+                              FFTKernel::add_tile_contribution(
+                                  polynomials, challenges, tile, tile_start, tile_end - tile_start);
+                          }) {
+                for (size_t start = tile_start; start < tile_end; start += MAX_KERNEL_TILE_SIZE) {
+                    const size_t size = std::min(MAX_KERNEL_TILE_SIZE, tile_end - start);
+                    FFTKernel::add_tile_contribution(polynomials, challenges, tile + (start - tile_start), start, size);
+                }
+                return;
+            }
+            for (size_t i = tile_start; i < tile_end; ++i) {
+                coefficient_array linear_terms;
+                FFTKernel::compute_linear_terms(polynomials, challenges, linear_terms, i);
+                Field& quotient_term = tile[i - tile_start];
+                quotient_term += FFTKernel::sum_linear_terms(polynomials, challenges, linear_terms, i);
+                FFTKernel::compute_non_linear_terms(polynomials, challenges, quotient_term, i);
+            }
+        }
+    };
+
+    typedef std::tuple<typename Stage<KernelBases>::challenge_array...> challenge_tuple;
+
+  public:
+    FusedTransitionWidget(proving_key* _key = nullptr, program_witness* _witness = nullptr)
+        : TransitionWidgetBase<Field>(_key, _witness){};
+
+    Field compute_quotient_contribution(const Field& alpha_base,
+                                        const transcript::StandardTranscript& transcript,
+                                        const size_t start,
+                                        const size_t end) override
+    {
+        auto* key = TransitionWidgetBase<Field>::key;
+
+        poly_ptr_array polynomials =
+            getters::FFTGetter<Field, transcript::StandardTranscript, Settings, 1>::get_fft_polynomials(key);
+
+        // The elements of a braced initialiser list are evaluated in order, so each kernel picks up alpha from the
+        // kernel before it.
+        Field alpha = alpha_base;
+        const challenge_tuple challenges{ Stage<KernelBases>::get_challenges(transcript, alpha)... };
+
+        const size_t num_threads = key->large_domain.num_threads;
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+        for (size_t j = 0; j < num_threads; ++j) {
+            const size_t thread_start = start + (j * (end - start)) / num_threads;
+            const size_t thread_end = start + ((j + 1) * (end - start)) / num_threads;
+            std::array<Field, TILE_SIZE> tile;
+            for (size_t tile_start = thread_start; tile_start < thread_end; tile_start += TILE_SIZE) {
+                const size_t tile_end = std::min(tile_start + TILE_SIZE, thread_end);
+                std::fill(tile.begin(), tile.end(), Field::zero());
+                add_tile_contributions(polynomials,
+                                       challenges,
+                                       &tile[0],
+                                       tile_start,
+                                       tile_end,
+                                       std::make_index_sequence<sizeof...(KernelBases)>{});
+
+                for (size_t i = tile_start; i < tile_end; ++i) {
+                    key->quotient_polynomial_parts[i >> key->small_domain.log2_size][i & (key->n - 1)] +=
+                        tile[i - tile_start];
+                }
+            }
+        }
+
+        return alpha;
+    }
+
+    Field compute_linear_contribution(const Field& alpha_base,
+                                      const transcript::StandardTranscript& transcript,
+                                      Field* linear_poly) override
+    {
+        // The linearisation polynomial is computed over the small domain once per proof, so there is nothing to fuse.
+        Field alpha = alpha_base;
+        ((alpha = TransitionWidget<Field, Settings, KernelBases>(TransitionWidgetBase<Field>::key,
+                                                                 TransitionWidgetBase<Field>::witness)
+                      .compute_linear_contribution(alpha, transcript, linear_poly)),
+         ...);
+        return alpha;
+    }
+
+  protected:
+    template <size_t... Is>
+    static void add_tile_contributions(poly_ptr_array& polynomials,
+                                       const challenge_tuple& challenges,
+                                       Field* tile,
+                                       const size_t tile_start,
+                                       const size_t tile_end,
+                                       std::index_sequence<Is...>)
+    {
+        (Stage<KernelBases>::add_tile_contribution(polynomials, std::get<Is>(challenges), tile, tile_start, tile_end),
+         ...);
+    }
+};
+
+} // namespace widget
+} // namespace waffle
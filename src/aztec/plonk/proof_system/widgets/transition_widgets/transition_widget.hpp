@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <vector>
 
@@ -32,6 +33,17 @@ enum ChallengeIndex {
 #define CHALLENGE_BIT_ETA (1 << widget::ChallengeIndex::ETA)
 #define CHALLENGE_BIT_ZETA (1 << widget::ChallengeIndex::ZETA)
 
+/**
+ * A kernel may also provide
+ *
+ *     static void add_tile_contribution(PolyContainer&, const challenge_array&, Field* tile, size_t start, size_t size)
+ *
+ * which adds its identity at the `size` (at most MAX_KERNEL_TILE_SIZE) consecutive coset points from `start` into
+ * `tile`, using the batched field arithmetic (`Field::mul_batch`, ...). The prover uses it in place of the per-point
+ * methods when it is present.
+ **/
+constexpr size_t MAX_KERNEL_TILE_SIZE = 64;
+
 namespace containers {
 template <class Field, size_t num_widget_relations> struct challenge_array {
     std::array<Field, ChallengeIndex::MAX_NUM_CHALLENGES> elements;
@@ -181,19 +193,15 @@ class FFTGetter : public BaseGetter<Field, Transcript, Settings, num_widget_rela
         poly_ptr_array result;
         result.block_mask = key->large_domain.size - 1;
         for (const auto& info : key->polynomial_manifest) {
-            const std::string label = std::string(info.polynomial_label) + "_fft";
             Field* poly = nullptr;
             switch (info.source) {
             case PolynomialSource::WITNESS: {
-                poly = &key->wire_ffts.at(label)[0];
-                break;
-            }
-            case PolynomialSource::SELECTOR: {
-                poly = &key->constraint_selector_ffts.at(label)[0];
+                poly = &key->wire_ffts.at(std::string(info.polynomial_label) + "_fft")[0];
                 break;
             }
+            case PolynomialSource::SELECTOR:
             case PolynomialSource::PERMUTATION: {
-                poly = &key->permutation_selector_ffts.at(label)[0];
+                poly = &key->get_polynomial(info, PolynomialStore::FFT)[0];
                 break;
             }
             }
@@ -230,19 +238,15 @@ class MonomialGetter : public BaseGetter<Field, Transcript, Settings, num_widget
         poly_ptr_array result;
         result.block_mask = key->small_domain.size - 1;
         for (const auto& info : key->polynomial_manifest) {
-            const std::string label(info.polynomial_label);
             Field* poly = nullptr;
             switch (info.source) {
             case PolynomialSource::WITNESS: {
-                poly = &witness->wires.at(label)[0];
-                break;
-            }
-            case PolynomialSource::SELECTOR: {
-                poly = &key->constraint_selectors.at(label)[0];
+                poly = &witness->wires.at(std::string(info.polynomial_label))[0];
                 break;
             }
+            case PolynomialSource::SELECTOR:
             case PolynomialSource::PERMUTATION: {
-                poly = &key->permutation_selectors.at(label)[0];
+                poly = &key->get_polynomial(info, PolynomialStore::MONOMIAL)[0];
                 break;
             }
             }
@@ -287,7 +291,10 @@ template <class Field> class TransitionWidgetBase {
     };
     virtual ~TransitionWidgetBase() {}
 
-    virtual Field compute_quotient_contribution(const Field&, const transcript::StandardTranscript&) = 0;
+    virtual Field compute_quotient_contribution(const Field&,
+                                                const transcript::StandardTranscript&,
+                                                const size_t,
+                                                const size_t) = 0;
     virtual Field compute_linear_contribution(const Field&, const transcript::StandardTranscript&, Field*) = 0;
 
   public:
@@ -332,7 +339,9 @@ class TransitionWidget : public TransitionWidgetBase<Field> {
     };
 
     Field compute_quotient_contribution(const Field& alpha_base,
-                                        const transcript::StandardTranscript& transcript) override
+                                        const transcript::StandardTranscript& transcript,
+                                        const size_t start,
+                                        const size_t end) override
     {
         auto* key = TransitionWidgetBase<Field>::key;
 
@@ -340,7 +349,31 @@ class TransitionWidget : public TransitionWidgetBase<Field> {
         challenge_array challenges =
             FFTGetter::get_challenges(transcript, alpha_base, FFTKernel::quotient_required_challenges);
 
-        ITERATE_OVER_DOMAIN_START(key->large_domain);
+        if constexpr (requires(Field* tile) {
+                          FFTKernel::add_tile_contribution(polynomials, challenges, tile, start, end - start);
+                      }) {
+            const size_t num_threads = key->large_domain.num_threads;
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+            for (size_t j = 0; j < num_threads; ++j) {
+                const size_t thread_start = start + (j * (end - start)) / num_threads;
+                const size_t thread_end = start + ((j + 1) * (end - start)) / num_threads;
+                std::array<Field, MAX_KERNEL_TILE_SIZE> tile;
+                for (size_t tile_start = thread_start; tile_start < thread_end; tile_start += MAX_KERNEL_TILE_SIZE) {
+                    const size_t tile_size = std::min(MAX_KERNEL_TILE_SIZE, thread_end - tile_start);
+                    std::fill(tile.begin(), tile.end(), Field::zero());
+                    FFTKernel::add_tile_contribution(polynomials, challenges, &tile[0], tile_start, tile_size);
+                    for (size_t i = tile_start; i < tile_start + tile_size; ++i) {
+                        key->quotient_polynomial_parts[i >> key->small_domain.log2_size][i & (key->n - 1)] +=
+                            tile[i - tile_start];
+                    }
+                }
+            }
+            return FFTGetter::update_alpha(challenges, FFTKernel::num_independent_relations);
+        }
+
+        ITERATE_OVER_DOMAIN_RANGE_START(key->large_domain, start, end);
         coefficient_array linear_terms;
         FFTKernel::compute_linear_terms(polynomials, challenges, linear_terms, i);
         Field sum_of_linear_terms = FFTKernel::sum_linear_terms(polynomials, challenges, linear_terms, i);
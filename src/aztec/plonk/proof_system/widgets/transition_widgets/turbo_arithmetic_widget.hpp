@@ -172,6 +172,101 @@ template <class Field, class Getters, typename PolyContainer> class TurboArithme
         return result;
     }
 
+    inline static void add_tile_contribution(PolyContainer& polynomials,
+                                             const challenge_array& challenges,
+                                             Field* tile,
+                                             const size_t start,
+                                             const size_t size)
+    {
+        constexpr barretenberg::fr minus_two(-2);
+        constexpr barretenberg::fr minus_seven(-7);
+
+        const Field* w_1 = &Getters::template get_polynomial<false, PolynomialIndex::W_1>(polynomials, start);
+        const Field* w_2 = &Getters::template get_polynomial<false, PolynomialIndex::W_2>(polynomials, start);
+        const Field* w_3 = &Getters::template get_polynomial<false, PolynomialIndex::W_3>(polynomials, start);
+        const Field* w_4 = &Getters::template get_polynomial<false, PolynomialIndex::W_4>(polynomials, start);
+        const Field* q_1 = &Getters::template get_polynomial<false, PolynomialIndex::Q_1>(polynomials, start);
+        const Field* q_2 = &Getters::template get_polynomial<false, PolynomialIndex::Q_2>(polynomials, start);
+        const Field* q_3 = &Getters::template get_polynomial<false, PolynomialIndex::Q_3>(polynomials, start);
+        const Field* q_4 = &Getters::template get_polynomial<false, PolynomialIndex::Q_4>(polynomials, start);
+        const Field* q_5 = &Getters::template get_polynomial<false, PolynomialIndex::Q_5>(polynomials, start);
+        const Field* q_m = &Getters::template get_polynomial<false, PolynomialIndex::Q_M>(polynomials, start);
+        const Field* q_c = &Getters::template get_polynomial<false, PolynomialIndex::Q_C>(polynomials, start);
+        const Field* q_arith =
+            &Getters::template get_polynomial<false, PolynomialIndex::Q_ARITHMETIC_SELECTOR>(polynomials, start);
+
+        // Challenges and constants are broadcast into tiles of their own
+        std::array<Field, MAX_KERNEL_TILE_SIZE> alpha_base;
+        std::array<Field, MAX_KERNEL_TILE_SIZE> alpha;
+        std::array<Field, MAX_KERNEL_TILE_SIZE> minus_two_tile;
+        std::array<Field, MAX_KERNEL_TILE_SIZE> minus_seven_tile;
+        alpha_base.fill(challenges.alpha_powers[0]);
+        alpha.fill(challenges.elements[ChallengeIndex::ALPHA]);
+        minus_two_tile.fill(minus_two);
+        minus_seven_tile.fill(minus_seven);
+
+        std::array<Field, MAX_KERNEL_TILE_SIZE> T0;
+        std::array<Field, MAX_KERNEL_TILE_SIZE> T1;
+        std::array<Field, MAX_KERNEL_TILE_SIZE> T2;
+        std::array<Field, MAX_KERNEL_TILE_SIZE> T3;
+        std::array<Field, MAX_KERNEL_TILE_SIZE> T4;
+
+        // T0 = q_arith.(w_1.w_2.q_m + w_1.q_1 + w_2.q_2 + w_3.q_3 + w_4.q_4 + q_c)
+        Field::mul_batch(w_1, w_2, &T0[0], size);
+        Field::mul_batch(&T0[0], q_m, &T0[0], size);
+        Field::mul_batch(w_1, q_1, &T1[0], size);
+        Field::add_batch(&T0[0], &T1[0], &T0[0], size);
+        Field::mul_batch(w_2, q_2, &T1[0], size);
+        Field::add_batch(&T0[0], &T1[0], &T0[0], size);
+        Field::mul_batch(w_3, q_3, &T1[0], size);
+        Field::add_batch(&T0[0], &T1[0], &T0[0], size);
+        Field::mul_batch(w_4, q_4, &T1[0], size);
+        Field::add_batch(&T0[0], &T1[0], &T0[0], size);
+        Field::add_batch(&T0[0], q_c, &T0[0], size);
+        Field::mul_batch(&T0[0], q_arith, &T0[0], size);
+
+        // T1 = (w_4^2 - w_4).(w_4 - 2).q_arith.alpha.q_5 imposes w_4 lies in {0, 1, 2}
+        Field::sqr_batch(w_4, &T1[0], size);
+        Field::sub_batch(&T1[0], w_4, &T1[0], size);
+        Field::add_batch(w_4, &minus_two_tile[0], &T2[0], size);
+        Field::mul_batch(&T1[0], &T2[0], &T1[0], size);
+        Field::mul_batch(&T1[0], q_arith, &T1[0], size);
+        Field::mul_batch(&T1[0], &alpha[0], &T1[0], size);
+        Field::mul_batch(&T1[0], q_5, &T1[0], size);
+        Field::add_batch(&T0[0], &T1[0], &T0[0], size);
+
+        // The quad extraction term (q_arith^2 - q_arith).(9.Δ^2 - 2.Δ^3 - 7.Δ), with Δ = w_3 - 4.w_4. See
+        // compute_non_linear_terms
+        Field::sqr_batch(q_arith, &T1[0], size);
+        Field::sub_batch(&T1[0], q_arith, &T1[0], size);
+
+        // T2 = Δ
+        Field::add_batch(w_4, w_4, &T2[0], size);
+        Field::add_batch(&T2[0], &T2[0], &T2[0], size);
+        Field::sub_batch(w_3, &T2[0], &T2[0], size);
+
+        // T4 = 9.Δ
+        Field::add_batch(&T2[0], &T2[0], &T4[0], size);
+        Field::add_batch(&T4[0], &T2[0], &T4[0], size);
+        Field::add_batch(&T4[0], &T4[0], &T3[0], size);
+        Field::add_batch(&T4[0], &T3[0], &T4[0], size);
+
+        // T3 = 2.Δ^2
+        Field::sqr_batch(&T2[0], &T3[0], size);
+        Field::add_batch(&T3[0], &T3[0], &T3[0], size);
+
+        // T4 = 9.Δ - 2.Δ^2 - 7
+        Field::sub_batch(&T4[0], &T3[0], &T4[0], size);
+        Field::add_batch(&T4[0], &minus_seven_tile[0], &T4[0], size);
+
+        Field::mul_batch(&T2[0], &T4[0], &T2[0], size);
+        Field::mul_batch(&T1[0], &T2[0], &T1[0], size);
+        Field::add_batch(&T0[0], &T1[0], &T0[0], size);
+
+        Field::mul_batch(&T0[0], &alpha_base[0], &T0[0], size);
+        Field::add_batch(tile, &T0[0], tile, size);
+    }
+
     inline static void update_kate_opening_scalars(coefficient_array& linear_terms,
                                                    std::map<std::string, Field>& scalars,
                                                    const challenge_array& challenges)
@@ -1,5 +1,7 @@
 /**
  * Create reference strings given a path to a directory of transcript files.
+ * If a point table cache directory is given, prover reference strings map their pippenger point tables from cache
+ * files in that directory (see `scalar_multiplication::Pippenger`), instead of recomputing them from the transcript.
  */
 #pragma once
 #include "reference_string.hpp"
@@ -7,6 +9,7 @@
 #include <ecc/curves/bn254/g1.hpp>
 #include <ecc/curves/bn254/g2.hpp>
 #include <ecc/curves/bn254/scalar_multiplication/pippenger.hpp>
+#include <mutex>
 
 namespace barretenberg {
 namespace pairing {
@@ -34,9 +37,11 @@ class VerifierFileReferenceString : public VerifierReferenceString {
 
 class FileReferenceString : public ProverReferenceString {
   public:
-    FileReferenceString(const size_t num_points, std::string const& path)
+    FileReferenceString(const size_t num_points,
+                        std::string const& path,
+                        std::string const& point_table_cache_dir = "")
         : n(num_points)
-        , pippenger_(path, num_points)
+        , pippenger_(path, num_points, point_table_cache_dir)
     {}
 
     g1::affine_element* get_monomials() { return pippenger_.get_point_table(); }
@@ -50,15 +55,16 @@ class FileReferenceString : public ProverReferenceString {
 
 class FileReferenceStringFactory : public ReferenceStringFactory {
   public:
-    FileReferenceStringFactory(std::string const& path)
+    FileReferenceStringFactory(std::string const& path, std::string const& point_table_cache_dir = "")
         : path_(path)
+        , point_table_cache_dir_(point_table_cache_dir)
     {}
 
     FileReferenceStringFactory(FileReferenceStringFactory&& other) = default;
 
     std::shared_ptr<ProverReferenceString> get_prover_crs(size_t degree)
     {
-        return std::make_shared<FileReferenceString>(degree, path_);
+        return std::make_shared<FileReferenceString>(degree, path_, point_table_cache_dir_);
     }
 
     std::shared_ptr<VerifierReferenceString> get_verifier_crs()
@@ -68,22 +74,35 @@ class FileReferenceStringFactory : public ReferenceStringFactory {
 
   private:
     std::string path_;
+    std::string point_table_cache_dir_;
 };
 
 class DynamicFileReferenceStringFactory : public ReferenceStringFactory {
   public:
-    DynamicFileReferenceStringFactory(std::string const& path, size_t initial_degree = 0)
+    DynamicFileReferenceStringFactory(std::string const& path,
+                                      size_t initial_degree = 0,
+                                      std::string const& point_table_cache_dir = "")
         : path_(path)
+        , point_table_cache_dir_(point_table_cache_dir)
         , degree_(initial_degree)
         , verifier_crs_(std::make_shared<VerifierFileReferenceString>(path_))
     {}
 
-    DynamicFileReferenceStringFactory(DynamicFileReferenceStringFactory&& other) = default;
+    DynamicFileReferenceStringFactory(DynamicFileReferenceStringFactory&& other)
+        : path_(std::move(other.path_))
+        , point_table_cache_dir_(std::move(other.point_table_cache_dir_))
+        , degree_(other.degree_)
+        , prover_crs_(std::move(other.prover_crs_))
+        , verifier_crs_(std::move(other.verifier_crs_))
+    {}
 
+    // Can be called from several threads: a reference string that is being used keeps its point table when a larger
+    // one replaces it.
     std::shared_ptr<ProverReferenceString> get_prover_crs(size_t degree)
     {
+        std::lock_guard<std::mutex> lock(mutex_);
         if (degree > degree_) {
-            prover_crs_ = std::make_shared<FileReferenceString>(degree, path_);
+            prover_crs_ = std::make_shared<FileReferenceString>(degree, path_, point_table_cache_dir_);
             degree_ = degree;
         }
         return prover_crs_;
@@ -93,9 +112,12 @@ class DynamicFileReferenceStringFactory : public ReferenceStringFactory {
 
   private:
     std::string path_;
+    std::string point_table_cache_dir_;
     size_t degree_;
     std::shared_ptr<FileReferenceString> prover_crs_;
     std::shared_ptr<VerifierFileReferenceString> verifier_crs_;
+    // Guards `degree_` and `prover_crs_`
+    std::mutex mutex_;
 };
 
 } // namespace waffle
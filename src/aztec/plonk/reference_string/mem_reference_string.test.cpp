@@ -1,8 +1,12 @@
 #include "file_reference_string.hpp"
 #include "mem_reference_string.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
 #include <ecc/curves/bn254/pairing.hpp>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <unistd.h>
 
 TEST(reference_string, mem_file_consistency)
 {
@@ -26,4 +30,37 @@ TEST(reference_string, mem_file_consistency)
                      file_verifier->get_precomputed_g2_lines(),
                      sizeof(barretenberg::pairing::miller_lines) * 2),
               0);
-}
\ No newline at end of file
+}
+
+TEST(reference_string, file_point_table_cache_consistency)
+{
+    const size_t num_points = 1024;
+    char cache_dir_template[] = "/tmp/point_table_cache_XXXXXX";
+    const std::string cache_dir = mkdtemp(cache_dir_template);
+    const std::string cache_path =
+        barretenberg::scalar_multiplication::get_point_table_cache_path(cache_dir, num_points);
+
+    barretenberg::scalar_multiplication::Pippenger computed("../srs_db", num_points, cache_dir);
+    EXPECT_FALSE(computed.is_mapped());
+
+    barretenberg::scalar_multiplication::Pippenger mapped("../srs_db", num_points, cache_dir);
+    EXPECT_TRUE(mapped.is_mapped());
+    EXPECT_EQ(memcmp(computed.get_point_table(),
+                     mapped.get_point_table(),
+                     num_points * 2 * sizeof(barretenberg::g1::affine_element)),
+              0);
+
+    // A cache with a corrupted header must be ignored and rewritten.
+    {
+        std::fstream cache(cache_path, std::ios::in | std::ios::out | std::ios::binary);
+        cache.seekp(offsetof(barretenberg::scalar_multiplication::point_table_cache_header, transcript_hash));
+        cache.put(0x55);
+    }
+    barretenberg::scalar_multiplication::Pippenger recomputed("../srs_db", num_points, cache_dir);
+    EXPECT_FALSE(recomputed.is_mapped());
+    barretenberg::scalar_multiplication::Pippenger remapped("../srs_db", num_points, cache_dir);
+    EXPECT_TRUE(remapped.is_mapped());
+
+    std::remove(cache_path.c_str());
+    rmdir(cache_dir.c_str());
+}
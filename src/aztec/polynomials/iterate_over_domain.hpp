@@ -38,9 +38,22 @@
 #define ITERATE_OVER_DOMAIN_END                                                                                        \
     }                                                                                                                  \
     }
+
+// Iterates over rows [range_start, range_end) of the domain, split evenly between the domain's threads
+#define ITERATE_OVER_DOMAIN_RANGE_START(domain, range_start, range_end)                                                \
+    _Pragma("omp parallel for") for (size_t j = 0; j < domain.num_threads; ++j)                                        \
+    {                                                                                                                  \
+        const size_t internal_range_size = (range_end) - (range_start);                                                \
+        const size_t internal_bound_start = (range_start) + (j * internal_range_size) / domain.num_threads;            \
+        const size_t internal_bound_end = (range_start) + ((j + 1) * internal_range_size) / domain.num_threads;        \
+        for (size_t i = internal_bound_start; i < internal_bound_end; ++i) {
+
 #else
 #define ITERATE_OVER_DOMAIN_START(domain) for (size_t i = 0; i < domain.size; ++i) {
 
+#define ITERATE_OVER_DOMAIN_RANGE_START(domain, range_start, range_end)                                                \
+    for (size_t i = (range_start); i < (range_end); ++i) {
+
 #define ITERATE_OVER_DOMAIN_END }
 #endif
 #endif
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <common/throw_or_abort.hpp>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <unistd.h>
 #ifndef __wasm__
 #include <sys/mman.h>
 #endif
@@ -39,7 +40,6 @@ polynomial::polynomial(std::string const& filename)
     max_size = size;
     int fd = open(filename.c_str(), O_RDONLY);
 #ifndef __wasm__
-    coefficients = (fr*)aligned_alloc(32, len);
     coefficients = (fr*)mmap(0, len, PROT_READ, MAP_PRIVATE, fd, 0);
 #else
     ::read(fd, (void*)coefficients, len);
@@ -47,6 +47,55 @@ polynomial::polynomial(std::string const& filename)
     close(fd);
 }
 
+polynomial::polynomial(std::string const& filename, const size_t initial_size, const size_t initial_max_size)
+    : mapped(true)
+    , representation(ROOTS_OF_UNITY)
+    , size(initial_size)
+    , page_size(DEFAULT_SIZE_HINT)
+    , max_size(std::max(initial_max_size, initial_size + DEFAULT_PAGE_SPILL))
+    , allocated_pages(0)
+{
+    const size_t len = max_size * sizeof(fr);
+#ifndef __wasm__
+    int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        throw_or_abort("Could not create: " + filename);
+    }
+    // The file starts out sparse, so the polynomial is zero and only the pages that are written to take up space
+    if (ftruncate(fd, static_cast<off_t>(len)) != 0) {
+        close(fd);
+        throw_or_abort("Could not resize: " + filename);
+    }
+    void* memory = mmap(0, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    unlink(filename.c_str());
+    if (memory == MAP_FAILED) {
+        throw_or_abort("Could not map: " + filename);
+    }
+    coefficients = static_cast<fr*>(memory);
+#else
+    mapped = false;
+    coefficients = (fr*)(aligned_alloc(32, len));
+    memset(static_cast<void*>(coefficients), 0, len);
+#endif
+}
+
+polynomial::polynomial(fr* memory, const size_t initial_size, view_tag)
+    : mapped(true)
+    , external(true)
+    , coefficients(memory)
+    , representation(ROOTS_OF_UNITY)
+    , size(initial_size)
+    , page_size(DEFAULT_SIZE_HINT)
+    , max_size(initial_size)
+    , allocated_pages(0)
+{}
+
+polynomial polynomial::view(fr* memory, const size_t num_coefficients)
+{
+    return polynomial(memory, num_coefficients, view_tag());
+}
+
 polynomial::polynomial(const size_t initial_size, const size_t initial_max_size_hint, const Representation repr)
     : mapped(false)
     , coefficients(nullptr)
@@ -102,6 +151,7 @@ polynomial& polynomial::operator=(const polynomial& other)
 
 polynomial::polynomial(polynomial&& other, const size_t target_max_size)
     : mapped(other.mapped)
+    , external(other.external)
     , coefficients(other.coefficients)
     , representation(other.representation)
     , size(other.size)
@@ -122,6 +172,7 @@ polynomial& polynomial::operator=(polynomial&& other)
     free();
 
     mapped = other.mapped;
+    external = other.external;
     coefficients = other.coefficients;
     representation = other.representation;
     page_size = other.page_size;
@@ -160,7 +211,10 @@ void polynomial::zero_memory(const size_t zero_size)
 
 void polynomial::bump_memory(const size_t new_size_hint)
 {
-    ASSERT(!mapped);
+    // The coefficients of a mapped polynomial are not ours to reallocate
+    if (mapped) {
+        throw_or_abort("Cannot grow a memory mapped polynomial");
+    }
     size_t new_size = (new_size_hint / page_size) * page_size;
 
     while (new_size < new_size_hint) {
@@ -170,16 +224,18 @@ void polynomial::bump_memory(const size_t new_size_hint)
     fr* new_memory = (fr*)(aligned_alloc(32, sizeof(fr) * new_size));
     if (coefficients != nullptr) {
         memcpy(new_memory, coefficients, sizeof(fr) * size);
-        aligned_free(coefficients);
+        if (!external) {
+            aligned_free(coefficients);
+        }
     }
     coefficients = new_memory;
+    external = false;
     allocated_pages = new_size / page_size;
     max_size = new_size;
 }
 
 void polynomial::add_coefficient_internal(const fr& coefficient)
 {
-    ASSERT(!mapped);
     if (size + 1 > max_size) {
         bump_memory((allocated_pages + 1) * page_size);
     }
@@ -201,10 +257,10 @@ void polynomial::add_coefficient(const fr& coefficient)
 
 void polynomial::free()
 {
-    if (coefficients != nullptr) {
+    if (coefficients != nullptr && !external) {
 #ifndef __wasm__
         if (mapped) {
-            munmap(coefficients, size * sizeof(fr));
+            munmap(coefficients, max_size * sizeof(fr));
         } else {
             aligned_free(coefficients);
         }
@@ -215,6 +271,38 @@ void polynomial::free()
     coefficients = nullptr;
 }
 
+void polynomial::relocate(fr* memory)
+{
+    ASSERT(!mapped);
+    if (coefficients != nullptr) {
+        memcpy(static_cast<void*>(memory), static_cast<void*>(coefficients), sizeof(fr) * max_size);
+    }
+    free();
+    coefficients = memory;
+    external = true;
+}
+
+void polynomial::release(const size_t start, const size_t end) const
+{
+#ifndef __wasm__
+    if (!mapped || start >= end) {
+        return;
+    }
+    // mmap'd memory starts on a page boundary, so rounding the range inwards to page boundaries never reaches
+    // outside of the mapping
+    const auto system_page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t page_mask = ~(system_page_size - 1);
+    const uintptr_t first = (reinterpret_cast<uintptr_t>(coefficients + start) + system_page_size - 1) & page_mask;
+    const uintptr_t last = reinterpret_cast<uintptr_t>(coefficients + std::min(end, max_size)) & page_mask;
+    if (first < last) {
+        madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+    }
+#else
+    static_cast<void>(start);
+    static_cast<void>(end);
+#endif
+}
+
 void polynomial::reserve(const size_t new_max_size)
 {
     ASSERT(!mapped);
@@ -12,6 +12,17 @@ class polynomial {
     // Creates a read only polynomial using mmap.
     polynomial(std::string const& filename);
 
+    // Creates a zeroed, writable polynomial of `initial_size` coefficients backed by a file mmap'd at `filename`. The
+    // file is unlinked once it is mapped, and so only lives as long as the polynomial. The mapping holds
+    // `initial_max_size` coefficients, and at least the same spill as the in-memory constructor, which the polynomial
+    // can grow into. Growing it any further throws.
+    polynomial(std::string const& filename, const size_t initial_size, const size_t initial_max_size = 0);
+
+    // Wraps `num_coefficients` coefficients at `memory` without copying them, e.g. a blob in a mapped proving key file.
+    // The memory is owned by the caller and must outlive the polynomial. Like the read only polynomial above, it cannot
+    // grow.
+    static polynomial view(barretenberg::fr* memory, const size_t num_coefficients);
+
     // TODO: add a 'spill' factor when allocating memory - we sometimes needs to extend poly degree by 2/4,
     // if page size = power of two, will trigger unneccesary copies
     polynomial(const size_t initial_size = 0,
@@ -64,7 +75,20 @@ class polynomial {
     void resize(const size_t new_size);
     void resize_unsafe(const size_t new_size);
 
+    // Moves the coefficients (all `max_size` of them) into `memory`, which is owned by the caller and must outlive the
+    // polynomial, or at least its next reallocation: growing the polynomial copies it back into memory of its own.
+    void relocate(barretenberg::fr* memory);
+    bool is_mapped() const { return mapped; }
+
+    // Drops the pages holding coefficients [start, end) of an mmap'd polynomial from memory. Dirty pages of a writable
+    // polynomial are written back to its file, and every page is read back in on its next access. Only pages that lie
+    // entirely within the range are dropped. Does nothing for a polynomial that is not mmap'd.
+    void release(const size_t start, const size_t end) const;
+
   private:
+    struct view_tag {};
+    polynomial(barretenberg::fr* memory, const size_t initial_size, view_tag);
+
     void free();
     void zero_memory(const size_t zero_size);
     const static size_t DEFAULT_SIZE_HINT = 1 << 12;
@@ -73,6 +97,8 @@ class polynomial {
     void bump_memory(const size_t new_size);
 
     bool mapped;
+    // Coefficients live in memory owned by someone else (see `relocate`), and are not freed with the polynomial
+    bool external = false;
     barretenberg::fr* coefficients;
     Representation representation;
     size_t size;
@@ -2,6 +2,7 @@
 #include "iterate_over_domain.hpp"
 #include <common/assert.hpp>
 #include <common/mem.hpp>
+#include <algorithm>
 #include <math.h>
 #include <memory.h>
 #include <numeric/bitop/get_msb.hpp>
@@ -13,6 +14,12 @@ namespace {
 static fr* working_memory = nullptr;
 static size_t current_size = 0;
 
+// Set by scratch_space_override. Only the pointer is per thread, the memory belongs to the caller.
+static thread_local fr* override_memory = nullptr;
+static thread_local size_t override_size = 0;
+// The override, if it owns `override_memory` and can grow it
+static thread_local scratch_space_override* override_owner = nullptr;
+
 // const auto init = []() {
 //     constexpr size_t max_num_elements = (1 << 20);
 //     working_memory = (fr*)(aligned_alloc(64, max_num_elements * 4 * sizeof(fr)));
@@ -23,6 +30,13 @@ static size_t current_size = 0;
 
 fr* get_scratch_space(const size_t num_elements)
 {
+    if (override_owner && num_elements > override_size) {
+        override_owner->grow(num_elements);
+    }
+    if (override_memory) {
+        ASSERT(num_elements <= override_size);
+        return override_memory;
+    }
     if (num_elements > current_size) {
         if (working_memory) {
             aligned_free(working_memory);
@@ -33,7 +47,52 @@ fr* get_scratch_space(const size_t num_elements)
     return working_memory;
 }
 
+// 2^14 field elements (512KB) fit comfortably in L2
+constexpr size_t FFT_BLOCK_SIZE = 1UL << 14;
+
 } // namespace
+
+scratch_space_override::scratch_space_override(fr* scratch_space, const size_t size)
+    : previous_scratch_space(override_memory)
+    , previous_size(override_size)
+    , previous_owner(override_owner)
+{
+    override_memory = scratch_space;
+    override_size = size;
+    override_owner = nullptr;
+}
+
+scratch_space_override::scratch_space_override()
+    : previous_scratch_space(override_memory)
+    , previous_size(override_size)
+    , previous_owner(override_owner)
+{
+    // Allocated by the first FFT
+    override_memory = nullptr;
+    override_size = 0;
+    override_owner = this;
+}
+
+scratch_space_override::~scratch_space_override()
+{
+    if (owned_memory) {
+        aligned_free(owned_memory);
+    }
+    override_memory = previous_scratch_space;
+    override_size = previous_size;
+    override_owner = previous_owner;
+}
+
+void scratch_space_override::grow(const size_t size)
+{
+    if (owned_memory) {
+        aligned_free(owned_memory);
+    }
+    owned_memory = (fr*)(aligned_alloc(64, size * sizeof(fr)));
+    override_memory = owned_memory;
+    override_size = size;
+}
+
 // namespace
 // {
 inline uint32_t reverse_bits(uint32_t x, uint32_t bit_length)
@@ -425,19 +484,159 @@ void fft_inner_parallel(
     }
 }
 
+/**
+ * Radix-2 FFT that works through memory in L2-sized blocks, for domains that are too large to stay in cache.
+ *
+ * `fft_inner_parallel` streams through the whole domain once per round, so for large domains every round reads and
+ * writes DRAM. Here, the bit-reversal permutation and the first log2(FFT_BLOCK_SIZE) rounds only ever combine
+ * elements within one contiguous block, so each thread takes a block and runs all of those rounds on it before moving
+ * on. The remaining rounds are run two at a time (a radix-4 pass), halving the number of passes over the domain.
+ *
+ * Polynomial coefficients are read from `coeffs`, the transform is computed in `work` (of size `domain.size`) and the
+ * last pass writes its result to `output`. `coeffs` and `output` may be split into several polynomials, like in
+ * `fft_inner_parallel`, and `output` may alias `work`.
+ **/
+void fft_inner_blocked(const std::vector<fr*>& coeffs,
+                       fr* work,
+                       const std::vector<fr*>& output,
+                       const evaluation_domain& domain,
+                       const std::vector<fr*>& root_table)
+{
+    const size_t n = domain.size;
+    ASSERT(n >= 4);
+    const size_t num_polys = coeffs.size();
+    ASSERT(is_power_of_two(num_polys) && output.size() == num_polys);
+    const size_t poly_size = n / num_polys;
+    ASSERT(is_power_of_two(poly_size));
+    const size_t poly_mask = poly_size - 1;
+    const size_t log2_poly_size = (size_t)numeric::get_msb(poly_size);
+
+    // Give every thread at least one block, and leave at least one round for the final pass over the domain
+    const size_t block_size = std::min(std::min(FFT_BLOCK_SIZE, n / domain.num_threads), n >> 1);
+    const size_t num_blocks = n / block_size;
+
+#ifndef NO_MULTITHREADING
+#pragma omp parallel
+#endif
+    {
+#ifndef NO_MULTITHREADING
+#pragma omp for
+#endif
+        for (size_t b = 0; b < num_blocks; ++b) {
+            fr* block = work + b * block_size;
+            fr temp_1;
+            fr temp_2;
+            // Bit reversal and first round, as in `fft_inner_parallel`
+            for (size_t i = 0; i < block_size; i += 2) {
+                const size_t swap_index_1 = reverse_bits((uint32_t)(b * block_size + i), (uint32_t)domain.log2_size);
+                const size_t swap_index_2 = swap_index_1 + (n >> 1);
+                fr::__copy(coeffs[swap_index_1 >> log2_poly_size][swap_index_1 & poly_mask], temp_1);
+                fr::__copy(coeffs[swap_index_2 >> log2_poly_size][swap_index_2 & poly_mask], temp_2);
+                block[i + 1] = temp_1 - temp_2;
+                block[i] = temp_1 + temp_2;
+            }
+            for (size_t m = 2; m < block_size; m <<= 1) {
+                const size_t block_mask = m - 1;
+                const size_t index_mask = ~block_mask;
+                const fr* round_roots = root_table[static_cast<size_t>(numeric::get_msb(m)) - 1];
+                for (size_t i = 0; i < (block_size >> 1); ++i) {
+                    const size_t k1 = (i & index_mask) << 1;
+                    const size_t j1 = i & block_mask;
+                    temp_1 = round_roots[j1] * block[k1 + j1 + m];
+                    block[k1 + j1 + m] = block[k1 + j1] - temp_1;
+                    block[k1 + j1] += temp_1;
+                }
+            }
+        }
+
+        // Rounds m and 2m in one pass: each group of 4m elements is the pair of butterflies of round m, followed by
+        // the pair of butterflies of round 2m that consume their outputs
+        size_t m = block_size;
+        for (; (m << 1) < n; m <<= 2) {
+            const bool last_pass = (m << 2) == n;
+            const size_t block_mask = m - 1;
+            const size_t index_mask = ~block_mask;
+            const fr* round_roots = root_table[static_cast<size_t>(numeric::get_msb(m)) - 1];
+            const fr* next_round_roots = root_table[static_cast<size_t>(numeric::get_msb(m))];
+#ifndef NO_MULTITHREADING
+#pragma omp for
+#endif
+            for (size_t i = 0; i < (n >> 2); ++i) {
+                const size_t j1 = i & block_mask;
+                const size_t i0 = ((i & index_mask) << 2) + j1;
+                const size_t i1 = i0 + m;
+                const size_t i2 = i1 + m;
+                const size_t i3 = i2 + m;
+
+                fr temp_1 = round_roots[j1] * work[i1];
+                fr temp_2 = round_roots[j1] * work[i3];
+                const fr a0 = work[i0] + temp_1;
+                const fr a1 = work[i0] - temp_1;
+                const fr a2 = work[i2] + temp_2;
+                const fr a3 = work[i2] - temp_2;
+                temp_1 = next_round_roots[j1] * a2;
+                temp_2 = next_round_roots[j1 + m] * a3;
+                if (last_pass) {
+                    output[i0 >> log2_poly_size][i0 & poly_mask] = a0 + temp_1;
+                    output[i1 >> log2_poly_size][i1 & poly_mask] = a1 + temp_2;
+                    output[i2 >> log2_poly_size][i2 & poly_mask] = a0 - temp_1;
+                    output[i3 >> log2_poly_size][i3 & poly_mask] = a1 - temp_2;
+                } else {
+                    work[i0] = a0 + temp_1;
+                    work[i1] = a1 + temp_2;
+                    work[i2] = a0 - temp_1;
+                    work[i3] = a1 - temp_2;
+                }
+            }
+        }
+
+        // An odd number of rounds is left after the blocks: the last one is a radix-2 pass
+        if (m < n) {
+            const fr* round_roots = root_table[static_cast<size_t>(numeric::get_msb(m)) - 1];
+#ifndef NO_MULTITHREADING
+#pragma omp for
+#endif
+            for (size_t i = 0; i < (n >> 1); ++i) {
+                const size_t i1 = i + m;
+                const fr temp = round_roots[i] * work[i1];
+                output[i >> log2_poly_size][i & poly_mask] = work[i] + temp;
+                output[i1 >> log2_poly_size][i1 & poly_mask] = work[i] - temp;
+            }
+        }
+    }
+}
+
+void fft_inner_blocked(std::vector<fr*> coeffs, const evaluation_domain& domain, const std::vector<fr*>& root_table)
+{
+    fr* scratch_space = get_scratch_space(domain.size);
+    fft_inner_blocked(coeffs, scratch_space, coeffs, domain, root_table);
+}
+
+void fft_inner(std::vector<fr*> coeffs,
+               const evaluation_domain& domain,
+               const fr& root,
+               const std::vector<fr*>& root_table)
+{
+    if (domain.size >= MIN_BLOCKED_FFT_SIZE) {
+        fft_inner_blocked(coeffs, domain, root_table);
+    } else {
+        fft_inner_parallel(coeffs, domain, root, root_table);
+    }
+}
+
 void fft(fr* coeffs, const evaluation_domain& domain)
 {
-    fft_inner_parallel({ coeffs }, domain, domain.root, domain.get_round_roots());
+    fft_inner({ coeffs }, domain, domain.root, domain.get_round_roots());
 }
 
 void fft(std::vector<fr*> coeffs, const evaluation_domain& domain)
 {
-    fft_inner_parallel(coeffs, domain.size, domain.root, domain.get_round_roots());
+    fft_inner(coeffs, domain, domain.root, domain.get_round_roots());
 }
 
 void ifft(fr* coeffs, const evaluation_domain& domain)
 {
-    fft_inner_parallel({ coeffs }, domain, domain.root_inverse, domain.get_inverse_round_roots());
+    fft_inner({ coeffs }, domain, domain.root_inverse, domain.get_inverse_round_roots());
     ITERATE_OVER_DOMAIN_START(domain);
     coeffs[i] *= domain.domain_inverse;
     ITERATE_OVER_DOMAIN_END;
@@ -445,7 +644,7 @@ void ifft(fr* coeffs, const evaluation_domain& domain)
 
 void ifft(std::vector<fr*> coeffs, const evaluation_domain& domain)
 {
-    fft_inner_parallel(coeffs, domain, domain.root_inverse, domain.get_inverse_round_roots());
+    fft_inner(coeffs, domain, domain.root_inverse, domain.get_inverse_round_roots());
 
     const size_t num_polys = coeffs.size();
     ASSERT(is_power_of_two(num_polys));
@@ -461,7 +660,7 @@ void ifft(std::vector<fr*> coeffs, const evaluation_domain& domain)
 
 void fft_with_constant(fr* coeffs, const evaluation_domain& domain, const fr& value)
 {
-    fft_inner_parallel({ coeffs }, domain, domain.root, domain.get_round_roots());
+    fft_inner({ coeffs }, domain, domain.root, domain.get_round_roots());
     ITERATE_OVER_DOMAIN_START(domain);
     coeffs[i] *= value;
     ITERATE_OVER_DOMAIN_END;
@@ -510,11 +709,19 @@ void coset_fft(fr* coeffs, const evaluation_domain& domain, const evaluation_dom
     }
 
     for (size_t i = 0; i < domain_extension; ++i) {
-        fft_inner_parallel(coeffs + (i * domain.size),
-                           scratch_space + (i * domain.size),
-                           domain,
-                           domain.root,
-                           domain.get_round_roots());
+        if (domain.size >= MIN_BLOCKED_FFT_SIZE) {
+            fft_inner_blocked({ coeffs + (i * domain.size) },
+                              scratch_space + (i * domain.size),
+                              { scratch_space + (i * domain.size) },
+                              domain,
+                              domain.get_round_roots());
+        } else {
+            fft_inner_parallel(coeffs + (i * domain.size),
+                               scratch_space + (i * domain.size),
+                               domain,
+                               domain.root,
+                               domain.get_round_roots());
+        }
     }
 
     if (domain_extension == 4) {
@@ -560,7 +767,7 @@ void coset_fft_with_generator_shift(fr* coeffs, const evaluation_domain& domain,
 
 void ifft_with_constant(fr* coeffs, const evaluation_domain& domain, const fr& value)
 {
-    fft_inner_parallel({ coeffs }, domain, domain.root_inverse, domain.get_inverse_round_roots());
+    fft_inner({ coeffs }, domain, domain.root_inverse, domain.get_inverse_round_roots());
     fr T0 = domain.domain_inverse * value;
     ITERATE_OVER_DOMAIN_START(domain);
     coeffs[i] *= T0;
@@ -589,25 +796,77 @@ void coset_ifft(std::vector<fr*> coeffs, const evaluation_domain& domain)
     }
 }
 
+void ifft_batch(const std::vector<fr*>& coeffs, const evaluation_domain& domain)
+{
+    if (domain.size > MAX_BATCHED_FFT_SIZE || coeffs.size() == 1) {
+        for (auto* poly : coeffs) {
+            ifft(poly, domain);
+        }
+        return;
+    }
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (size_t i = 0; i < coeffs.size(); ++i) {
+        fft_inner_serial({ coeffs[i] }, domain.size, domain.get_inverse_round_roots());
+        for (size_t j = 0; j < domain.size; ++j) {
+            coeffs[i][j] *= domain.domain_inverse;
+        }
+    }
+}
+
+void coset_fft_batch(const std::vector<fr*>& coeffs, const evaluation_domain& domain)
+{
+    if (domain.size > MAX_BATCHED_FFT_SIZE || coeffs.size() == 1) {
+        for (auto* poly : coeffs) {
+            coset_fft(poly, domain);
+        }
+        return;
+    }
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (size_t i = 0; i < coeffs.size(); ++i) {
+        fr work_generator = fr::one();
+        for (size_t j = 0; j < domain.generator_size; ++j) {
+            coeffs[i][j] *= work_generator;
+            work_generator *= domain.generator;
+        }
+        fft_inner_serial({ coeffs[i] }, domain.size, domain.get_round_roots());
+    }
+}
+
 void add(const fr* a_coeffs, const fr* b_coeffs, fr* r_coeffs, const evaluation_domain& domain)
 {
-    ITERATE_OVER_DOMAIN_START(domain);
-    r_coeffs[i] = a_coeffs[i] + b_coeffs[i];
-    ITERATE_OVER_DOMAIN_END;
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < domain.num_threads; ++j) {
+        const size_t start = j * domain.thread_size;
+        fr::add_batch(a_coeffs + start, b_coeffs + start, r_coeffs + start, domain.thread_size);
+    }
 }
 
 void sub(const fr* a_coeffs, const fr* b_coeffs, fr* r_coeffs, const evaluation_domain& domain)
 {
-    ITERATE_OVER_DOMAIN_START(domain);
-    r_coeffs[i] = a_coeffs[i] - b_coeffs[i];
-    ITERATE_OVER_DOMAIN_END;
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < domain.num_threads; ++j) {
+        const size_t start = j * domain.thread_size;
+        fr::sub_batch(a_coeffs + start, b_coeffs + start, r_coeffs + start, domain.thread_size);
+    }
 }
 
 void mul(const fr* a_coeffs, const fr* b_coeffs, fr* r_coeffs, const evaluation_domain& domain)
 {
-    ITERATE_OVER_DOMAIN_START(domain);
-    r_coeffs[i] = a_coeffs[i] * b_coeffs[i];
-    ITERATE_OVER_DOMAIN_END;
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < domain.num_threads; ++j) {
+        const size_t start = j * domain.thread_size;
+        fr::mul_batch(a_coeffs + start, b_coeffs + start, r_coeffs + start, domain.thread_size);
+    }
 }
 
 fr evaluate(const fr* coeffs, const fr& z, const size_t n)
@@ -904,6 +1163,105 @@ fr compute_kate_opening_coefficients(const fr* src, fr* dest, const fr& z, const
     return f;
 }
 
+std::vector<fr> compute_kate_opening_polynomials(const std::vector<kate_opening>& openings, const size_t n)
+{
+    // Dividing F(X) - F(z) by (X - z) is the recurrence w_i = a * (c_i - w_{i-1}) = a * c_i + b * w_{i-1}, starting from
+    // c_0 - F(z), where c_i are the coefficients of F, a = -1/z and b = 1/z. It is linear, so each thread runs it over
+    // its own range of the n + 1 coefficients from a carry in of 0, and the carry into each range is fixed up after.
+    //
+    // F(z) is not needed up front: running the recurrence over all of F from c_0 gives w_n = a * b^n * F(z), and
+    // subtracting F(z) from c_0 only adds b^{i+1} * F(z) to each w_i. Both corrections are applied in the fix up pass.
+    if (openings.empty()) {
+        return {};
+    }
+
+    // Below this many coefficients per thread, the serial carry pass is not worth it
+    constexpr size_t min_thread_size = 1UL << 10;
+    const size_t num_coefficients = n + 1;
+    const size_t num_threads =
+        std::max(std::min(max_threads::compute_num_threads(), num_coefficients / min_thread_size), 1UL);
+    const size_t num_openings = openings.size();
+
+    std::vector<fr> a(num_openings);
+    std::vector<fr> b(num_openings);
+    for (size_t k = 0; k < num_openings; ++k) {
+        b[k] = openings[k].z;
+    }
+    fr::batch_invert(&b[0], num_openings);
+    for (size_t k = 0; k < num_openings; ++k) {
+        a[k] = -b[k];
+    }
+
+    // step 1: each thread builds the linear combinations of its range and divides them from a carry in of 0. The
+    // openings are interleaved so that polynomials opened at several points are only read once.
+    std::vector<fr> range_carries(num_threads * num_openings);
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < num_threads; ++j) {
+        const size_t start = (j * num_coefficients) / num_threads;
+        const size_t end = ((j + 1) * num_coefficients) / num_threads;
+        fr* carries = &range_carries[j * num_openings];
+        for (size_t k = 0; k < num_openings; ++k) {
+            carries[k] = fr::zero();
+        }
+        for (size_t i = start; i < end; ++i) {
+            for (size_t k = 0; k < num_openings; ++k) {
+                const auto& opening = openings[k];
+                fr coefficient = opening.top_coefficient;
+                if (i < n) {
+                    coefficient = fr::zero();
+                    for (const auto& [poly, scalar] : opening.terms) {
+                        coefficient += poly[i] * scalar;
+                    }
+                }
+                carries[k] = (coefficient - carries[k]) * a[k];
+                if (i < n) {
+                    opening.dest[i] = carries[k];
+                }
+            }
+        }
+    }
+
+    // step 2: the carry into each range is the carry out of the range before it, scaled by b^{range size}. Fold in the
+    // F(z) correction, b^{start} * F(z), once F(z) is known from the carry out of the last range.
+    std::vector<fr> evaluations(num_openings);
+    for (size_t k = 0; k < num_openings; ++k) {
+        fr carry = fr::zero();
+        for (size_t j = 0; j < num_threads; ++j) {
+            const size_t start = (j * num_coefficients) / num_threads;
+            const size_t end = ((j + 1) * num_coefficients) / num_threads;
+            const fr carry_in = carry;
+            carry = range_carries[j * num_openings + k] + b[k].pow(static_cast<uint64_t>(end - start)) * carry_in;
+            range_carries[j * num_openings + k] = carry_in;
+        }
+        // F(z) = w_n / (a * b^n) = -z^{n+1} * w_n
+        evaluations[k] = -(openings[k].z.pow(static_cast<uint64_t>(num_coefficients)) * carry);
+        for (size_t j = 0; j < num_threads; ++j) {
+            const size_t start = (j * num_coefficients) / num_threads;
+            range_carries[j * num_openings + k] += b[k].pow(static_cast<uint64_t>(start)) * evaluations[k];
+        }
+    }
+
+    // step 3: w_i += b^{i - start + 1} * carry in
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < num_threads; ++j) {
+        const size_t start = (j * num_coefficients) / num_threads;
+        const size_t end = std::min(((j + 1) * num_coefficients) / num_threads, n);
+        for (size_t k = 0; k < num_openings; ++k) {
+            fr* dest = openings[k].dest;
+            fr correction = range_carries[j * num_openings + k];
+            for (size_t i = start; i < end; ++i) {
+                correction *= b[k];
+                dest[i] += correction;
+            }
+        }
+    }
+    return evaluations;
+}
+
 barretenberg::polynomial_arithmetic::lagrange_evaluations get_lagrange_evaluations(
     const fr& z, const evaluation_domain& domain, const size_t num_roots_cut_out_of_vanishing_polynomial)
 {
@@ -1013,5 +1371,56 @@ void compress_fft(const fr* src, fr* dest, const size_t cur_size, const size_t c
     }
 }
 
+void compute_grand_product(fr* numerators, fr* denominators, fr* scratch, const size_t size)
+{
+    // Below this many elements per thread, the serial carry pass and per-thread inversions are not worth it
+    constexpr size_t min_thread_size = 1UL << 10;
+    const size_t num_threads = std::max(std::min(max_threads::compute_num_threads(), size / min_thread_size), 1UL);
+
+    // step 1: each thread computes the prefix products of its own range of numerators and denominators
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < num_threads; ++j) {
+        const size_t start = (j * size) / num_threads;
+        const size_t end = ((j + 1) * size) / num_threads;
+        for (size_t i = start + 1; i < end; ++i) {
+            numerators[i] *= numerators[i - 1];
+            denominators[i] *= denominators[i - 1];
+        }
+    }
+
+    // step 2: the carry into each thread's range is the product of the ranges before it
+    std::vector<fr> numerator_carries(num_threads, fr::one());
+    std::vector<fr> denominator_carries(num_threads, fr::one());
+    for (size_t j = 1; j < num_threads; ++j) {
+        const size_t previous_end = (j * size) / num_threads;
+        numerator_carries[j] = numerator_carries[j - 1] * numerators[previous_end - 1];
+        denominator_carries[j] = denominator_carries[j - 1] * denominators[previous_end - 1];
+    }
+
+    // step 3: divide the prefix products using Montgomery's batch inversion trick. The carries only scale each
+    // quotient by (numerator carry / denominator carry), so they are folded into the one inversion per thread rather
+    // than being applied to every element.
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < num_threads; ++j) {
+        const size_t start = (j * size) / num_threads;
+        const size_t end = ((j + 1) * size) / num_threads;
+        fr inversion_accumulator = fr::one();
+        for (size_t i = start; i < end; ++i) {
+            scratch[i] = numerators[i] * inversion_accumulator;
+            inversion_accumulator *= denominators[i];
+        }
+        inversion_accumulator = (inversion_accumulator * denominator_carries[j]).invert() * numerator_carries[j];
+        for (size_t i = end - 1; i != start - 1; --i) {
+            // We can avoid fully reducing the result, as an inverse fft will take care of that for us
+            numerators[i] = inversion_accumulator * scratch[i];
+            inversion_accumulator *= denominators[i];
+        }
+    }
+}
+
 } // namespace polynomial_arithmetic
 } // namespace barretenberg
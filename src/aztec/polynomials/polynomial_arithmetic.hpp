@@ -13,6 +13,30 @@ struct lagrange_evaluations {
     fr l_end;
 };
 
+// FFTs share one scratch space, so only one may run at a time. While a `scratch_space_override` is alive, FFTs started
+// on the thread that created it use the given memory, of at least `size` elements, instead. This lets a caller that
+// owns the memory run FFTs of independent polynomials concurrently.
+// A default constructed override owns its memory instead, allocating and growing it as the FFTs on its thread need.
+// It suits a thread that runs whole proofs alongside other threads, and can't know its FFT sizes up front.
+class scratch_space_override {
+  public:
+    scratch_space_override(fr* scratch_space, const size_t size);
+    scratch_space_override();
+    ~scratch_space_override();
+
+    scratch_space_override(const scratch_space_override&) = delete;
+    scratch_space_override& operator=(const scratch_space_override&) = delete;
+
+    // Called by the FFTs of an owning override's thread that need more than its current memory.
+    void grow(const size_t size);
+
+  private:
+    fr* previous_scratch_space;
+    size_t previous_size;
+    scratch_space_override* previous_owner;
+    fr* owned_memory = nullptr;
+};
+
 fr evaluate(const fr* coeffs, const fr& z, const size_t n);
 fr evaluate(const std::vector<fr*> coeffs, const fr& z, const size_t large_n);
 void copy_polynomial(fr* src, fr* dest, size_t num_src_coefficients, size_t num_target_coefficients);
@@ -23,6 +47,17 @@ void fft_inner_parallel(std::vector<fr*> coeffs,
                         const evaluation_domain& domain,
                         const fr&,
                         const std::vector<fr*>& root_table);
+// Cache-blocked radix-2/radix-4 FFT. `fft`, `ifft` and the coset FFTs use this for domains of at least
+// `MIN_BLOCKED_FFT_SIZE` elements (32MB, which no longer fits in the last level cache), and `fft_inner_parallel`
+// below that
+constexpr size_t MIN_BLOCKED_FFT_SIZE = 1UL << 20;
+void fft_inner_blocked(std::vector<fr*> coeffs, const evaluation_domain& domain, const std::vector<fr*>& root_table);
+void scale_by_generator(fr* coeffs,
+                        fr* target,
+                        const evaluation_domain& domain,
+                        const fr& generator_start,
+                        const fr& generator_shift,
+                        const size_t generator_size);
 
 void fft(fr* coeffs, const evaluation_domain& domain);
 void fft(std::vector<fr*> coeffs, const evaluation_domain& domain);
@@ -46,6 +81,13 @@ void ifft_with_constant(fr* coeffs, const evaluation_domain& domain, const fr& v
 void coset_ifft(fr* coeffs, const evaluation_domain& domain);
 void coset_ifft(std::vector<fr*> coeffs, const evaluation_domain& domain);
 
+// Transform each of several independent polynomials over `domain`. For domains of at most `MAX_BATCHED_FFT_SIZE`
+// elements each thread transforms whole polynomials with `fft_inner_serial`, as the parallel FFT spends much of its
+// time synchronising threads at these sizes. Larger polynomials are transformed one at a time by the parallel FFT.
+constexpr size_t MAX_BATCHED_FFT_SIZE = 1UL << 16;
+void ifft_batch(const std::vector<fr*>& coeffs, const evaluation_domain& domain);
+void coset_fft_batch(const std::vector<fr*>& coeffs, const evaluation_domain& domain);
+
 void add(const fr* a_coeffs, const fr* b_coeffs, fr* r_coeffs, const evaluation_domain& domain);
 void sub(const fr* a_coeffs, const fr* b_coeffs, fr* r_coeffs, const evaluation_domain& domain);
 
@@ -71,6 +113,20 @@ void divide_by_pseudo_vanishing_polynomial(std::vector<fr*> coeffs,
 
 fr compute_kate_opening_coefficients(const fr* src, fr* dest, const fr& z, const size_t n);
 
+// A polynomial F(X) = \sum_j scalar_j * f_j(X) + top_coefficient * X^n to open at `z`, where each f_j has n coefficients.
+// Its opening polynomial W(X) = (F(X) - F(z)) / (X - z) is written to the n coefficients of `dest`, which may be one of
+// the f_j.
+struct kate_opening {
+    std::vector<std::pair<const fr*, fr>> terms;
+    fr top_coefficient;
+    fr z;
+    fr* dest;
+};
+
+// Compute the opening polynomial of each of `openings`, returning the evaluations F(z). The linear combinations are
+// built and divided in one parallel pass over the coefficients, streaming the polynomials shared between openings once.
+std::vector<fr> compute_kate_opening_polynomials(const std::vector<kate_opening>& openings, const size_t n);
+
 // compute Z_H*(z), l_start(z), l_{end}(z) (= l_{n-4}(z))
 lagrange_evaluations get_lagrange_evaluations(const fr& z,
                                               const evaluation_domain& domain,
@@ -78,5 +134,9 @@ lagrange_evaluations get_lagrange_evaluations(const fr& z,
 fr compute_barycentric_evaluation(fr* coeffs, const size_t num_coeffs, const fr& z, const evaluation_domain& domain);
 // Convert an fft with `current_size` point evaluations, to one with `current_size >> compress_factor` point evaluations
 void compress_fft(const fr* src, fr* dest, const size_t current_size, const size_t compress_factor);
+
+// Compute the grand product numerators[i] = (n_0 * ... * n_i) / (d_0 * ... * d_i) in place, as a parallel prefix
+// product with a single inversion per thread. `denominators` is overwritten and `scratch` must hold `size` elements.
+void compute_grand_product(fr* numerators, fr* denominators, fr* scratch, const size_t size);
 } // namespace polynomial_arithmetic
 } // namespace barretenberg
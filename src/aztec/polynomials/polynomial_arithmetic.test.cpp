@@ -2,6 +2,8 @@
 #include <common/mem.hpp>
 #include <gtest/gtest.h>
 #include "polynomial.hpp"
+#include <array>
+#include <thread>
 
 using namespace barretenberg;
 
@@ -148,6 +150,94 @@ TEST(polynomials, basic_fft)
     aligned_free(data);
 }
 
+TEST(polynomials, blocked_fft_consistency)
+{
+    // Sizes that leave one radix-2 pass, one radix-4 pass, and both, after the L2-sized blocks
+    for (size_t log2_n = 15; log2_n <= 17; ++log2_n) {
+        const size_t n = 1UL << log2_n;
+        polynomial expected(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            expected[i] = fr::random_element();
+        }
+        polynomial result(expected, n);
+
+        evaluation_domain domain = evaluation_domain(n);
+        domain.compute_lookup_table();
+        polynomial_arithmetic::fft_inner_parallel({ &expected[0] }, domain, domain.root, domain.get_round_roots());
+        polynomial_arithmetic::fft_inner_blocked({ &result[0] }, domain, domain.get_round_roots());
+
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ((result[i] == expected[i]), true);
+        }
+    }
+}
+
+TEST(polynomials, split_polynomial_blocked_fft_ifft_consistency)
+{
+    const size_t n = polynomial_arithmetic::MIN_BLOCKED_FFT_SIZE / 4;
+    const size_t num_poly = 4;
+    std::vector<polynomial> result;
+    std::vector<polynomial> expected;
+    std::vector<fr*> coeffs_vec;
+    for (size_t j = 0; j < num_poly; j++) {
+        expected.emplace_back(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            expected[j][i] = fr::random_element();
+        }
+        result.emplace_back(expected[j], n);
+    }
+    for (size_t j = 0; j < num_poly; j++) {
+        coeffs_vec.push_back(&result[j][0]);
+    }
+
+    evaluation_domain domain = evaluation_domain(num_poly * n);
+    domain.compute_lookup_table();
+    polynomial_arithmetic::coset_fft(coeffs_vec, domain);
+    polynomial_arithmetic::coset_ifft(coeffs_vec, domain);
+
+    for (size_t j = 0; j < num_poly; j++) {
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ((result[j][i] == expected[j][i]), true);
+        }
+    }
+}
+
+TEST(polynomials, batched_fft_consistency)
+{
+    // Batched (one polynomial per thread) and unbatched transforms agree, on either side of MAX_BATCHED_FFT_SIZE
+    for (size_t n : { 1UL << 8, polynomial_arithmetic::MAX_BATCHED_FFT_SIZE / 2 }) {
+        evaluation_domain small_domain(n);
+        evaluation_domain large_domain(4 * n, n);
+        small_domain.compute_lookup_table();
+        large_domain.compute_lookup_table();
+
+        std::vector<polynomial> expected;
+        std::vector<polynomial> result;
+        std::vector<fr*> result_coefficients;
+        for (size_t i = 0; i < 5; ++i) {
+            polynomial poly(4 * n, 4 * n);
+            for (size_t j = 0; j < n; ++j) {
+                poly[j] = fr::random_element();
+            }
+            expected.emplace_back(poly);
+            result.emplace_back(poly);
+        }
+        for (auto& poly : result) {
+            result_coefficients.push_back(&poly[0]);
+        }
+
+        polynomial_arithmetic::ifft_batch(result_coefficients, small_domain);
+        polynomial_arithmetic::coset_fft_batch(result_coefficients, large_domain);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            polynomial_arithmetic::ifft(&expected[i][0], small_domain);
+            polynomial_arithmetic::coset_fft(&expected[i][0], large_domain);
+            for (size_t j = 0; j < 4 * n; ++j) {
+                EXPECT_EQ(result[i][j], expected[i][j]);
+            }
+        }
+    }
+}
+
 TEST(polynomials, fft_ifft_consistency)
 {
     size_t n = 256;
@@ -168,6 +258,47 @@ TEST(polynomials, fft_ifft_consistency)
     }
 }
 
+TEST(polynomials, owning_scratch_space_override_runs_concurrent_ffts)
+{
+    // Each thread transforms a larger domain on every pass, so its scratch space grows while the other's is in use
+    constexpr size_t num_passes = 4;
+    const auto transform = [](const size_t thread_index, std::vector<std::vector<fr>>& results) {
+        for (size_t pass = 0; pass < num_passes; ++pass) {
+            evaluation_domain domain(1UL << (8 + 2 * pass + thread_index));
+            domain.compute_lookup_table();
+            for (size_t i = 0; i < domain.size; ++i) {
+                results[pass][i] = fr(thread_index * 1000 + pass * 100 + i);
+            }
+            polynomial_arithmetic::fft(&results[pass][0], domain);
+        }
+    };
+
+    std::array<std::vector<std::vector<fr>>, 2> concurrent;
+    std::array<std::vector<std::vector<fr>>, 2> serial;
+    for (size_t t = 0; t < 2; ++t) {
+        for (size_t pass = 0; pass < num_passes; ++pass) {
+            concurrent[t].emplace_back(1UL << (8 + 2 * pass + t));
+            serial[t].emplace_back(1UL << (8 + 2 * pass + t));
+        }
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 2; ++t) {
+        threads.emplace_back([&, t]() {
+            polynomial_arithmetic::scratch_space_override scratch_space;
+            transform(t, concurrent[t]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 0; t < 2; ++t) {
+        transform(t, serial[t]);
+    }
+
+    EXPECT_EQ(concurrent, serial);
+}
+
 TEST(polynomials, split_polynomial_fft_ifft_consistency)
 {
     size_t n = 256;
@@ -455,6 +586,58 @@ TEST(polynomials, compute_kate_opening_coefficients)
     aligned_free(multiplicand);
 }
 
+TEST(polynomials, compute_kate_opening_polynomials)
+{
+    // Not a multiple of the number of threads, and large enough to be split between several of them
+    constexpr size_t n = (1UL << 14) + 3;
+    constexpr size_t num_polynomials = 3;
+
+    std::vector<std::vector<fr>> polynomials(num_polynomials, std::vector<fr>(n));
+    for (auto& poly : polynomials) {
+        for (auto& coefficient : poly) {
+            coefficient = fr::random_element();
+        }
+    }
+    std::vector<fr> W_z(n);
+    std::vector<fr> W_z_omega(n);
+
+    // Open polynomials 0 and 1 at z, and polynomials 1 and 2 at z', so that polynomial 1 is shared.
+    std::vector<polynomial_arithmetic::kate_opening> openings(2);
+    for (size_t k = 0; k < 2; ++k) {
+        openings[k].terms = { { &polynomials[k][0], fr::random_element() },
+                              { &polynomials[k + 1][0], fr::random_element() } };
+        openings[k].top_coefficient = fr::random_element();
+        openings[k].z = fr::random_element();
+    }
+    openings[0].dest = &W_z[0];
+    openings[1].dest = &W_z_omega[0];
+
+    auto evaluations = polynomial_arithmetic::compute_kate_opening_polynomials(openings, n);
+
+    // Compare with building F(X) and dividing it serially
+    for (size_t k = 0; k < 2; ++k) {
+        const auto& opening = openings[k];
+        std::vector<fr> F(n + 1, fr::zero());
+        for (const auto& [poly, scalar] : opening.terms) {
+            for (size_t i = 0; i < n; ++i) {
+                F[i] += poly[i] * scalar;
+            }
+        }
+        F[n] = opening.top_coefficient;
+        const fr f = polynomial_arithmetic::evaluate(&F[0], opening.z, n + 1);
+        EXPECT_EQ(evaluations[k], f);
+
+        const fr divisor = -opening.z.invert();
+        fr w = fr::zero();
+        for (size_t i = 0; i < n; ++i) {
+            w = ((i == 0 ? F[0] - f : F[i]) - w) * divisor;
+            EXPECT_EQ(opening.dest[i], w);
+        }
+        // The remainder is 0
+        EXPECT_EQ(F[n] - w, fr::zero());
+    }
+}
+
 TEST(polynomials, get_lagrange_evaluations)
 {
     constexpr size_t n = 16;
@@ -598,4 +781,46 @@ TEST(polynomials, divide_by_vanishing_polynomial)
     fr Z_H_vanishing_eval = (z.pow(16) - 1);
     rhs = r_eval * Z_H_vanishing_eval;
     EXPECT_EQ((lhs == rhs), false);
-}
\ No newline at end of file
+}
+
+TEST(polynomials, compute_grand_product)
+{
+    // Not a multiple of the number of threads, and large enough to be split between several of them
+    constexpr size_t n = (1UL << 14) + 3;
+
+    std::vector<fr> numerators(n);
+    std::vector<fr> denominators(n);
+    std::vector<fr> scratch(n);
+    std::vector<fr> expected(n);
+    fr numerator_product = fr::one();
+    fr denominator_product = fr::one();
+    for (size_t i = 0; i < n; ++i) {
+        numerators[i] = fr::random_element();
+        denominators[i] = fr::random_element();
+        numerator_product *= numerators[i];
+        denominator_product *= denominators[i];
+        expected[i] = numerator_product / denominator_product;
+    }
+
+    polynomial_arithmetic::compute_grand_product(&numerators[0], &denominators[0], &scratch[0], n);
+
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(numerators[i], expected[i]);
+    }
+}
+
+TEST(polynomials, mapped_polynomial_cannot_grow_past_its_mapping)
+{
+    const std::string filename = "/tmp/mapped_polynomial";
+    polynomial poly(filename, 8);
+    EXPECT_EQ(poly.is_mapped(), true);
+
+    // A mapped polynomial has the same spill as one in memory, e.g. for the 4 coefficients appended to a coset FFT
+    const size_t spill = poly.get_max_size() - poly.get_size();
+    EXPECT_GE(spill, 4UL);
+    for (size_t i = 0; i < spill; ++i) {
+        poly.add_lagrange_base_coefficient(fr(i));
+    }
+    EXPECT_EQ(poly[8 + spill - 1], fr(spill - 1));
+    EXPECT_ANY_THROW(poly.add_lagrange_base_coefficient(fr::one()));
+}
@@ -5,6 +5,7 @@
 #include <ecc/curves/bn254/g1.hpp>
 #include <ecc/curves/bn254/g2.hpp>
 #include <ecc/curves/bn254/pairing.hpp>
+#include <ecc/curves/bn254/scalar_multiplication/fixed_size_msm.hpp>
 #include <ecc/curves/bn254/scalar_multiplication/scalar_multiplication.hpp>
 #include <ecc/groups/wnaf.hpp>
 #include <numeric/bitop/get_msb.hpp>
@@ -158,6 +159,34 @@ void unsafe_pippenger_bench(State& state) noexcept
 }
 BENCHMARK(unsafe_pippenger_bench)->RangeMultiplier(2)->Range(1 << 20, 1 << 20);
 
+// The generic wNAF path with a preallocated runtime state, against the signed-digit engine for each of our production
+// circuit sizes (which allocates its runtime state once, up front).
+void preallocated_unsafe_pippenger_bench(State& state) noexcept
+{
+    const size_t num_points = static_cast<size_t>(state.range(0));
+    scalar_multiplication::pippenger_runtime_state run_state(num_points);
+    for (auto _ : state) {
+        DoNotOptimize(scalar_multiplication::pippenger_unsafe(
+            &globals.scalars[0], &globals.monomials[0], num_points, run_state));
+    }
+}
+BENCHMARK(preallocated_unsafe_pippenger_bench)
+    ->Arg(1 << 16)
+    ->Arg(1 << 17)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+
+template <size_t num_points> void fixed_size_msm_bench(State& state) noexcept
+{
+    scalar_multiplication::fixed_size_msm<num_points> msm;
+    for (auto _ : state) {
+        DoNotOptimize(msm.pippenger_unsafe(&globals.scalars[0], &globals.monomials[0]));
+    }
+}
+BENCHMARK_TEMPLATE(fixed_size_msm_bench, 1 << 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(fixed_size_msm_bench, 1 << 17)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(fixed_size_msm_bench, 1 << 20)->Unit(benchmark::kMillisecond);
+
 void new_plonk_scalar_multiplications_bench(State& state) noexcept
 {
     uint64_t count = 0;
@@ -246,6 +275,73 @@ void fft_bench_serial(State& state) noexcept
 }
 BENCHMARK(fft_bench_serial)->RangeMultiplier(2)->Range(START * 4, MAX_GATES * 4);
 
+// `fft`, `coset_fft` and `ifft` switch from the radix-2 FFT to the cache-blocked FFT at MIN_BLOCKED_FFT_SIZE. These
+// benchmark both paths, over the same sizes as the benchmarks above.
+evaluation_domain& get_bench_domain(const State& state)
+{
+    return evaluation_domains[(size_t)numeric::get_msb((uint64_t)state.range(0)) - (size_t)numeric::get_msb(START)];
+}
+
+void fft_bench_radix_2(State& state) noexcept
+{
+    const evaluation_domain& domain = get_bench_domain(state);
+    for (auto _ : state) {
+        polynomial_arithmetic::fft_inner_parallel({ globals.data }, domain, domain.root, domain.get_round_roots());
+    }
+}
+BENCHMARK(fft_bench_radix_2)->RangeMultiplier(2)->Range(START * 4, MAX_GATES * 4);
+
+void fft_bench_blocked(State& state) noexcept
+{
+    const evaluation_domain& domain = get_bench_domain(state);
+    for (auto _ : state) {
+        polynomial_arithmetic::fft_inner_blocked({ globals.data }, domain, domain.get_round_roots());
+    }
+}
+BENCHMARK(fft_bench_blocked)->RangeMultiplier(2)->Range(START * 4, MAX_GATES * 4);
+
+void coset_fft_bench_radix_2(State& state) noexcept
+{
+    const evaluation_domain& domain = get_bench_domain(state);
+    for (auto _ : state) {
+        polynomial_arithmetic::scale_by_generator(
+            globals.data, globals.data, domain, fr::one(), domain.generator, domain.generator_size);
+        polynomial_arithmetic::fft_inner_parallel({ globals.data }, domain, domain.root, domain.get_round_roots());
+    }
+}
+BENCHMARK(coset_fft_bench_radix_2)->RangeMultiplier(2)->Range(START * 4, MAX_GATES * 4);
+
+void coset_fft_bench_blocked(State& state) noexcept
+{
+    const evaluation_domain& domain = get_bench_domain(state);
+    for (auto _ : state) {
+        polynomial_arithmetic::scale_by_generator(
+            globals.data, globals.data, domain, fr::one(), domain.generator, domain.generator_size);
+        polynomial_arithmetic::fft_inner_blocked({ globals.data }, domain, domain.get_round_roots());
+    }
+}
+BENCHMARK(coset_fft_bench_blocked)->RangeMultiplier(2)->Range(START * 4, MAX_GATES * 4);
+
+// The inverse transforms, without the (identical) scaling by 1/n
+void ifft_bench_radix_2(State& state) noexcept
+{
+    const evaluation_domain& domain = get_bench_domain(state);
+    for (auto _ : state) {
+        polynomial_arithmetic::fft_inner_parallel(
+            { globals.data }, domain, domain.root_inverse, domain.get_inverse_round_roots());
+    }
+}
+BENCHMARK(ifft_bench_radix_2)->RangeMultiplier(2)->Range(START * 4, MAX_GATES * 4);
+
+void ifft_bench_blocked(State& state) noexcept
+{
+    const evaluation_domain& domain = get_bench_domain(state);
+    for (auto _ : state) {
+        polynomial_arithmetic::fft_inner_blocked({ globals.data }, domain, domain.get_inverse_round_roots());
+    }
+}
+BENCHMARK(ifft_bench_blocked)->RangeMultiplier(2)->Range(START * 4, MAX_GATES * 4);
+
 void pairing_bench(State& state) noexcept
 {
     uint64_t count = 0;
@@ -85,8 +85,13 @@ class WorldStateDb {
     {
         std::vector<PutRequest> put_requests;
         read(is, put_requests);
+        // Group the updates by tree, preserving their order, so each tree hashes every dirty node once.
+        std::array<std::vector<std::pair<LevelDbTree::index_t, fr>>, 4> updates;
         for (auto& put_request : put_requests) {
-            trees_[put_request.tree_id]->update_element(put_request.index, put_request.value);
+            updates[put_request.tree_id].push_back({ put_request.index, put_request.value });
+        }
+        for (size_t i = 0; i < trees_.size(); ++i) {
+            trees_[i]->update_elements(updates[i]);
         }
         write_metadata(os);
     }
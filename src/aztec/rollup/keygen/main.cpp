@@ -17,7 +17,10 @@ int main(int argc, char** argv)
     std::vector<std::string> args(argv, argv + argc);
     if (args.size() < 4) {
         info(
-            "usage: ", args[0], " <num inner txs> <comma separated valid outer sizes> <output path> <mock> [srs path]");
+            "usage: ",
+            args[0],
+            " <num inner txs> <comma separated valid outer sizes> <output path> <mock> [srs path]",
+            " [point table cache path]");
         return 1;
     }
     size_t num_inner_tx = (size_t)atoi(args[1].c_str());
@@ -33,8 +36,9 @@ int main(int argc, char** argv)
     const std::string output_path = args[3];
     const bool mock_proof = (args.size() > 4) ? args[4] == "true" : false;
     const std::string srs_path = (args.size() > 5) ? args[5] : "../srs_db/ignition";
+    const std::string point_table_cache_path = (args.size() > 6) ? args[6] : "";
 
-    auto srs = std::make_shared<waffle::DynamicFileReferenceStringFactory>(srs_path);
+    auto srs = std::make_shared<waffle::DynamicFileReferenceStringFactory>(srs_path, 0, point_table_cache_path);
 
     if (!mock_proof) {
         auto account_cd = account::get_circuit_data(srs);
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <sys/stat.h>
 #include <common/timer.hpp>
+#include <plonk/proof_system/proving_key/mmap_file.hpp>
 #include <plonk/proof_system/proving_key/serialize.hpp>
 
 namespace rollup {
@@ -52,13 +53,17 @@ circuit_data get_circuit_data(std::string const& name,
     ComposerType mock_proof_composer(srs);
 
     auto circuit_key_path = key_path + "/" + path_name;
-    auto pk_path = circuit_key_path + "/proving_key/proving_key";
+    auto pk_path = circuit_key_path + "/proving_key.dat";
+    // Keys saved before the single file format, with one file per polynomial
+    auto pk_dir = circuit_key_path + "/proving_key";
+    auto legacy_pk_path = pk_dir + "/proving_key";
+    const bool pk_exists = exists(pk_path) || exists(legacy_pk_path);
     auto vk_path = circuit_key_path + "/verification_key";
     auto padding_path = circuit_key_path + "/padding_proof";
 
     // If we're missing required data, and compute is enabled, or if
     // compute is enabled and load is disabled, build the circuit.
-    if (((!exists(pk_path) || !exists(vk_path) || (!exists(padding_path) && padding)) && compute) ||
+    if (((!pk_exists || !exists(vk_path) || (!exists(padding_path) && padding)) && compute) ||
         (compute && !load)) {
         info(name, ": Building circuit...");
         Timer timer;
@@ -79,13 +84,16 @@ circuit_data get_circuit_data(std::string const& name,
     }
 
     if (pk) {
-        auto pk_dir = circuit_key_path + "/proving_key";
-        mkdir(pk_dir.c_str(), 0700);
-        if (exists(pk_path) && load) {
-            info(name, ": Loading proving key: ", pk_path);
-            auto pk_stream = std::ifstream(pk_path);
+        if (pk_exists && load) {
             waffle::proving_key_data pk_data;
-            read_mmap(pk_stream, pk_dir, pk_data);
+            if (exists(pk_path)) {
+                info(name, ": Loading proving key: ", pk_path);
+                waffle::read_mmap_file(pk_path, pk_data);
+            } else {
+                info(name, ": Loading proving key: ", legacy_pk_path);
+                auto pk_stream = std::ifstream(legacy_pk_path);
+                read_mmap(pk_stream, pk_dir, pk_data);
+            }
             if (pk_data.composer_type == 0) {
                 data.proving_key =
                     std::make_shared<waffle::proving_key>(std::move(pk_data), srs->get_prover_crs(pk_data.n + 1));
@@ -111,15 +119,20 @@ circuit_data get_circuit_data(std::string const& name,
             }
 
             info(name, ": Proving key computed in ", timer.toString(), "s");
+            const auto& timings = mock ? mock_proof_composer.key_timings : composer.key_timings;
+            info(name,
+                 ": Selectors: ",
+                 timings.selectors,
+                 "s, copy cycles: ",
+                 timings.copy_cycles,
+                 "s, sigma permutations: ",
+                 timings.sigma_permutations,
+                 "s");
 
             if (save) {
                 info(name, ": Saving proving key...");
                 Timer write_timer;
-                std::ofstream os(pk_path);
-                write_mmap(os, pk_dir, *data.proving_key);
-                if (!os.good()) {
-                    throw_or_abort(format("Failed to write: ", pk_path));
-                }
+                waffle::write_mmap_file(pk_path, *data.proving_key);
                 info(name, ": Saved in ", write_timer.toString(), "s");
             }
         }
@@ -233,6 +233,34 @@ HEAVY_TEST_F(rollup_full_tests, test_3_rollup_pads_to_4)
     }
 }
 
+HEAVY_TEST_F(rollup_full_tests, test_pipelined_rollups)
+{
+    size_t rollup_size = 1;
+
+    context.append_account_notes();
+    context.append_value_notes({ 100, 50, 100, 50 });
+    context.start_next_root_rollup();
+
+    auto join_split_proof1 = context.create_join_split_proof({ 2, 3 }, { 100, 50 }, { 70, 80 - tx_fee });
+    auto rollup1 = create_rollup_tx(context.world_state, rollup_size, { join_split_proof1 });
+    auto join_split_proof2 = context.create_join_split_proof({ 4, 5 }, { 100, 50 }, { 60, 90 - tx_fee });
+    auto rollup2 = create_rollup_tx(context.world_state, rollup_size, { join_split_proof2 });
+
+    auto rollup_circuit_data =
+        rollup::get_circuit_data(rollup_size, js_cd, account_cd, claim_cd, srs, "", true, false, false);
+    auto pipeline = create_verify_pipeline(rollup_circuit_data);
+    auto result1 = pipeline->push(rollup1);
+    auto result2 = pipeline->push(rollup2);
+
+    auto rollup_data1 = rollup_proof_data(result1.get().proof_data);
+    auto verified2 = result2.get();
+    ASSERT_TRUE(verified2.verified);
+    auto rollup_data2 = rollup_proof_data(verified2.proof_data);
+    EXPECT_EQ(rollup_data1.new_data_root, rollup1.new_data_root);
+    EXPECT_EQ(rollup_data2.old_data_root, rollup1.new_data_root);
+    EXPECT_EQ(rollup_data2.new_data_root, rollup2.new_data_root);
+}
+
 } // namespace rollup
 } // namespace proofs
 } // namespace rollup
\ No newline at end of file
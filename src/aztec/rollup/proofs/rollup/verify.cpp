@@ -42,6 +42,11 @@ verify_result<Composer> verify(rollup_tx& tx, circuit_data const& cd)
     return verify_internal(composer, tx, cd, "tx rollup", true, build_circuit);
 }
 
+std::unique_ptr<verify_pipeline> create_verify_pipeline(circuit_data const& cd)
+{
+    return std::make_unique<verify_pipeline>(cd, "tx rollup", true, build_circuit);
+}
+
 } // namespace rollup
 } // namespace proofs
 } // namespace rollup
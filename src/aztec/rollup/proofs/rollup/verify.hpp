@@ -12,6 +12,12 @@ verify_result<Composer> verify_logic(rollup_tx& tx, circuit_data const& cd);
 
 verify_result<Composer> verify(rollup_tx& tx, circuit_data const& cd);
 
+// Proves tx rollups one after another, building each one's circuit while the previous one is proved.
+using verify_pipeline =
+    ::rollup::proofs::verify_pipeline<Composer, rollup_tx, circuit_data, ::rollup::proofs::verify_result<Composer>>;
+
+std::unique_ptr<verify_pipeline> create_verify_pipeline(circuit_data const& cd);
+
 } // namespace rollup
 } // namespace proofs
 } // namespace rollup
@@ -1,5 +1,6 @@
 #pragma once
 #include "./root_rollup_tx.hpp"
+#include "../notes/circuit/defi_interaction/note.hpp"
 #include <stdlib/recursion/verifier/program_settings.hpp>
 #include <stdlib/recursion/verifier/verifier.hpp>
 #include <stdlib/types/turbo.hpp>
@@ -16,6 +17,74 @@ struct circuit_result_data {
     std::vector<fr> broadcast_data;
 };
 
+/**
+ * Builds the root rollup circuit one inner rollup proof at a time, so that each proof can be verified in-circuit as it
+ * arrives, rather than once all of them have. The circuit is the same as the one `root_rollup_circuit` builds from a
+ * tx holding all of the proofs.
+ */
+class root_rollup_circuit_builder {
+  public:
+    /**
+     * Add the root rollup's header to the circuit. `tx` holds everything but the inner rollup proofs (its `rollups` are
+     * ignored), including `num_inner_proofs`, and has been padded. The circuit takes `max_num_inner_proofs` proofs.
+     */
+    root_rollup_circuit_builder(Composer& composer,
+                                root_rollup_tx const& tx,
+                                size_t num_inner_txs_pow2,
+                                size_t num_outer_txs_pow2,
+                                size_t max_num_inner_proofs,
+                                std::shared_ptr<waffle::verification_key> const& inner_verification_key);
+
+    // Verify the next inner rollup proof, or padding proof, in the circuit.
+    void add_inner_proof(std::vector<uint8_t> const& proof);
+
+    size_t get_num_added() const { return num_added_; }
+
+    // Complete the circuit, once all `max_num_inner_proofs` proofs have been added.
+    circuit_result_data finalise();
+
+  private:
+    Composer& composer_;
+    size_t num_inner_txs_pow2_;
+    size_t num_outer_txs_pow2_;
+    size_t max_num_inner_proofs_;
+    size_t num_added_ = 0;
+
+    field_ct rollup_id_;
+    field_ct rollup_size_pow2_;
+    uint32_ct num_inner_proofs_;
+    field_ct old_root_root_;
+    field_ct new_root_root_;
+    merkle_tree::hash_path old_root_path_;
+    field_ct old_defi_root_;
+    field_ct new_defi_root_;
+    merkle_tree::hash_path old_defi_path_;
+    std::vector<field_ct> bridge_call_datas_;
+    std::vector<field_ct> asset_ids_;
+    std::vector<notes::circuit::defi_interaction::note> defi_interaction_notes_;
+    field_ct num_previous_defi_interactions_;
+    transcript::Manifest recursive_manifest_;
+    std::shared_ptr<plonk::stdlib::recursion::verification_key<bn254>> recursive_verification_key_;
+    field_ct rollup_beneficiary_;
+
+    // To be extracted from inner proofs.
+    field_ct data_start_index_;
+    field_ct old_data_root_;
+    field_ct new_data_root_;
+    field_ct old_null_root_;
+    field_ct new_null_root_;
+
+    // A padding rollup uses this as its public input hash.
+    field_ct zero_hash_;
+
+    // Accumulated over the inner proofs.
+    recursion_output<bn254> recursion_output_;
+    std::vector<field_ct> inner_input_hashes_;
+    std::vector<fr> tx_proof_public_inputs_;
+    std::vector<field_ct> total_tx_fees_;
+    std::vector<field_ct> defi_deposit_sums_;
+};
+
 circuit_result_data root_rollup_circuit(Composer& composer,
                                         root_rollup_tx const& rollups,
                                         size_t inner_rollup_size,
@@ -139,6 +139,27 @@ HEAVY_TEST_F(root_rollup_full_tests, test_root_rollup_3x2)
     EXPECT_EQ(inner_data.asset_id, fr(0));
 }
 
+HEAVY_TEST_F(root_rollup_full_tests, test_root_rollup_3x2_incremental)
+{
+    static constexpr auto rollups_per_rollup = 3U;
+
+    auto root_rollup_cd = get_circuit_data(rollups_per_rollup, tx_rollup2_cd, srs, FIXTURE_PATH, true, false, false);
+
+    auto tx_data = create_root_rollup_tx(
+        "test_root_rollup_3x2", 0, tx_rollup2_cd, { { js_proofs[0], js_proofs[1] }, { js_proofs[2] } });
+    auto expected = verify_logic(tx_data, root_rollup_cd);
+    ASSERT_TRUE(expected.logic_verified);
+
+    incremental_verifier verifier(tx_data, root_rollup_cd);
+    for (size_t i = 0; i < tx_data.num_inner_proofs; ++i) {
+        verifier.add_rollup(tx_data.rollups[i]);
+    }
+    auto result = verifier.verify();
+    ASSERT_TRUE(result.verified);
+    EXPECT_EQ(result.broadcast_data, expected.broadcast_data);
+    EXPECT_EQ(result.public_inputs, expected.public_inputs);
+}
+
 HEAVY_TEST_F(root_rollup_full_tests, test_root_rollup_2x3)
 {
     static constexpr auto rollups_per_rollup = 2U;
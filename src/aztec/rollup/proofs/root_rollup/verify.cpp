@@ -52,6 +52,77 @@ verify_result verify(root_rollup_tx& tx, circuit_data const& cd)
     return verify_internal(composer, tx, cd, "root rollup", true, build_circuit);
 }
 
+std::unique_ptr<verify_pipeline> create_verify_pipeline(circuit_data const& cd)
+{
+    return std::make_unique<verify_pipeline>(cd, "root rollup", true, build_circuit);
+}
+
+incremental_verifier::incremental_verifier(root_rollup_tx tx, circuit_data const& cd)
+    : cd_(cd)
+    , tx_(std::move(tx))
+    , composer_(cd.proving_key, cd.verification_key, cd.num_gates)
+{
+    if (!cd_.inner_rollup_circuit_data.verification_key) {
+        info("Inner verification key not provided.");
+        return;
+    }
+
+    if (cd_.inner_rollup_circuit_data.padding_proof.size() == 0) {
+        info("Inner padding proof not provided.");
+        return;
+    }
+
+    info("root rollup: Building circuit as inner rollups arrive...");
+    pad_root_rollup_tx(tx_, cd_);
+    builder_ = std::make_unique<root_rollup_circuit_builder>(composer_,
+                                                             tx_,
+                                                             cd_.inner_rollup_circuit_data.rollup_size,
+                                                             cd_.rollup_size,
+                                                             cd_.num_inner_rollups,
+                                                             cd_.inner_rollup_circuit_data.verification_key);
+}
+
+void incremental_verifier::add_rollup(std::vector<uint8_t> const& proof)
+{
+    if (!builder_) {
+        return;
+    }
+    if (builder_->get_num_added() >= tx_.num_inner_proofs) {
+        throw_or_abort(format("Root rollup only has ", tx_.num_inner_proofs, " inner proofs."));
+    }
+    Timer timer;
+    builder_->add_inner_proof(proof);
+    info("root rollup: Inner rollup ", builder_->get_num_added(), " added in ", timer.toString(), "s");
+}
+
+verify_result incremental_verifier::verify()
+{
+    verify_result result;
+    if (!builder_) {
+        return result;
+    }
+    if (builder_->get_num_added() < tx_.num_inner_proofs) {
+        result.err = format("Only ", builder_->get_num_added(), " of ", tx_.num_inner_proofs, " inner proofs added.");
+        info("root rollup: ", result.err);
+        return result;
+    }
+
+    while (builder_->get_num_added() < cd_.num_inner_rollups) {
+        builder_->add_inner_proof(cd_.inner_rollup_circuit_data.padding_proof);
+    }
+    auto circuit_result = builder_->finalise();
+    result.recursion_output = circuit_result.recursion_output;
+    result.broadcast_data = circuit_result.broadcast_data;
+    info("root rollup: Circuit built in ", timer_.toString(), "s");
+
+    check_circuit_internal(composer_, cd_, "root rollup", result);
+    if (result.logic_verified) {
+        prove_internal(composer_, cd_, "root rollup", true, result);
+    }
+    info("root rollup: Total time taken: ", timer_.toString(), "s");
+    return result;
+}
+
 } // namespace root_rollup
 } // namespace proofs
 } // namespace rollup
@@ -1,6 +1,7 @@
 #pragma once
 #include "../verify.hpp"
 #include "compute_circuit_data.hpp"
+#include "root_rollup_circuit.hpp"
 #include "root_rollup_tx.hpp"
 
 namespace rollup {
@@ -18,6 +19,38 @@ verify_result verify_logic(root_rollup_tx& tx, circuit_data const& cd);
 
 verify_result verify(root_rollup_tx& tx, circuit_data const& cd);
 
+// Proves root rollups one after another, building each one's circuit while the previous one is proved.
+using verify_pipeline = ::rollup::proofs::verify_pipeline<Composer, root_rollup_tx, circuit_data, verify_result>;
+
+std::unique_ptr<verify_pipeline> create_verify_pipeline(circuit_data const& cd);
+
+/**
+ * Verifies a root rollup's inner rollup proofs in-circuit as they arrive, rather than once they all have, so that only
+ * the end of the circuit and the proof are left when the last one comes in. The result is the same as `verify` gives
+ * for a tx holding all of the proofs.
+ */
+class incremental_verifier {
+  public:
+    // `tx` holds the root rollup's header, including `num_inner_proofs`. Its `rollups` are ignored.
+    incremental_verifier(root_rollup_tx tx, circuit_data const& cd);
+
+    incremental_verifier(incremental_verifier const& other) = delete;
+    incremental_verifier& operator=(incremental_verifier const& other) = delete;
+
+    // Verify the next of the `num_inner_proofs` inner rollup proofs in the circuit.
+    void add_rollup(std::vector<uint8_t> const& proof);
+
+    // Pad the circuit with padding proofs, complete it and prove it.
+    verify_result verify();
+
+  private:
+    circuit_data cd_;
+    root_rollup_tx tx_;
+    Composer composer_;
+    std::unique_ptr<root_rollup_circuit_builder> builder_;
+    Timer timer_;
+};
+
 } // namespace root_rollup
 } // namespace proofs
 } // namespace rollup
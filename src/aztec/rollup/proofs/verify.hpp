@@ -2,6 +2,9 @@
 #include "./mock/mock_circuit.hpp"
 #include <ecc/curves/bn254/fq12.hpp>
 #include <ecc/curves/bn254/pairing.hpp>
+#include <functional>
+#include <future>
+#include <memory>
 #include <stdlib/recursion/verifier/verifier.hpp>
 
 namespace rollup {
@@ -36,47 +39,53 @@ inline bool pairing_check(plonk::stdlib::recursion::recursion_output<plonk::stdl
     return inner_proof_result == barretenberg::fq12::one();
 }
 
-template <typename Composer, typename Tx, typename CircuitData, typename F>
-auto verify_logic_internal(Composer& composer, Tx& tx, CircuitData const& cd, char const* name, F const& build_circuit)
+/**
+ * Check a circuit that has been built, and record its public inputs in `result`. Sets `result.logic_verified` if the
+ * circuit is satisfied and its recursion output passes the native pairing check.
+ */
+template <typename Composer, typename CircuitData, typename Result>
+void check_circuit_internal(Composer& composer, CircuitData const& cd, char const* name, Result& result)
 {
-    info(name, ": Building circuit...");
-    Timer timer;
-    auto result = build_circuit(composer, tx, cd);
-    info(name, ": Circuit built in ", timer.toString(), "s");
-
     if (composer.failed) {
         info(name, ": Circuit logic failed: " + composer.err);
         result.err = composer.err;
-        return result;
+        return;
     }
 
     if (!cd.srs) {
         info(name, ": Srs not provided.");
-        return result;
+        return;
     }
 
     if (!pairing_check(result.recursion_output, cd.srs->get_verifier_crs())) {
         info(name, ": Native pairing check failed.");
-        return result;
+        return;
     }
 
     result.public_inputs = composer.get_public_inputs();
     result.logic_verified = true;
-
-    return result;
 }
 
 template <typename Composer, typename Tx, typename CircuitData, typename F>
-auto verify_internal(
-    Composer& composer, Tx& tx, CircuitData const& cd, char const* name, bool unrolled, F const& build_circuit)
+auto verify_logic_internal(Composer& composer, Tx& tx, CircuitData const& cd, char const* name, F const& build_circuit)
 {
+    info(name, ": Building circuit...");
     Timer timer;
-    auto result = verify_logic_internal(composer, tx, cd, name, build_circuit);
+    auto result = build_circuit(composer, tx, cd);
+    info(name, ": Circuit built in ", timer.toString(), "s");
 
-    if (!result.logic_verified) {
-        return result;
-    }
+    check_circuit_internal(composer, cd, name, result);
+
+    return result;
+}
 
+/**
+ * Prove the circuit built in `composer`, which has passed `check_circuit_internal`, and verify the proof. Sets
+ * `result.proof_data` and `result.verified`.
+ */
+template <typename Composer, typename CircuitData, typename Result>
+void prove_internal(Composer& composer, CircuitData const& cd, char const* name, bool unrolled, Result& result)
+{
     cd.proving_key->reset();
 
     Timer proof_timer;
@@ -107,7 +116,6 @@ auto verify_internal(
     }
 
     info(name, ": Proof created in ", proof_timer.toString(), "s");
-    info(name, ": Total time taken: ", timer.toString(), "s");
 
     if (unrolled) {
         auto verifier = composer.create_unrolled_verifier();
@@ -119,13 +127,124 @@ auto verify_internal(
 
     if (!result.verified) {
         info(name, ": Proof validation failed.");
-        return result;
     } else {
         info(name, ": Verified successfully.");
     }
+}
+
+template <typename Composer, typename Tx, typename CircuitData, typename F>
+auto verify_internal(
+    Composer& composer, Tx& tx, CircuitData const& cd, char const* name, bool unrolled, F const& build_circuit)
+{
+    Timer timer;
+    auto result = verify_logic_internal(composer, tx, cd, name, build_circuit);
+
+    if (!result.logic_verified) {
+        return result;
+    }
+
+    prove_internal(composer, cd, name, unrolled, result);
+    info(name, ": Total time taken: ", timer.toString(), "s");
 
     return result;
 }
 
+/**
+ * Proves a sequence of txs of one circuit, overlapping the witness generation of each tx with the proof of the one
+ * before it.
+ *
+ * Building a circuit is mostly serial, while the prover spends most of its time in multi-threaded FFTs and MSMs, so
+ * the circuit of tx k + 1 is built on a background thread while tx k is proved. A circuit is only built once the
+ * circuit before it has been built and the one before that has been proved, so at most two circuits are held in memory
+ * at a time. Proofs are made one at a time and in order, as they share the circuit's proving key.
+ */
+template <typename Composer, typename Tx, typename CircuitData, typename Result> class verify_pipeline {
+  public:
+    using BuildCircuit = std::function<Result(Composer&, Tx&, CircuitData const&)>;
+
+    verify_pipeline(CircuitData const& cd, char const* name, bool unrolled, BuildCircuit build_circuit)
+        : cd_(cd)
+        , name_(name)
+        , unrolled_(unrolled)
+        , build_circuit_(std::move(build_circuit))
+    {}
+
+    verify_pipeline(verify_pipeline const& other) = delete;
+    verify_pipeline& operator=(verify_pipeline const& other) = delete;
+
+    ~verify_pipeline()
+    {
+        // Each proof waits for the one before it.
+        if (proved_.valid()) {
+            proved_.wait();
+        }
+    }
+
+    // Queue `tx`, and return the result of verifying it, as `verify` would.
+    std::future<Result> push(Tx tx)
+    {
+        auto circuit = std::make_shared<pending_circuit>();
+        circuit->tx = std::move(tx);
+        auto promise = std::make_shared<std::promise<Result>>();
+        auto future = promise->get_future();
+
+        // Build once the previous circuit has been built, and the one before that has been proved.
+        auto build = [this, circuit, previous_built = built_, previous_proved = proved_before_]() {
+            wait(previous_built);
+            wait(previous_proved);
+            circuit->composer = std::make_unique<Composer>(cd_.proving_key, cd_.verification_key, cd_.num_gates);
+            circuit->result = verify_logic_internal(*circuit->composer, circuit->tx, cd_, name_, build_circuit_);
+        };
+        auto built = std::async(std::launch::async, build).share();
+
+        // Prove once built, and once the previous circuit has been proved.
+        auto prove = [this, circuit, built, previous_proved = proved_, promise]() {
+            try {
+                built.get();
+                wait(previous_proved);
+                if (circuit->result.logic_verified) {
+                    prove_internal(*circuit->composer, cd_, name_, unrolled_, circuit->result);
+                }
+                // Free the circuit before the next one is built.
+                circuit->composer.reset();
+                promise->set_value(std::move(circuit->result));
+            } catch (...) {
+                circuit->composer.reset();
+                promise->set_exception(std::current_exception());
+            }
+        };
+        auto proved = std::async(std::launch::async, prove).share();
+
+        built_ = built;
+        proved_before_ = proved_;
+        proved_ = proved;
+        return future;
+    }
+
+  private:
+    struct pending_circuit {
+        Tx tx;
+        std::unique_ptr<Composer> composer;
+        Result result;
+    };
+
+    static void wait(std::shared_future<void> const& future)
+    {
+        if (future.valid()) {
+            future.wait();
+        }
+    }
+
+    CircuitData cd_;
+    char const* name_;
+    bool unrolled_;
+    BuildCircuit build_circuit_;
+
+    // Completion of the latest circuit's build and proof, and of the proof before it.
+    std::shared_future<void> built_;
+    std::shared_future<void> proved_;
+    std::shared_future<void> proved_before_;
+};
+
 } // namespace proofs
 } // namespace rollup
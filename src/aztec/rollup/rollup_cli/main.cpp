@@ -12,6 +12,8 @@
 #include "../proofs/rollup/index.hpp"
 #include "../proofs/root_rollup/index.hpp"
 #include "../proofs/root_verifier/index.hpp"
+#include "prover_server.hpp"
+#include "proving_key_cache.hpp"
 #include <common/timer.hpp>
 #include <common/container.hpp>
 #include <common/map.hpp>
@@ -19,11 +21,13 @@
 #include <plonk/composer/turbo/compute_verification_key.hpp>
 #include <plonk/proof_system/proving_key/proving_key.hpp>
 #include <plonk/proof_system/verification_key/verification_key.hpp>
+#include <mutex>
 
 using namespace ::rollup::proofs;
 using namespace plonk::stdlib::merkle_tree;
 using namespace serialize;
 namespace tx_rollup = ::rollup::proofs::rollup;
+using Job = ::rollup::ProverServer::Job;
 
 namespace {
 // Number of transactions in an inner rollup.
@@ -34,11 +38,18 @@ size_t inners_per_root;
 bool mock_proofs;
 // Create big circuits proving keys lazily to improve startup times.
 bool lazy_init;
+// Memory budget of the tx rollup, root rollup and root verifier proving keys. In lazy init mode it is 0, so only the
+// key in use is held.
+size_t key_memory_budget;
 // True if rollup circuit data (proving and verification keys) are to be persisted to disk.
 // We likely don't have enough memory to hold all keys in memory, and loading keys from disk is faster.
 bool persist;
 // Path to save proving keys to if persist is on.
 std::string data_path;
+// If set, serve requests on this Unix socket rather than on standard input.
+std::string socket_path;
+// If set, pippenger point tables are cached here, so restarts can map them instead of recomputing them.
+std::string point_table_cache_path;
 
 std::shared_ptr<waffle::DynamicFileReferenceStringFactory> crs;
 join_split::circuit_data js_cd;
@@ -47,140 +58,225 @@ claim::circuit_data claim_cd;
 tx_rollup::circuit_data tx_rollup_cd;
 root_rollup::circuit_data root_rollup_cd;
 root_verifier::circuit_data root_verifier_cd;
+
+std::unique_ptr<::rollup::ProvingKeyCache> key_cache;
+// Guards the circuit data above and the key cache, once the circuits are set up. It is only held to read or publish
+// circuit data: proofs take copies of the circuit data they need and run without it, and keys are built or loaded
+// without it.
+std::mutex circuit_data_mutex;
+// Held while the proving key of the circuit is built or loaded, so that concurrent requests for a circuit wait for
+// one key rather than each building their own, while requests for other circuits carry on. A thread that holds one
+// of these may take those below it, and then circuit_data_mutex, but never the other way around.
+std::mutex root_verifier_init_mutex;
+std::mutex root_rollup_init_mutex;
+std::mutex tx_rollup_init_mutex;
 } // namespace
 
-// Postcondition: tx_rollup_cd has a proving key and verification key.
-void init_tx_rollup(size_t num_txs)
+// Returns tx_rollup_cd, once it has a proving key and verification key.
+tx_rollup::circuit_data init_tx_rollup(size_t num_txs)
 {
-    if (tx_rollup_cd.proving_key) {
-        // We always have a vk if we have a pk, as we request both in the call to get_circuit_data.
-        return;
-    }
-    if (lazy_init) {
-        // In lazy init mode we conserve memory. Throw away the root rollup proving key first.
-        info("Purging root rollup proving key.");
-        root_rollup_cd.proving_key.reset();
+    std::lock_guard<std::mutex> init_lock(tx_rollup_init_mutex);
+    {
+        std::lock_guard<std::mutex> lock(circuit_data_mutex);
+        if (tx_rollup_cd.proving_key) {
+            // We always have a vk if we have a pk, as we request both in the call to get_circuit_data.
+            key_cache->use(tx_rollup_cd.proving_key);
+            return tx_rollup_cd;
+        }
+        // Throw away least recently used proving keys first, to make room for this one.
+        key_cache->reserve(tx_rollup_cd.proving_key);
     }
-    tx_rollup_cd = tx_rollup::get_circuit_data(
+    auto cd = tx_rollup::get_circuit_data(
         num_txs, js_cd, account_cd, claim_cd, crs, data_path, true, persist, persist, true, true, mock_proofs);
+
+    std::lock_guard<std::mutex> lock(circuit_data_mutex);
+    tx_rollup_cd = cd;
+    key_cache->use(tx_rollup_cd.proving_key);
+    return tx_rollup_cd;
 }
 
-bool create_tx_rollup()
+Job create_tx_rollup(std::istream& is)
 {
-    init_tx_rollup(txs_per_inner);
-
     tx_rollup::rollup_tx rollup;
     std::cerr << "Reading tx rollup..." << std::endl;
-    read(std::cin, rollup);
+    read(is, rollup);
     std::cerr << "Received tx rollup with " << rollup.num_txs << " txs." << std::endl;
 
-    auto result = verify(rollup, tx_rollup_cd);
+    return [rollup](std::ostream& os) mutable {
+        auto cd = init_tx_rollup(txs_per_inner);
 
-    write(std::cout, result.proof_data);
-    write(std::cout, result.verified);
-    std::cout << std::flush;
+        auto result = verify(rollup, cd);
 
-    return result.verified;
+        write(os, result.proof_data);
+        write(os, result.verified);
+    };
 }
 
-// Postcondition: root_rollup_cd has a proving key and verification key.
-void init_root_rollup(size_t num_rollups)
+// Returns root_rollup_cd, once it has a proving key and verification key.
+root_rollup::circuit_data init_root_rollup(size_t num_rollups)
 {
-    if (root_rollup_cd.proving_key) {
-        // We always have a vk if we have a pk, as we request both in the call to get_circuit_data.
-        return;
+    std::lock_guard<std::mutex> init_lock(root_rollup_init_mutex);
+    tx_rollup::circuit_data inner_cd;
+    {
+        std::lock_guard<std::mutex> lock(circuit_data_mutex);
+        if (root_rollup_cd.proving_key) {
+            // We always have a vk if we have a pk, as we request both in the call to get_circuit_data.
+            key_cache->use(root_rollup_cd.proving_key);
+            return root_rollup_cd;
+        }
+        inner_cd = tx_rollup_cd;
     }
-    if (!tx_rollup_cd.verification_key) {
+    if (!inner_cd.verification_key) {
         // If we've never created the tx rollup circuit data, we won't have a vk. Build it.
-        init_tx_rollup(txs_per_inner);
+        inner_cd = init_tx_rollup(txs_per_inner);
     }
-    if (lazy_init) {
-        // In lazy init mode we conserve memory. Throw away the tx rollup proving key first.
-        info("Purging tx rollup proving key.");
-        tx_rollup_cd.proving_key.reset();
+    {
+        // Throw away least recently used proving keys first, to make room for this one.
+        std::lock_guard<std::mutex> lock(circuit_data_mutex);
+        key_cache->reserve(root_rollup_cd.proving_key);
     }
-    root_rollup_cd = root_rollup::get_circuit_data(
-        num_rollups, tx_rollup_cd, crs, data_path, true, persist, persist, true, true, mock_proofs);
+    auto cd = root_rollup::get_circuit_data(
+        num_rollups, inner_cd, crs, data_path, true, persist, persist, true, true, mock_proofs);
+
+    std::lock_guard<std::mutex> lock(circuit_data_mutex);
+    root_rollup_cd = cd;
+    key_cache->use(root_rollup_cd.proving_key);
+    return root_rollup_cd;
 }
 
-bool create_root_rollup()
+Job create_root_rollup(std::istream& is)
 {
-    init_root_rollup(inners_per_root);
-
     root_rollup::root_rollup_tx root_rollup;
     std::cerr << "Reading root rollup..." << std::endl;
-    read(std::cin, root_rollup);
+    read(is, root_rollup);
     std::cerr << "Received root rollup with " << root_rollup.rollups.size() << " rollups." << std::endl;
 
-    auto result = verify(root_rollup, root_rollup_cd);
+    return [root_rollup](std::ostream& os) mutable {
+        auto cd = init_root_rollup(inners_per_root);
 
-    root_rollup::root_rollup_broadcast_data broadcast_data(result.broadcast_data);
-    auto buf = join({ to_buffer(broadcast_data), result.proof_data });
+        auto result = verify(root_rollup, cd);
 
-    write(std::cout, buf);
-    write(std::cout, result.verified);
-    std::cout << std::flush;
+        root_rollup::root_rollup_broadcast_data broadcast_data(result.broadcast_data);
+        auto buf = join({ to_buffer(broadcast_data), result.proof_data });
 
-    return result.verified;
+        write(os, buf);
+        write(os, result.verified);
+    };
 }
 
-bool create_claim()
+Job create_claim(std::istream& is)
 {
     claim::claim_tx claim_tx;
     std::cerr << "Reading claim tx..." << std::endl;
-    read(std::cin, claim_tx);
+    read(is, claim_tx);
 
-    auto result = verify(claim_tx, claim_cd);
+    return [claim_tx](std::ostream& os) mutable {
+        auto result = verify(claim_tx, claim_cd);
 
-    write(std::cout, result.proof_data);
-    write(std::cout, result.verified);
-    std::cout << std::flush;
-
-    return result.verified;
+        write(os, result.proof_data);
+        write(os, result.verified);
+    };
 }
 
-// Postcondition: root_verifier_cd has a proving key and verification key.
-void init_root_verifier()
+// Returns root_verifier_cd, once it has a proving key and verification key.
+root_verifier::circuit_data init_root_verifier()
 {
-    if (root_verifier_cd.proving_key) {
-        // We always have a vk if we have a pk, as we request both in the call to get_circuit_data.
-        return;
+    std::lock_guard<std::mutex> init_lock(root_verifier_init_mutex);
+    root_rollup::circuit_data inner_cd;
+    {
+        std::lock_guard<std::mutex> lock(circuit_data_mutex);
+        if (root_verifier_cd.proving_key) {
+            // We always have a vk if we have a pk, as we request both in the call to get_circuit_data.
+            key_cache->use(root_verifier_cd.proving_key);
+            return root_verifier_cd;
+        }
+        inner_cd = root_rollup_cd;
     }
-    if (!root_rollup_cd.verification_key) {
+    if (!inner_cd.verification_key) {
         // If we've never created the root rollup circuit data, we won't have a vk. Build it.
-        init_root_rollup(txs_per_inner);
+        inner_cd = init_root_rollup(txs_per_inner);
+    }
+    {
+        // Throw away least recently used proving keys first, to make room for this one.
+        std::lock_guard<std::mutex> lock(circuit_data_mutex);
+        key_cache->reserve(root_verifier_cd.proving_key);
     }
-    root_verifier_cd = root_verifier::get_circuit_data(root_rollup_cd,
-                                                       crs,
-                                                       { root_rollup_cd.verification_key },
-                                                       data_path,
-                                                       true,
-                                                       persist,
-                                                       persist,
-                                                       true,
-                                                       true,
-                                                       mock_proofs);
+    auto cd = root_verifier::get_circuit_data(inner_cd,
+                                              crs,
+                                              { inner_cd.verification_key },
+                                              data_path,
+                                              true,
+                                              persist,
+                                              persist,
+                                              true,
+                                              true,
+                                              mock_proofs);
+
+    std::lock_guard<std::mutex> lock(circuit_data_mutex);
+    root_verifier_cd = cd;
+    key_cache->use(root_verifier_cd.proving_key);
+    return root_verifier_cd;
 }
 
-bool create_root_verifier()
+Job create_root_verifier(std::istream& is)
 {
-    init_root_verifier();
-
     std::vector<uint8_t> root_rollup_proof_buf;
     std::cerr << "Reading root verifier tx..." << std::endl;
-    read(std::cin, root_rollup_proof_buf);
+    read(is, root_rollup_proof_buf);
+
+    return [root_rollup_proof_buf](std::ostream& os) {
+        auto cd = init_root_verifier();
+        root_rollup::circuit_data inner_cd;
+        size_t rollup_size;
+        {
+            std::lock_guard<std::mutex> lock(circuit_data_mutex);
+            inner_cd = root_rollup_cd;
+            rollup_size = inners_per_root * tx_rollup_cd.rollup_size;
+        }
 
-    auto rollup_size = inners_per_root * tx_rollup_cd.rollup_size;
-    auto tx = root_verifier::create_root_verifier_tx(root_rollup_proof_buf, rollup_size);
+        auto tx = root_verifier::create_root_verifier_tx(root_rollup_proof_buf, rollup_size);
 
-    auto result = verify(tx, root_verifier_cd, root_rollup_cd);
+        auto result = verify(tx, cd, inner_cd);
 
-    result.proof_data = join({ tx.broadcast_data, result.proof_data });
-    write(std::cout, result.proof_data);
-    write(std::cout, (uint8_t)result.verified);
-    std::cout << std::flush;
+        result.proof_data = join({ tx.broadcast_data, result.proof_data });
+        write(os, result.proof_data);
+        write(os, (uint8_t)result.verified);
+    };
+}
 
-    return result.verified;
+// Read the request for `proof_id`, and return the job that answers it. Returns an empty job for an unknown proof id.
+Job read_request(uint32_t proof_id, std::istream& is)
+{
+    switch (proof_id) {
+    case 0:
+        return create_tx_rollup(is);
+    case 1:
+        return create_root_rollup(is);
+    case 2:
+        return create_claim(is);
+    case 3:
+        return create_root_verifier(is);
+    case 100:
+        return [](std::ostream& os) {
+            // Convert to buffer first, so when we call write we prefix the buffer length.
+            std::cerr << "Serving join split vk..." << std::endl;
+            write(os, to_buffer(*js_cd.verification_key));
+        };
+    case 101:
+        return [](std::ostream& os) {
+            std::cerr << "Serving account vk..." << std::endl;
+            write(os, to_buffer(*account_cd.verification_key));
+        };
+    case 666:
+        return [](std::ostream& os) {
+            // Ping... Pong... Used for learning when rollup_cli is responsive.
+            std::cerr << "Ping... Pong..." << std::endl;
+            serialize::write(os, true);
+        };
+    default:
+        std::cerr << "Unknown command: " << proof_id << std::endl;
+        return Job();
+    }
 }
 
 int main(int argc, char** argv)
@@ -197,6 +293,9 @@ int main(int argc, char** argv)
     lazy_init = args.size() > 5 ? args[5] == "true" : false;
     persist = args.size() > 6 ? args[6] == "true" : true;
     data_path = (args.size() > 7) ? args[7] : "./data";
+    socket_path = (args.size() > 8) ? args[8] : "";
+    key_memory_budget = lazy_init ? 0 : (args.size() > 9 ? (std::stoul(args[9]) << 20) : SIZE_MAX);
+    point_table_cache_path = (args.size() > 10) ? args[10] : (persist ? data_path + "/point_tables" : "");
 
     info("Txs per inner: ", txs_per_inner);
     info("Inners per root: ", inners_per_root);
@@ -204,17 +303,23 @@ int main(int argc, char** argv)
     info("Lazy init: ", lazy_init);
     info("Persist: ", persist);
     info("Data path: ", data_path);
+    info("Socket path: ", socket_path.empty() ? "none, reading standard input" : socket_path);
+    info("Point table cache path: ", point_table_cache_path.empty() ? "none" : point_table_cache_path);
+    if (key_memory_budget != SIZE_MAX) {
+        info("Proving key memory budget: ", key_memory_budget >> 20, "MB");
+    }
 
     if (mock_proofs) {
         info("Running in mock proof mode. Mock proofs will be generated!");
     }
 
     info("Loading crs...");
-    crs = std::make_shared<waffle::DynamicFileReferenceStringFactory>(srs_path);
+    crs = std::make_shared<waffle::DynamicFileReferenceStringFactory>(srs_path, 0, point_table_cache_path);
 
     account_cd = account::get_circuit_data(crs, mock_proofs);
     js_cd = join_split::get_circuit_data(crs, mock_proofs);
     claim_cd = claim::get_circuit_data(crs, mock_proofs);
+    key_cache = std::make_unique<::rollup::ProvingKeyCache>(key_memory_budget);
 
     // Lazy init mode conserves memory by purging and recomputing tx/root proving keys.
     // If the halloumi instance is targeted to produce a specific type of proof, use lazy init as it will only
@@ -222,6 +327,8 @@ int main(int argc, char** argv)
     //
     // Eager mode can be useful to create all the circuits up front at load time, which is fine if they are not
     // too big. It can be useful for determining to total memory footprint of the process for certain circuit sizes.
+    // Given a proving key memory budget, keys are held until the budget is reached, and then the least recently used
+    // ones are purged.
     if (!lazy_init) {
         info("Running in eager init mode, all proving keys will be created once up front.");
         init_tx_rollup(txs_per_inner);
@@ -231,6 +338,12 @@ int main(int argc, char** argv)
         info("Running in lazy init mode, tx rollup and root rollup proving keys will be swapped in and out.");
     }
 
+    if (!socket_path.empty()) {
+        ::rollup::ProverServer server(socket_path, read_request);
+        server.run();
+        return 1;
+    }
+
     info("Reading rollups from standard input...");
     while (true) {
         if (!std::cin.good() || std::cin.peek() == std::char_traits<char>::eof()) {
@@ -240,44 +353,10 @@ int main(int argc, char** argv)
         uint32_t proof_id;
         read(std::cin, proof_id);
 
-        switch (proof_id) {
-        case 0: {
-            create_tx_rollup();
-            break;
-        }
-        case 1: {
-            create_root_rollup();
-            break;
-        }
-        case 2: {
-            create_claim();
-            break;
-        }
-        case 3: {
-            create_root_verifier();
-            break;
-        }
-        case 100: {
-            // Convert to buffer first, so when we call write we prefix the buffer length.
-            std::cerr << "Serving join split vk..." << std::endl;
-            write(std::cout, to_buffer(*js_cd.verification_key));
-            break;
-        }
-        case 101: {
-            std::cerr << "Serving account vk..." << std::endl;
-            write(std::cout, to_buffer(*account_cd.verification_key));
-            break;
-        }
-        case 666: {
-            // Ping... Pong... Used for learning when rollup_cli is responsive.
-            std::cerr << "Ping... Pong..." << std::endl;
-            serialize::write(std::cout, true);
-            break;
-        }
-        default: {
-            std::cerr << "Unknown command: " << proof_id << std::endl;
-            break;
-        }
+        auto job = read_request(proof_id, std::cin);
+        if (job) {
+            job(std::cout);
+            std::cout << std::flush;
         }
     }
 
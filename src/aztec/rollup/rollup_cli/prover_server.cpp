@@ -0,0 +1,297 @@
+#include "prover_server.hpp"
+#include <common/log.hpp>
+#include <common/serialize.hpp>
+#include <common/throw_or_abort.hpp>
+#include <polynomials/polynomial_arithmetic.hpp>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace rollup {
+
+namespace {
+
+// A buffered stream over a socket, so that requests and responses can use the serialize functions.
+class socket_streambuf : public std::streambuf {
+  public:
+    socket_streambuf(int fd)
+        : fd_(fd)
+    {
+        setg(input_, input_, input_);
+        setp(output_, output_ + sizeof(output_));
+    }
+
+  protected:
+    int_type underflow() override
+    {
+        ssize_t result;
+        do {
+            result = ::read(fd_, input_, sizeof(input_));
+        } while (result < 0 && errno == EINTR);
+        if (result <= 0) {
+            return traits_type::eof();
+        }
+        setg(input_, input_, input_ + result);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    int_type overflow(int_type c) override
+    {
+        if (sync() != 0) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override
+    {
+        char* data = pbase();
+        while (data < pptr()) {
+            // Don't raise SIGPIPE if the client has gone away.
+            ssize_t result = ::send(fd_, data, (size_t)(pptr() - data), MSG_NOSIGNAL);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result <= 0) {
+                return -1;
+            }
+            data += result;
+        }
+        setp(output_, output_ + sizeof(output_));
+        return 0;
+    }
+
+  private:
+    int fd_;
+    char input_[1 << 16];
+    char output_[1 << 16];
+};
+
+} // namespace
+
+ProverServer::ProverServer(std::string const& socket_path, RequestReader read_request)
+    : socket_path_(socket_path)
+    , read_request_(std::move(read_request))
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path_.size() >= sizeof(address.sun_path)) {
+        throw_or_abort("Socket path too long: " + socket_path_);
+    }
+    std::memcpy(address.sun_path, socket_path_.c_str(), socket_path_.size() + 1);
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    // Replace the socket of a previous run.
+    unlink(socket_path_.c_str());
+    if (listen_fd_ < 0 || bind(listen_fd_, (sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(listen_fd_, SOMAXCONN) != 0) {
+        throw_or_abort("Failed to listen on: " + socket_path_);
+    }
+}
+
+ProverServer::~ProverServer()
+{
+    // `run` closes the socket when it returns
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        unlink(socket_path_.c_str());
+    }
+}
+
+void ProverServer::run()
+{
+    info("Listening on ", socket_path_, "...");
+    while (true) {
+        int fd = accept(listen_fd_, nullptr, nullptr);
+        const int error = errno;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+            break;
+        }
+        if (fd < 0) {
+            if (error == EINTR || error == ECONNABORTED) {
+                continue;
+            }
+            info("Failed to accept a connection: ", std::strerror(error));
+            break;
+        }
+        join_closed_connections();
+        // List nodes are stable, so the connection's thread can hold on to it.
+        auto& connection = connections_.emplace_back();
+        connection.fd = fd;
+        connection.thread = std::thread([this, &connection]() { serve_connection(connection); });
+    }
+    stop();
+
+    // The open connections have been shut down and the queued requests failed, so the connection threads finish once
+    // the jobs that are running complete. Nothing else adds connections or workers now.
+    for (auto& connection : connections_) {
+        connection.thread.join();
+    }
+    connections_.clear();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    close(listen_fd_);
+    listen_fd_ = -1;
+    unlink(socket_path_.c_str());
+}
+
+void ProverServer::stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+        return;
+    }
+    stopping_ = true;
+    // Wakes up `accept`, and the reads of the connection threads.
+    if (listen_fd_ >= 0) {
+        shutdown(listen_fd_, SHUT_RDWR);
+    }
+    for (auto& connection : connections_) {
+        if (!connection.done) {
+            shutdown(connection.fd, SHUT_RDWR);
+        }
+    }
+    for (auto& it : queues_) {
+        it.second.ready.notify_all();
+    }
+}
+
+void ProverServer::join_closed_connections()
+{
+    for (auto it = connections_.begin(); it != connections_.end();) {
+        if (it->done) {
+            it->thread.join();
+            it = connections_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ProverServer::serve_connection(Connection& connection)
+{
+    socket_streambuf buffer(connection.fd);
+    std::iostream stream(&buffer);
+
+    while (stream.good() && stream.peek() != std::char_traits<char>::eof()) {
+        uint32_t proof_id = 0;
+        auto request = std::make_shared<Request>();
+        try {
+            serialize::read(stream, proof_id);
+            request->job = read_request_(proof_id, stream);
+        } catch (std::exception const& e) {
+            // The rest of the stream can't be framed.
+            info("Failed to read a request for proof ", proof_id, ": ", e.what());
+            break;
+        }
+        if (!request->job || !stream.good()) {
+            // The rest of the stream can't be framed.
+            break;
+        }
+        auto response = request->response.get_future();
+        push(proof_id, request);
+
+        try {
+            auto result = response.get();
+            stream.write(result.data(), (std::streamsize)result.size());
+            stream.flush();
+        } catch (std::exception const& e) {
+            info("Request for proof ", proof_id, " failed: ", e.what());
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    close(connection.fd);
+    connection.done = true;
+}
+
+void ProverServer::push(uint32_t proof_id, std::shared_ptr<Request> const& request)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+        request->response.set_exception(std::make_exception_ptr(std::runtime_error("The server is stopping.")));
+        return;
+    }
+    auto it = queues_.find(proof_id);
+    if (it == queues_.end()) {
+        // Map nodes are stable, so the worker can hold on to its queue.
+        it = queues_.try_emplace(proof_id).first;
+        workers_.emplace_back([this, proof_id, &queue = it->second]() { work(proof_id, queue); });
+    }
+    request->timer.start();
+    it->second.requests.push_back(request);
+    it->second.ready.notify_one();
+}
+
+void ProverServer::work(uint32_t proof_id, Queue& queue)
+{
+    // Kept for the life of the worker, so that its FFTs don't share memory with those of other workers.
+    barretenberg::polynomial_arithmetic::scratch_space_override scratch_space;
+    while (true) {
+        std::shared_ptr<Request> request;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queue.ready.wait(lock, [&]() { return stopping_ || !queue.requests.empty(); });
+            if (stopping_) {
+                for (auto& queued : queue.requests) {
+                    queued->response.set_exception(
+                        std::make_exception_ptr(std::runtime_error("The server is stopping.")));
+                }
+                queue.requests.clear();
+                return;
+            }
+            request = queue.requests.front();
+            queue.requests.pop_front();
+        }
+        const double wait = request->timer.seconds();
+
+        Timer timer;
+        try {
+            std::ostringstream response;
+            request->job(response);
+            request->response.set_value(response.str());
+        } catch (...) {
+            request->response.set_exception(std::current_exception());
+        }
+        const double run = timer.seconds();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++queue.num_served;
+        queue.total_wait += wait;
+        queue.total_run += run;
+        queue.max_run = std::max(queue.max_run, run);
+        info("Proof ",
+             proof_id,
+             ": queued ",
+             wait,
+             "s, ran ",
+             run,
+             "s. Served ",
+             queue.num_served,
+             ", mean wait ",
+             queue.total_wait / (double)queue.num_served,
+             "s, mean run ",
+             queue.total_run / (double)queue.num_served,
+             "s, max run ",
+             queue.max_run,
+             "s.");
+    }
+}
+
+} // namespace rollup
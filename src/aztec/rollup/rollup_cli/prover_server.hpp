@@ -0,0 +1,101 @@
+#pragma once
+#include <common/timer.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rollup {
+
+/**
+ * Serves rollup_cli requests on a local Unix socket, in the same format as the standard input loop: a uint32 proof id
+ * followed by the request, answered by the response.
+ *
+ * Each connection is read by a thread of its own, which queues its requests and writes back their responses in order.
+ * Requests are queued by proof id, and each queue is worked by one thread, so proofs of the same circuit run one at a
+ * time (the prover writes to the circuit's proving key), while proofs of different circuits run concurrently and share
+ * the process's CRS and pippenger point table. Each worker runs its jobs with FFT scratch space of its own, as the
+ * process wide scratch space only serves one FFT at a time.
+ *
+ * The time each request spends queued and running is logged, along with running totals for its proof id.
+ *
+ * `stop` shuts the server down: `run` then stops accepting connections, closes the open ones, fails the requests that
+ * are still queued, waits for the jobs that are running and joins all of its threads before returning.
+ */
+class ProverServer {
+  public:
+    // Answers a request by writing its response to the stream.
+    using Job = std::function<void(std::ostream&)>;
+    // Reads the request for a proof id from the stream, and returns the job that answers it, or an empty job if the
+    // proof id is unknown.
+    using RequestReader = std::function<Job(uint32_t, std::istream&)>;
+
+    ProverServer(std::string const& socket_path, RequestReader read_request);
+
+    ProverServer(ProverServer const& other) = delete;
+    ProverServer& operator=(ProverServer const& other) = delete;
+
+    ~ProverServer();
+
+    // Accept connections. Returns once the server is stopped, or the socket fails.
+    void run();
+
+    // Make `run` return. Can be called from any thread.
+    void stop();
+
+  private:
+    struct Request {
+        Job job;
+        std::promise<std::string> response;
+        // Started when the request is queued
+        Timer timer;
+    };
+
+    struct Queue {
+        std::deque<std::shared_ptr<Request>> requests;
+        std::condition_variable ready;
+        size_t num_served = 0;
+        double total_wait = 0;
+        double total_run = 0;
+        double max_run = 0;
+    };
+
+    struct Connection {
+        int fd;
+        std::thread thread;
+        // Set once the connection's thread has closed `fd` and is about to exit
+        bool done = false;
+    };
+
+    void serve_connection(Connection& connection);
+
+    // Join the threads of connections that have been closed. Called with `mutex_` held.
+    void join_closed_connections();
+
+    // Queue a request, starting a worker for its proof id on first use.
+    void push(uint32_t proof_id, std::shared_ptr<Request> const& request);
+
+    void work(uint32_t proof_id, Queue& queue);
+
+    std::string socket_path_;
+    RequestReader read_request_;
+    int listen_fd_;
+
+    // Guards everything below
+    std::mutex mutex_;
+    bool stopping_ = false;
+    std::map<uint32_t, Queue> queues_;
+    std::vector<std::thread> workers_;
+    std::list<Connection> connections_;
+};
+
+} // namespace rollup
@@ -0,0 +1,90 @@
+#pragma once
+#include <common/log.hpp>
+#include <list>
+#include <map>
+#include <memory>
+#include <plonk/proof_system/proving_key/proving_key.hpp>
+
+namespace rollup {
+
+/**
+ * Bounds the memory taken by the proving keys of the circuits a prover serves.
+ *
+ * The cache does not own the keys. It tracks the slots that hold them (e.g. the `proving_key` of a circuit's
+ * `circuit_data`), most recently used first, and evicts a key by resetting its slot, so the key is rebuilt or reloaded
+ * from disk the next time it is needed. The key in use is never evicted, so a key larger than the budget is still
+ * served, and a budget of 0 keeps only one key in memory at a time.
+ *
+ * A proof that holds its own reference to an evicted key keeps it alive until the proof completes, so the budget is
+ * exceeded by at most the keys of the proofs in flight.
+ *
+ * The cache is not thread safe. Callers serialise access to it, along with the slots it manages.
+ */
+class ProvingKeyCache {
+  public:
+    using Slot = std::shared_ptr<waffle::proving_key>;
+
+    ProvingKeyCache(size_t memory_budget)
+        : memory_budget_(memory_budget)
+    {}
+
+    /**
+     * Evict least recently used keys until a key the size `slot` last held fits in the budget. Call this before
+     * building or loading the key for an empty slot, so that the old keys are freed first. Slots that have not held a
+     * key yet are assumed to be empty.
+     */
+    void reserve(Slot& slot)
+    {
+        auto it = sizes_.find(&slot);
+        evict(&slot, it == sizes_.end() ? 0 : it->second);
+    }
+
+    /**
+     * Mark the key in `slot` as the most recently used, adding it to the cache if it is new, and evict least recently
+     * used keys until the cached keys fit in the budget.
+     */
+    void use(Slot& slot)
+    {
+        if (!slot) {
+            return;
+        }
+        lru_.remove(&slot);
+        lru_.push_front(&slot);
+        sizes_[&slot] = slot->get_memory_size();
+        evict(&slot, 0);
+    }
+
+    size_t get_memory_size() const
+    {
+        size_t total = 0;
+        for (auto* slot : lru_) {
+            total += sizes_.at(slot);
+        }
+        return total;
+    }
+
+  private:
+    void evict(Slot const* keep, size_t required)
+    {
+        size_t total = get_memory_size();
+        auto it = lru_.end();
+        while (it != lru_.begin() && total + required > memory_budget_) {
+            --it;
+            if (*it == keep) {
+                continue;
+            }
+            info("Evicting a ", sizes_[*it] >> 20, "MB proving key to stay within the proving key budget.");
+            total -= sizes_[*it];
+            (*it)->reset();
+            it = lru_.erase(it);
+        }
+    }
+
+    size_t memory_budget_;
+    // Most recently used first
+    std::list<Slot*> lru_;
+    // The size of the key each slot last held, whether or not it is still cached
+    std::map<Slot const*, size_t> sizes_;
+};
+
+} // namespace rollup
@@ -50,9 +50,12 @@ template <typename Store> class WorldState {
 
     void add_defi_notes(std::vector<defi_interaction::note> const& din, uint32_t start_index)
     {
+        std::vector<std::pair<typename Tree::index_t, fr>> leaves;
+        leaves.reserve(din.size());
         for (uint32_t i = 0; i < din.size(); i++) {
-            defi_tree.update_element(start_index + i, din[i].commit());
+            leaves.push_back({ start_index + i, din[i].commit() });
         }
+        defi_tree.update_elements(leaves);
     }
 
     void nullify(uint256_t index) { null_tree.update_element(index, { 1 }); }
@@ -2,8 +2,11 @@
 #include <common/mem.hpp>
 #include <common/net.hpp>
 #include <common/throw_or_abort.hpp>
+#include <cstdio>
 #include <fstream>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
 
 namespace barretenberg {
 namespace io {
@@ -221,5 +224,127 @@ void read_transcript(g1::affine_element* monomials, g2::affine_element& g2_x, si
     read_transcript_g2(g2_x, path);
 }
 
+size_t get_transcript_num_g1_points(std::string const& dir)
+{
+    const std::string path = get_transcript_path(dir, 0);
+    if (!is_file_exist(path)) {
+        return 0;
+    }
+    Manifest manifest;
+    read_manifest(path, manifest);
+    return manifest.total_g1_points;
+}
+
+uint64_t get_transcript_hash(std::string const& dir, size_t degree)
+{
+    // 64-bit FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const auto hash_bytes = [&hash](uint8_t const* data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * 0x100000001b3ULL;
+        }
+    };
+
+    // Mirrors the file walk of read_transcript_g1.
+    size_t num = 0;
+    size_t num_read = 1;
+    std::string path = get_transcript_path(dir, num);
+    while (is_file_exist(path) && num_read < degree) {
+        Manifest manifest;
+        read_manifest(path, manifest);
+        hash_bytes((uint8_t const*)&manifest, sizeof(Manifest));
+
+        const size_t file_size = get_file_size(path);
+        if (file_size >= BLAKE2B_CHECKSUM_LENGTH) {
+            uint8_t checksum[BLAKE2B_CHECKSUM_LENGTH];
+            size_t size = 0;
+            read_file_into_buffer((char*)checksum, size, path, file_size - BLAKE2B_CHECKSUM_LENGTH, sizeof(checksum));
+            hash_bytes(checksum, size);
+        }
+
+        num_read += std::min((size_t)manifest.num_g1_points, degree - num_read);
+        path = get_transcript_path(dir, ++num);
+    }
+    return hash;
+}
+
+std::string get_lagrange_transcript_path(std::string const& dir, size_t degree, uint64_t transcript_hash)
+{
+    char hash_hex[17];
+    snprintf(hash_hex, sizeof(hash_hex), "%016llx", (unsigned long long)transcript_hash);
+    return dir + "/lagrange_transcript_" + std::to_string(degree) + "_" + hash_hex + ".dat";
+}
+
+bool read_lagrange_transcript(g1::affine_element* elements,
+                              size_t degree,
+                              std::string const& dir,
+                              uint64_t transcript_hash)
+{
+    const std::string path = get_lagrange_transcript_path(dir, degree, transcript_hash);
+    if (!is_file_exist(path)) {
+        return false;
+    }
+
+    const size_t g1_buffer_size = sizeof(fq) * 2 * degree;
+    if (get_file_size(path) != sizeof(Manifest) + g1_buffer_size) {
+        return false;
+    }
+    Manifest manifest;
+    read_manifest(path, manifest);
+    if (manifest.num_g1_points != degree) {
+        return false;
+    }
+
+    size_t size = 0;
+    read_file_into_buffer((char*)elements, size, path, sizeof(Manifest), g1_buffer_size);
+    if (size != g1_buffer_size) {
+        return false;
+    }
+    byteswap(elements, size);
+    for (size_t i = 0; i < degree; ++i) {
+        if (!elements[i].on_curve()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void write_lagrange_transcript(g1::affine_element const* elements,
+                               size_t degree,
+                               std::string const& dir,
+                               uint64_t transcript_hash)
+{
+    Manifest manifest{ 0, 1, (uint32_t)degree, 0, (uint32_t)degree, 0, 0 };
+    manifest.transcript_number = htonl(manifest.transcript_number);
+    manifest.total_transcripts = htonl(manifest.total_transcripts);
+    manifest.total_g1_points = htonl(manifest.total_g1_points);
+    manifest.num_g1_points = htonl(manifest.num_g1_points);
+
+    // Points are stored as in the monomial transcript, out of montgomery form and big endian
+    std::vector<g1::affine_element> buffer(degree);
+    for (size_t i = 0; i < degree; ++i) {
+        buffer[i].x = elements[i].x.from_montgomery_form();
+        buffer[i].y = elements[i].y.from_montgomery_form();
+        if (is_little_endian()) {
+            for (size_t j = 0; j < 4; ++j) {
+                buffer[i].x.data[j] = __builtin_bswap64(buffer[i].x.data[j]);
+                buffer[i].y.data[j] = __builtin_bswap64(buffer[i].y.data[j]);
+            }
+        }
+    }
+
+    // Write to a temporary file and rename it into place, so that a reader never sees a partial transcript
+    const std::string path = get_lagrange_transcript_path(dir, degree, transcript_hash);
+    const std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+    std::ofstream file(tmp_path, std::ofstream::binary);
+    file.write((char*)&manifest, sizeof(Manifest));
+    file.write((char*)&buffer[0], (std::streamsize)(sizeof(fq) * 2 * degree));
+    file.close();
+    if (!file || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        throw_or_abort("Failed to write: " + path);
+    }
+}
+
 } // namespace io
 } // namespace barretenberg
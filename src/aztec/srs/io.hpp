@@ -13,6 +13,30 @@ void read_transcript_g2(g2::affine_element& g2_x, std::string const& dir);
 
 void read_transcript(g1::affine_element* monomials, g2::affine_element& g2_x, size_t degree, std::string const& path);
 
+// Total number of g1 points in the transcript at `dir`, according to its first manifest. 0 if there is no transcript.
+size_t get_transcript_num_g1_points(std::string const& dir);
+
+// A 64-bit identifier of the transcript at `dir`, covering the manifest and trailing checksum of every transcript file
+// that is read to load `degree` points. Used to key caches of data derived from the transcript. It is cheap to compute,
+// and is not collision resistant.
+uint64_t get_transcript_hash(std::string const& dir, size_t degree);
+
+// The Lagrange base SRS of a given degree is cached next to the monomial transcript in `dir`, in the transcript format.
+// The file name includes the `get_transcript_hash` of the monomial transcript it was computed from, so that replacing
+// the transcript does not pick up a stale cache.
+std::string get_lagrange_transcript_path(std::string const& dir, size_t degree, uint64_t transcript_hash);
+
+// Returns false if the cache has not been written, or the file does not hold `degree` points on the curve.
+bool read_lagrange_transcript(g1::affine_element* elements,
+                              size_t degree,
+                              std::string const& dir,
+                              uint64_t transcript_hash);
+
+void write_lagrange_transcript(g1::affine_element const* elements,
+                               size_t degree,
+                               std::string const& dir,
+                               uint64_t transcript_hash);
+
 void read_g1_elements_from_buffer(g1::affine_element* elements, char const* buffer, size_t buffer_size);
 void byteswap(g1::affine_element* elements, size_t buffer_size);
 
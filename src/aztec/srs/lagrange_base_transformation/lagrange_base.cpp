@@ -1,49 +1,136 @@
 #include "./lagrange_base.hpp"
+#include "../io.hpp"
+#include <common/max_threads.hpp>
+#include <numeric/bitop/get_msb.hpp>
 #include <iostream>
+#ifndef NO_MULTITHREADING
+#include <omp.h>
+#endif
+
 namespace barretenberg {
 namespace lagrange_base {
 
-std::vector<g1::element> g1fft(const g1::element* monomials, size_t size, barretenberg::fr root, size_t offset)
+namespace {
+
+size_t reverse_bits(size_t x, const size_t num_bits)
+{
+    size_t result = 0;
+    for (size_t i = 0; i < num_bits; ++i) {
+        result = (result << 1) | (x & 1);
+        x >>= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+/**
+ * Compute result[k] = scale * \sum_j points[j] * root^{jk} in place, as an iterative radix-2 FFT whose butterflies
+ * are spread over all threads.
+ *
+ * The scale is folded into the twiddle factors. After each round, the first block only holds terms built from
+ * points[0] and the twiddles of the blocks it was built from, so scaling points[0] and the twiddles of the first block
+ * of every round scales the whole result. The first block is the only one that needs a scalar multiplication for its
+ * first butterfly, so this costs a handful of scalar multiplications rather than one per point.
+ */
+void g1fft(g1::element* points, const size_t size, const barretenberg::fr& root, const barretenberg::fr& scale)
 {
+    const size_t log2_size = static_cast<size_t>(numeric::get_msb(size));
 
-    std::vector<g1::element> result(size);
-    if (size == 1) {
-        result[0] = monomials[0];
-        return result;
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t i = 0; i < size; ++i) {
+        const size_t j = reverse_bits(i, log2_size);
+        if (i < j) {
+            std::swap(points[i], points[j]);
+        }
     }
 
-    auto new_root = root * root;
-    auto odd = g1fft(monomials + offset, size / 2, new_root, offset * 2);
-    auto even = g1fft(monomials, size / 2, new_root, offset * 2);
-    auto current = root;
-
-    for (size_t i = 0; i < size / 2; ++i) {
-        auto temp = odd[i] * current;
-        g1::element temp2;
-        temp2 = even[i] + temp;
-        result[i] = temp2;
-        temp2 = even[i] - temp;
-        result[size / 2 + i] = temp2;
-        current *= root;
+    // twiddles[k] = root^k
+    const size_t num_twiddles = size / 2;
+    std::vector<barretenberg::fr> twiddles(num_twiddles);
+    const size_t num_threads = std::max(std::min(max_threads::compute_num_threads(), num_twiddles), 1UL);
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < num_threads; ++j) {
+        const size_t start = (j * num_twiddles) / num_threads;
+        const size_t end = ((j + 1) * num_twiddles) / num_threads;
+        barretenberg::fr twiddle = root.pow(static_cast<uint64_t>(start));
+        for (size_t k = start; k < end; ++k) {
+            twiddles[k] = twiddle;
+            twiddle *= root;
+        }
+    }
+
+    points[0] = points[0] * scale;
+    for (size_t m = 1; m < size; m <<= 1) {
+        const size_t twiddle_stride = size / (2 * m);
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+        for (size_t k = 0; k < num_twiddles; ++k) {
+            const size_t block = k / m;
+            const size_t j = k & (m - 1);
+            g1::element& even = points[block * 2 * m + j];
+            g1::element& odd = points[block * 2 * m + j + m];
+            g1::element temp = odd;
+            if (block == 0) {
+                temp = odd * (twiddles[j * twiddle_stride] * scale);
+            } else if (j != 0) {
+                temp = odd * twiddles[j * twiddle_stride];
+            }
+            odd = even - temp;
+            even += temp;
+        }
     }
-    return result;
 }
 
 void transform_srs(g1::affine_element* monomials, g1::affine_element* lagrange_base_affine, const size_t degree)
 {
     barretenberg::evaluation_domain domain(degree);
-    barretenberg::fr root = domain.root_inverse;
-    std::vector<g1::element> monomials_jac(degree);
+    std::vector<g1::element> lagrange_jac(degree);
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
     for (size_t i = 0; i < degree; ++i) {
-        monomials_jac[i] = g1::element(monomials[i].x, monomials[i].y, g1::one.z );
+        lagrange_jac[i] = g1::element(monomials[i].x, monomials[i].y, g1::one.z);
+    }
+
+    // L_k(X) = (1 / n) * \sum_j (omega^{-k} X)^j
+    g1fft(&lagrange_jac[0], degree, domain.root_inverse, domain.domain_inverse);
+
+    // Convert to affine form with one inversion per thread
+    const size_t num_threads = std::max(std::min(max_threads::compute_num_threads(), degree), 1UL);
+#ifndef NO_MULTITHREADING
+#pragma omp parallel for
+#endif
+    for (size_t j = 0; j < num_threads; ++j) {
+        const size_t start = (j * degree) / num_threads;
+        const size_t end = ((j + 1) * degree) / num_threads;
+        g1::element::batch_normalize(&lagrange_jac[start], end - start);
+        for (size_t i = start; i < end; ++i) {
+            lagrange_base_affine[i] = g1::affine_element(lagrange_jac[i].x, lagrange_jac[i].y);
+        }
     }
+}
 
-    auto lagrange_jac = g1fft(&monomials_jac[0], degree, root, 1);
-    for (size_t i = 0; i < degree - 1; ++i) {
-        lagrange_base_affine[i + 1] = static_cast<g1::affine_element>(lagrange_jac[i] * domain.domain_inverse);
+void load_or_compute_lagrange_srs(g1::affine_element* lagrange_base_affine,
+                                  const size_t degree,
+                                  std::string const& dir,
+                                  std::string const& cache_dir)
+{
+    const std::string& lagrange_dir = cache_dir.empty() ? dir : cache_dir;
+    const uint64_t transcript_hash = io::get_transcript_hash(dir, degree);
+    if (io::read_lagrange_transcript(lagrange_base_affine, degree, lagrange_dir, transcript_hash)) {
+        return;
     }
-    lagrange_base_affine[0] = static_cast<g1::affine_element>(lagrange_jac[degree-1] * domain.domain_inverse);
+    std::vector<g1::affine_element> monomials(degree);
+    io::read_transcript_g1(&monomials[0], degree, dir);
+    transform_srs(&monomials[0], lagrange_base_affine, degree);
+    io::write_lagrange_transcript(lagrange_base_affine, degree, lagrange_dir, transcript_hash);
 }
 
 } // namespace lagrange_base
-}
\ No newline at end of file
+} // namespace barretenberg
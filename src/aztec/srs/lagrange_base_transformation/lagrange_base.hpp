@@ -1,13 +1,23 @@
-#pragma once 
+#pragma once
 
 #include "../../ecc/curves/bn254/g1.hpp"
 #include "../../polynomials/evaluation_domain.hpp"
 #include "../../ecc/groups/element.hpp"
+#include <string>
 
 namespace barretenberg
 {
 namespace lagrange_base
 {
+    // Compute the `degree` point Lagrange base SRS [L_0(x)], ..., [L_{degree-1}(x)] from the monomial base SRS.
     void transform_srs(g1::affine_element*, g1::affine_element*, const size_t);
+
+    // Read the `degree` point Lagrange base SRS cached for the monomial transcript in `dir`. If there is no valid
+    // cache, compute it from the monomial transcript and (re)write the cache. The cache is kept in `cache_dir`, or next
+    // to the transcript in `dir` if it is empty.
+    void load_or_compute_lagrange_srs(g1::affine_element* lagrange_base_affine,
+                                      const size_t degree,
+                                      std::string const& dir,
+                                      std::string const& cache_dir = "");
+}
 }
-}
\ No newline at end of file
@@ -9,6 +9,10 @@
 #include "../../polynomials/polynomial.hpp"
 #include "../../plonk/reference_string/file_reference_string.hpp"
 #include "srs/io.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace barretenberg;
 
@@ -147,4 +151,105 @@ TEST(lagrange_base, verify_lagrange_base_import_srs)
     result = result.normalize();
 
     EXPECT_EQ(result == expected, true);
-}
\ No newline at end of file
+}
+
+TEST(lagrange_base, transform_srs_matches_lagrange_polynomials)
+{
+    // Large enough to be split between threads
+    constexpr size_t degree = 1 << 8;
+    fr x = fr::random_element();
+
+    std::vector<g1::affine_element> monomial_srs(degree);
+    fr x_pow = 1;
+    for (size_t i = 0; i < degree; ++i) {
+        monomial_srs[i] = g1::affine_one * x_pow;
+        x_pow *= x;
+    }
+
+    std::vector<g1::affine_element> lagrange_base_srs(degree);
+    lagrange_base::transform_srs(&monomial_srs[0], &lagrange_base_srs[0], degree);
+
+    // [L_k(x)] = (1 / n) * \sum_j (omega^{-k} x)^j
+    barretenberg::evaluation_domain domain(degree);
+    fr root_pow = 1;
+    for (size_t k = 0; k < degree; ++k) {
+        fr term = domain.domain_inverse;
+        fr lagrange_eval = 0;
+        for (size_t j = 0; j < degree; ++j) {
+            lagrange_eval += term;
+            term *= root_pow * x;
+        }
+        EXPECT_EQ(lagrange_base_srs[k], g1::affine_one * lagrange_eval);
+        root_pow *= domain.root_inverse;
+    }
+}
+
+TEST(lagrange_base, lagrange_transcript_round_trip)
+{
+    constexpr size_t degree = 1 << 4;
+    std::vector<g1::affine_element> lagrange_base_srs(degree);
+    for (size_t i = 0; i < degree; ++i) {
+        lagrange_base_srs[i] = g1::affine_one * fr::random_element();
+    }
+
+    char dir_template[] = "/tmp/lagrange_transcript_XXXXXX";
+    const std::string dir = mkdtemp(dir_template);
+    const uint64_t transcript_hash = 0x0123456789abcdefULL;
+    const std::string path = io::get_lagrange_transcript_path(dir, degree, transcript_hash);
+
+    std::vector<g1::affine_element> result(degree);
+    EXPECT_FALSE(io::read_lagrange_transcript(&result[0], degree, dir, transcript_hash));
+    io::write_lagrange_transcript(&lagrange_base_srs[0], degree, dir, transcript_hash);
+    EXPECT_TRUE(io::read_lagrange_transcript(&result[0], degree, dir, transcript_hash));
+    EXPECT_EQ(result, lagrange_base_srs);
+
+    // A cache computed from another transcript is not used
+    EXPECT_FALSE(io::read_lagrange_transcript(&result[0], degree, dir, transcript_hash + 1));
+
+    // Nor is a corrupt one
+    {
+        std::fstream file(path, std::fstream::binary | std::fstream::in | std::fstream::out);
+        file.seekg(-1, std::fstream::end);
+        const char last_byte = (char)file.get();
+        file.seekp(-1, std::fstream::end);
+        file.put((char)(last_byte ^ 1));
+    }
+    EXPECT_FALSE(io::read_lagrange_transcript(&result[0], degree, dir, transcript_hash));
+    std::ofstream(path, std::ofstream::binary | std::ofstream::trunc).put(0);
+    EXPECT_FALSE(io::read_lagrange_transcript(&result[0], degree, dir, transcript_hash));
+
+    std::remove(path.c_str());
+    rmdir(dir.c_str());
+}
+
+TEST(lagrange_base, load_or_compute_lagrange_srs_caches_the_transform)
+{
+    constexpr size_t degree = 1 << 4;
+    char dir_template[] = "/tmp/lagrange_transcript_XXXXXX";
+    const std::string cache_dir = mkdtemp(dir_template);
+    const std::string path =
+        io::get_lagrange_transcript_path(cache_dir, degree, io::get_transcript_hash("../srs_db", degree));
+
+    std::vector<g1::affine_element> monomials(degree);
+    io::read_transcript_g1(&monomials[0], degree, "../srs_db");
+    std::vector<g1::affine_element> expected(degree);
+    lagrange_base::transform_srs(&monomials[0], &expected[0], degree);
+
+    // The first call computes the Lagrange base SRS and writes the cache
+    std::vector<g1::affine_element> computed(degree);
+    lagrange_base::load_or_compute_lagrange_srs(&computed[0], degree, "../srs_db", cache_dir);
+    EXPECT_EQ(computed, expected);
+    struct stat written;
+    ASSERT_EQ(stat(path.c_str(), &written), 0);
+
+    // The second reads it. A recomputed cache would be renamed into place as a new file.
+    std::vector<g1::affine_element> loaded(degree);
+    lagrange_base::load_or_compute_lagrange_srs(&loaded[0], degree, "../srs_db", cache_dir);
+    EXPECT_EQ(loaded, expected);
+    struct stat read;
+    ASSERT_EQ(stat(path.c_str(), &read), 0);
+    EXPECT_EQ(read.st_ino, written.st_ino);
+
+    std::remove(path.c_str());
+    rmdir(cache_dir.c_str());
+}
@@ -91,6 +91,39 @@ void native_pedersen_eight_hash_bench(State& state) noexcept
 }
 BENCHMARK(native_pedersen_eight_hash_bench)->MinTime(3);
 
+std::vector<std::pair<grumpkin::fq, grumpkin::fq>> get_pedersen_pairs(const size_t count)
+{
+    std::vector<std::pair<grumpkin::fq, grumpkin::fq>> pairs(count);
+    for (auto& pair : pairs) {
+        pair = { grumpkin::fq::random_element(), grumpkin::fq::random_element() };
+    }
+    return pairs;
+}
+
+void native_pedersen_pair_hash_bench(State& state) noexcept
+{
+    const auto pairs = get_pedersen_pairs(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        for (auto const& pair : pairs) {
+            DoNotOptimize(crypto::pedersen::compress_native({ pair.first, pair.second }));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(native_pedersen_pair_hash_bench)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+
+void native_pedersen_batch_hash_bench(State& state) noexcept
+{
+    const auto pairs = get_pedersen_pairs(static_cast<size_t>(state.range(0)));
+    // Build the window tables outside of the timed loop.
+    crypto::pedersen::compress_native_batch(std::span(pairs).first(1));
+    for (auto _ : state) {
+        DoNotOptimize(crypto::pedersen::compress_native_batch(pairs));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(native_pedersen_batch_hash_bench)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+
 void construct_pedersen_witnesses_bench(State& state) noexcept
 {
     for (auto _ : state) {
@@ -0,0 +1,509 @@
+#pragma once
+#ifndef __wasm__
+#include <common/throw_or_abort.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace plonk {
+namespace stdlib {
+namespace merkle_tree {
+
+/**
+ * A node store that appends nodes to fixed size, memory mapped segment files, as an alternative to LevelDbStore.
+ *
+ * An in memory index maps each key to the offset of its latest value, so a read is one copy out of the mapping rather
+ * than a search through the levels of an LSM tree. Writes are buffered until commit(), which appends them followed by
+ * a commit record holding a checksum of the batch, and syncs the segments to disk before returning. On open, the
+ * segments are replayed up to the last intact commit record and anything after it is discarded, so a crash part way
+ * through a commit loses only that commit.
+ *
+ * Overwritten and deleted values stay in the log until it is compacted. Once a commit leaves more dead bytes in the log
+ * than live ones (and at least a segment's worth), the live values are rewritten into fresh segments that replace the
+ * old ones, which bounds the store's disk use and the work of replaying the log on open.
+ */
+class FlatFileStore {
+  public:
+    static constexpr size_t DEFAULT_SEGMENT_SIZE = 64UL << 20;
+
+    FlatFileStore(std::string const& path, size_t segment_size = DEFAULT_SEGMENT_SIZE)
+        : path_(path)
+        , segment_size_(segment_size)
+    {
+        finish_compaction(path_);
+        mkdir(path_.c_str(), 0700);
+        while (map_segment(segments_.size(), false)) {
+        }
+        recover();
+    }
+
+    FlatFileStore(FlatFileStore const& other) = delete;
+    FlatFileStore& operator=(FlatFileStore const& other) = delete;
+
+    ~FlatFileStore() { close_segments(); }
+
+    static void destroy(std::string const& path)
+    {
+        remove_segments(path);
+        remove_segments(path + COMPACT_SUFFIX);
+        remove_segments(path + OLD_SUFFIX);
+    }
+
+    bool put(std::vector<uint8_t> const& key, std::vector<uint8_t> const& value)
+    {
+        auto key_str = to_string(key);
+        return put(key_str, value);
+    }
+
+    bool put(std::string const& key, std::vector<uint8_t> const& value)
+    {
+        puts_[key] = to_string(value);
+        deletes_.erase(key);
+        return true;
+    }
+
+    bool del(std::vector<uint8_t> const& key)
+    {
+        auto key_str = to_string(key);
+        puts_.erase(key_str);
+        deletes_.insert(key_str);
+        return true;
+    };
+
+    bool get(std::vector<uint8_t> const& key, std::vector<uint8_t>& value) { return get(to_string(key), value); }
+
+    bool get(std::string const& key, std::vector<uint8_t>& value)
+    {
+        if (deletes_.find(key) != deletes_.end()) {
+            return false;
+        }
+        auto it = puts_.find(key);
+        if (it != puts_.end()) {
+            value = std::vector<uint8_t>(it->second.begin(), it->second.end());
+            return true;
+        }
+        auto location = index_.find(key);
+        if (location == index_.end()) {
+            return false;
+        }
+        uint8_t const* data = segments_[location->second.segment].data + location->second.offset;
+        value = std::vector<uint8_t>(data, data + location->second.size);
+        return true;
+    }
+
+    void commit()
+    {
+        if (puts_.empty() && deletes_.empty()) {
+            return;
+        }
+        const size_t first_segment = end_.segment;
+        const size_t first_offset = end_.offset;
+
+        uint64_t checksum = CHECKSUM_INIT;
+        std::vector<std::pair<std::string const*, location>> locations;
+        locations.reserve(puts_.size());
+        for (auto const& it : puts_) {
+            locations.push_back({ &it.first, append(PUT, it.first, it.second, checksum) });
+        }
+        for (auto const& key : deletes_) {
+            append(DELETE, key, "", checksum);
+        }
+        append(COMMIT, "", std::string_view((char*)&checksum, sizeof(checksum)), checksum);
+        sync(first_segment, first_offset);
+
+        for (auto const& it : locations) {
+            set_location(*it.first, it.second);
+        }
+        for (auto const& key : deletes_) {
+            erase_location(key);
+        }
+        puts_.clear();
+        deletes_.clear();
+
+        const size_t dead_bytes = get_log_size() - live_bytes_;
+        if (dead_bytes > std::max(live_bytes_, segment_size_)) {
+            compact();
+        }
+    }
+
+    void rollback()
+    {
+        puts_.clear();
+        deletes_.clear();
+    }
+
+  private:
+    enum record_type : uint32_t { EMPTY = 0, PUT = 1, DELETE = 2, COMMIT = 3 };
+
+    struct record_header {
+        uint32_t type;
+        uint32_t key_size;
+        uint32_t value_size;
+    };
+
+    struct segment_header {
+        static constexpr uint64_t MAGIC = 0x31474553544c4642ULL; // "BFLTSEG1"
+        uint64_t magic;
+    };
+
+    struct segment {
+        int fd;
+        uint8_t* data;
+        size_t size;
+    };
+
+    struct location {
+        size_t segment;
+        size_t offset;
+        size_t size;
+    };
+
+    struct position {
+        size_t segment;
+        size_t offset;
+
+        // The number of bytes in use in segment `i`, if this is the end of the log.
+        size_t offset_in(size_t i, size_t segment_size) const { return i == segment ? offset : segment_size; }
+    };
+
+    // 64-bit FNV-1a. This detects torn or corrupted commits, it is not meant to be collision resistant.
+    static constexpr uint64_t CHECKSUM_INIT = 0xcbf29ce484222325ULL;
+
+    static uint64_t update_checksum(uint64_t hash, uint8_t const* data, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    // A compaction writes the new segments to the directory with this suffix, and moves the old segments to the one
+    // with OLD_SUFFIX while it swaps them in.
+    static constexpr char const* COMPACT_SUFFIX = ".compact";
+    static constexpr char const* OLD_SUFFIX = ".old";
+
+    static std::string get_segment_path(std::string const& path, size_t index)
+    {
+        return path + "/segment_" + std::to_string(index) + ".dat";
+    }
+
+    static size_t get_record_size(size_t key_size, size_t value_size)
+    {
+        return sizeof(record_header) + key_size + value_size;
+    }
+
+    static void remove_segments(std::string const& path)
+    {
+        for (size_t i = 0; unlink(get_segment_path(path, i).c_str()) == 0; ++i) {
+        }
+        rmdir(path.c_str());
+    }
+
+    static void sync_directory(std::string const& path)
+    {
+        int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY);
+        if (fd < 0 || fsync(fd) != 0) {
+            if (fd >= 0) {
+                close(fd);
+            }
+            throw_or_abort("Failed to sync directory: " + path);
+        }
+        close(fd);
+    }
+
+    static std::string get_parent_path(std::string const& path)
+    {
+        const size_t separator = path.find_last_of('/');
+        if (separator == std::string::npos) {
+            return ".";
+        }
+        return separator == 0 ? "/" : path.substr(0, separator);
+    }
+
+    /**
+     * Completes or discards a compaction that was interrupted. The new segments are only complete once the old ones
+     * have been moved out of the way, so if the store's directory is missing they are moved into place, and otherwise
+     * they are deleted.
+     */
+    static void finish_compaction(std::string const& path)
+    {
+        const std::string compact_path = path + COMPACT_SUFFIX;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0 && stat(compact_path.c_str(), &st) == 0) {
+            if (rename(compact_path.c_str(), path.c_str()) != 0) {
+                throw_or_abort("Failed to finish compacting flat file store: " + path);
+            }
+            sync_directory(get_parent_path(path));
+        }
+        remove_segments(compact_path);
+        remove_segments(path + OLD_SUFFIX);
+    }
+
+    /**
+     * Maps segment `index`, creating it if `create` is set. New segments are zero filled, which reads as an EMPTY
+     * record, i.e. the end of the segment's data. The header of a new segment is written and synced before the segment
+     * is used, so that a crash can at worst leave a trailing segment without one. Such a segment holds no committed
+     * records, and is deleted when the store is next opened.
+     */
+    bool map_segment(size_t index, bool create)
+    {
+        const std::string filename = get_segment_path(path_, index);
+        int fd = open(filename.c_str(), O_RDWR | (create ? O_CREAT | O_EXCL : 0), 0600);
+        if (fd < 0) {
+            if (create) {
+                throw_or_abort("Failed to create flat file store segment: " + filename);
+            }
+            return false;
+        }
+        size_t size = segment_size_;
+        struct stat st;
+        if (create ? ftruncate(fd, (off_t)size) != 0 : fstat(fd, &st) != 0) {
+            close(fd);
+            throw_or_abort("Failed to open flat file store segment: " + filename);
+        }
+        if (create) {
+            segment_header header{ segment_header::MAGIC };
+            if (pwrite(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) || fsync(fd) != 0) {
+                close(fd);
+                throw_or_abort("Failed to write flat file store segment header: " + filename);
+            }
+        } else {
+            size = (size_t)st.st_size;
+            segment_header header{ 0 };
+            if (size < sizeof(segment_header) || pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+                header.magic != segment_header::MAGIC) {
+                close(fd);
+                struct stat next;
+                if (stat(get_segment_path(path_, index + 1).c_str(), &next) == 0) {
+                    throw_or_abort("Not a flat file store segment: " + filename);
+                }
+                unlink(filename.c_str());
+                return false;
+            }
+        }
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            throw_or_abort("Failed to map flat file store segment: " + filename);
+        }
+        segments_.push_back({ fd, static_cast<uint8_t*>(data), size });
+        return true;
+    }
+
+    void close_segments()
+    {
+        for (auto& segment : segments_) {
+            munmap(segment.data, segment.size);
+            close(segment.fd);
+        }
+        segments_.clear();
+    }
+
+    /**
+     * Rebuilds the index from the committed records, and discards everything after the last commit record.
+     */
+    void recover()
+    {
+        end_ = { 0, sizeof(segment_header) };
+        if (segments_.empty()) {
+            map_segment(0, true);
+            return;
+        }
+
+        std::vector<std::pair<std::string, location>> batch;
+        uint64_t checksum = CHECKSUM_INIT;
+        bool corrupt = false;
+        for (size_t i = 0; i < segments_.size() && !corrupt; ++i) {
+            auto& segment = segments_[i];
+            size_t offset = sizeof(segment_header);
+            while (offset + sizeof(record_header) <= segment.size) {
+                record_header header;
+                std::memcpy(&header, segment.data + offset, sizeof(header));
+                if (header.type == EMPTY) {
+                    break;
+                }
+                const size_t record_size = sizeof(header) + header.key_size + header.value_size;
+                if (header.type > COMMIT || record_size > segment.size - offset) {
+                    corrupt = true;
+                    break;
+                }
+                uint8_t const* key = segment.data + offset + sizeof(header);
+                if (header.type == COMMIT) {
+                    if (header.value_size != sizeof(checksum) || std::memcmp(key, &checksum, sizeof(checksum)) != 0) {
+                        corrupt = true;
+                        break;
+                    }
+                    for (auto& it : batch) {
+                        if (it.second.segment == SIZE_MAX) {
+                            erase_location(it.first);
+                        } else {
+                            set_location(it.first, it.second);
+                        }
+                    }
+                    batch.clear();
+                    checksum = CHECKSUM_INIT;
+                    end_ = { i, offset + record_size };
+                } else {
+                    checksum = update_checksum(checksum, segment.data + offset, record_size);
+                    location value_location = { SIZE_MAX, 0, 0 };
+                    if (header.type == PUT) {
+                        value_location = { i, offset + sizeof(header) + header.key_size, header.value_size };
+                    }
+                    batch.push_back({ std::string((char const*)key, header.key_size), value_location });
+                }
+                offset += record_size;
+            }
+        }
+
+        // Zero the tail of the last committed segment, by shrinking and regrowing it, and drop any later segments.
+        auto& last = segments_[end_.segment];
+        if (ftruncate(last.fd, (off_t)end_.offset) != 0 || ftruncate(last.fd, (off_t)last.size) != 0) {
+            throw_or_abort("Failed to truncate flat file store segment: " + get_segment_path(path_, end_.segment));
+        }
+        while (segments_.size() > end_.segment + 1) {
+            munmap(segments_.back().data, segments_.back().size);
+            close(segments_.back().fd);
+            unlink(get_segment_path(path_, segments_.size() - 1).c_str());
+            segments_.pop_back();
+        }
+    }
+
+    /**
+     * Appends a record at the end of the log, starting a new segment if it does not fit in the current one.
+     * Returns the location of the record's value.
+     */
+    location append(record_type type, std::string_view key, std::string_view value, uint64_t& checksum)
+    {
+        const size_t record_size = get_record_size(key.size(), value.size());
+        if (record_size > segment_size_ - sizeof(segment_header)) {
+            throw_or_abort("Record too large for a flat file store segment.");
+        }
+        if (record_size > segments_[end_.segment].size - end_.offset) {
+            map_segment(segments_.size(), true);
+            end_ = { segments_.size() - 1, sizeof(segment_header) };
+        }
+
+        uint8_t* data = segments_[end_.segment].data + end_.offset;
+        record_header header{ type, (uint32_t)key.size(), (uint32_t)value.size() };
+        std::memcpy(data, &header, sizeof(header));
+        std::memcpy(data + sizeof(header), key.data(), key.size());
+        std::memcpy(data + sizeof(header) + key.size(), value.data(), value.size());
+        if (type != COMMIT) {
+            checksum = update_checksum(checksum, data, record_size);
+        }
+
+        location value_location = { end_.segment, end_.offset + sizeof(header) + key.size(), value.size() };
+        end_.offset += record_size;
+        return value_location;
+    }
+
+    // Syncs the log from the given segment and offset to its end.
+    void sync(size_t first_segment, size_t first_offset)
+    {
+        for (size_t i = first_segment; i <= end_.segment; ++i) {
+            const size_t start = (i == first_segment) ? first_offset & ~(size_t(getpagesize()) - 1) : 0;
+            msync(segments_[i].data + start, end_.offset_in(i, segments_[i].size) - start, MS_SYNC);
+        }
+    }
+
+    // The number of bytes from the start of the log to the end of the last committed record.
+    size_t get_log_size() const
+    {
+        size_t size = end_.offset;
+        for (size_t i = 0; i < end_.segment; ++i) {
+            size += segments_[i].size;
+        }
+        return size;
+    }
+
+    void set_location(std::string const& key, location const& value_location)
+    {
+        auto [it, inserted] = index_.try_emplace(key, value_location);
+        if (!inserted) {
+            live_bytes_ -= get_record_size(key.size(), it->second.size);
+            it->second = value_location;
+        }
+        live_bytes_ += get_record_size(key.size(), value_location.size);
+    }
+
+    void erase_location(std::string const& key)
+    {
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            live_bytes_ -= get_record_size(key.size(), it->second.size);
+            index_.erase(it);
+        }
+    }
+
+    /**
+     * Rewrites the live values as one commit into new segments, which replace the store's segments. The new segments
+     * are written and synced in a sibling directory, and swapped in by renaming the store's directory out of the way and
+     * the new one into its place. finish_compaction() completes or discards a compaction that a crash interrupted.
+     */
+    void compact()
+    {
+        const std::string compact_path = path_ + COMPACT_SUFFIX;
+        const std::string old_path = path_ + OLD_SUFFIX;
+        remove_segments(compact_path);
+
+        FlatFileStore compacted(compact_path, segment_size_);
+        uint64_t checksum = CHECKSUM_INIT;
+        for (auto const& it : index_) {
+            auto const& value = it.second;
+            const std::string_view data((char const*)segments_[value.segment].data + value.offset, value.size);
+            compacted.set_location(it.first, compacted.append(PUT, it.first, data, checksum));
+        }
+        compacted.append(COMMIT, "", std::string_view((char*)&checksum, sizeof(checksum)), checksum);
+        compacted.sync(0, 0);
+        sync_directory(compact_path);
+
+        const std::string parent_path = get_parent_path(path_);
+        if (rename(path_.c_str(), old_path.c_str()) != 0) {
+            throw_or_abort("Failed to compact flat file store: " + path_);
+        }
+        sync_directory(parent_path);
+        if (rename(compact_path.c_str(), path_.c_str()) != 0) {
+            throw_or_abort("Failed to compact flat file store: " + path_);
+        }
+        sync_directory(parent_path);
+
+        // The descriptors of the new segments remain valid after the rename, so they are taken over as they are.
+        close_segments();
+        std::swap(segments_, compacted.segments_);
+        std::swap(index_, compacted.index_);
+        end_ = compacted.end_;
+        live_bytes_ = compacted.live_bytes_;
+        remove_segments(old_path);
+    }
+
+    static std::string to_string(std::vector<uint8_t> const& input)
+    {
+        return std::string((char*)input.data(), input.size());
+    }
+
+    std::string path_;
+    size_t segment_size_;
+    std::vector<segment> segments_;
+    // The end of the last committed record.
+    position end_;
+    std::unordered_map<std::string, location> index_;
+    // The total size of the records of the values in `index_`
+    size_t live_bytes_ = 0;
+    std::map<std::string, std::string> puts_;
+    std::set<std::string> deletes_;
+};
+
+} // namespace merkle_tree
+} // namespace stdlib
+} // namespace plonk
+#endif
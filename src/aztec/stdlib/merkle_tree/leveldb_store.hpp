@@ -1,7 +1,10 @@
 #pragma once
 #ifndef __wasm__
 #include "hash_path.hpp"
+#include "node_cache.hpp"
+#include <atomic>
 #include <common/streams.hpp>
+#include <future>
 #include <leveldb/db.h>
 #include <leveldb/write_batch.h>
 #include <map>
@@ -18,9 +21,27 @@ inline std::string to_string(std::vector<uint8_t> const& input)
     return std::string((char*)input.data(), input.size());
 }
 
+/**
+ * Buffers the writes since the last commit in memory, and keeps recently read and written nodes in a NodeCache in
+ * front of the database.
+ *
+ * commit() hands the buffered writes to a background thread, which writes them to the database as one batch while
+ * the caller carries on. Until that write has finished, reads are served from the batch being written. Only one batch
+ * is written at a time: a commit waits for the previous one first, as do flush() and the destructor.
+ */
 class LevelDbStore {
   public:
-    LevelDbStore(std::string const& db_path)
+    static constexpr size_t DEFAULT_CACHE_SIZE = 256UL << 20;
+
+    struct Metrics {
+        size_t cache_hits;
+        size_t cache_misses;
+        size_t flushes;
+        size_t flushed_bytes;
+    };
+
+    LevelDbStore(std::string const& db_path, size_t cache_size = DEFAULT_CACHE_SIZE)
+        : cache_(cache_size)
     {
         leveldb::DB* db;
         leveldb::Options options;
@@ -31,6 +52,11 @@ class LevelDbStore {
         db_.reset(db);
     }
 
+    LevelDbStore(LevelDbStore const& other) = delete;
+    LevelDbStore& operator=(LevelDbStore const& other) = delete;
+
+    ~LevelDbStore() { flush(); }
+
     static void destroy(std::string path) { leveldb::DestroyDB(path, leveldb::Options()); }
 
     bool put(std::vector<uint8_t> const& key, std::vector<uint8_t> const& value)
@@ -65,26 +91,72 @@ class LevelDbStore {
         if (it != puts_.end()) {
             value = std::vector<uint8_t>(it->second.begin(), it->second.end());
             return true;
-        } else {
-            std::string result;
-            leveldb::Status status = db_->Get(ReadOptions(), key, &result);
+        }
+
+        // The batch being written in the background is newer than anything in the database.
+        if (flushing_deletes_.find(key) != flushing_deletes_.end()) {
+            return false;
+        }
+        it = flushing_puts_.find(key);
+        if (it != flushing_puts_.end()) {
+            value = std::vector<uint8_t>(it->second.begin(), it->second.end());
+            return true;
+        }
+
+        std::string result;
+        if (cache_.get(key, result)) {
+            ++cache_hits_;
             value = { result.begin(), result.end() };
-            return status.ok();
+            return true;
+        }
+        ++cache_misses_;
+        leveldb::Status status = db_->Get(ReadOptions(), key, &result);
+        if (status.ok()) {
+            cache_.put(key, result);
         }
+        value = { result.begin(), result.end() };
+        return status.ok();
     }
 
     void commit()
     {
-        leveldb::WriteBatch batch;
-        for (auto it : puts_) {
-            batch.Put(it.first, it.second);
+        flush();
+
+        // The nodes just written are the likeliest to be read next.
+        for (auto const& it : puts_) {
+            cache_.put(it.first, it.second);
         }
-        for (auto key : deletes_) {
-            batch.Delete(key);
+        for (auto const& key : deletes_) {
+            cache_.erase(key);
         }
-        db_->Write(leveldb::WriteOptions(), &batch);
-        puts_.clear();
-        deletes_.clear();
+
+        flushing_puts_.swap(puts_);
+        flushing_deletes_.swap(deletes_);
+        flush_ = std::async(std::launch::async, [this]() {
+            leveldb::WriteBatch batch;
+            size_t num_bytes = 0;
+            for (auto const& it : flushing_puts_) {
+                batch.Put(it.first, it.second);
+                num_bytes += it.first.size() + it.second.size();
+            }
+            for (auto const& key : flushing_deletes_) {
+                batch.Delete(key);
+                num_bytes += key.size();
+            }
+            db_->Write(leveldb::WriteOptions(), &batch);
+            ++flushes_;
+            flushed_bytes_ += num_bytes;
+        });
+    }
+
+    // Wait until everything committed so far has been written to the database.
+    void flush()
+    {
+        if (flush_.valid()) {
+            flush_.get();
+        }
+        flushing_puts_.clear();
+        flushing_deletes_.clear();
     }
 
     void rollback()
@@ -93,10 +165,20 @@ class LevelDbStore {
         deletes_.clear();
     }
 
+    Metrics get_metrics() const { return { cache_hits_, cache_misses_, flushes_, flushed_bytes_ }; }
+
   private:
     std::unique_ptr<leveldb::DB> db_;
     std::map<std::string, std::string> puts_;
     std::set<std::string> deletes_;
+    std::map<std::string, std::string> flushing_puts_;
+    std::set<std::string> flushing_deletes_;
+    std::future<void> flush_;
+    NodeCache cache_;
+    std::atomic<size_t> cache_hits_ = 0;
+    std::atomic<size_t> cache_misses_ = 0;
+    std::atomic<size_t> flushes_ = 0;
+    std::atomic<size_t> flushed_bytes_ = 0;
 };
 
 } // namespace merkle_tree
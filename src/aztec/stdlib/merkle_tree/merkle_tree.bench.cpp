@@ -1,3 +1,4 @@
+#include "flat_file_store.hpp"
 #include "hash.hpp"
 #include "leveldb_store.hpp"
 #include "merkle_tree.hpp"
@@ -14,7 +15,15 @@ auto& engine = numeric::random::get_debug_engine();
 
 constexpr size_t DEPTH = 256;
 constexpr size_t MAX = 4096;
-const std::string DB_PATH = "/tmp/leveldb_test";
+template <typename Store> std::string get_db_path();
+template <> std::string get_db_path<LevelDbStore>()
+{
+    return "/tmp/leveldb_test";
+}
+template <> std::string get_db_path<FlatFileStore>()
+{
+    return "/tmp/flat_file_test";
+}
 
 static std::vector<fr> VALUES = []() {
     std::vector<fr> values(MAX);
@@ -32,48 +41,123 @@ void hash(State& state) noexcept
 }
 BENCHMARK(hash)->MinTime(5);
 
-void update_first_element(State& state) noexcept
+template <typename Store> void update_first_element(State& state) noexcept
 {
-    LevelDbStore::destroy(DB_PATH);
-    LevelDbStore store(DB_PATH);
-    LevelDbTree db(store, DEPTH);
+    Store::destroy(get_db_path<Store>());
+    Store store(get_db_path<Store>());
+    MerkleTree<Store> db(store, DEPTH);
 
     for (auto _ : state) {
         db.update_element(0, VALUES[1]);
     }
 }
-BENCHMARK(update_first_element)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(update_first_element, LevelDbStore)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(update_first_element, FlatFileStore)->Unit(benchmark::kMillisecond);
 
-void update_elements(State& state) noexcept
+template <typename Store> void update_elements(State& state) noexcept
 {
     for (auto _ : state) {
         state.PauseTiming();
-        LevelDbStore::destroy(DB_PATH);
-        LevelDbStore store(DB_PATH);
-        LevelDbTree db(store, DEPTH);
+        Store::destroy(get_db_path<Store>());
+        Store store(get_db_path<Store>());
+        MerkleTree<Store> db(store, DEPTH);
         state.ResumeTiming();
         for (size_t i = 0; i < (size_t)state.range(0); ++i) {
             db.update_element(i, VALUES[i]);
         }
     }
 }
-BENCHMARK(update_elements)->Unit(benchmark::kMillisecond)->RangeMultiplier(2)->Range(256, MAX);
+BENCHMARK_TEMPLATE(update_elements, LevelDbStore)->Unit(benchmark::kMillisecond)->RangeMultiplier(2)->Range(256, MAX);
+BENCHMARK_TEMPLATE(update_elements, FlatFileStore)->Unit(benchmark::kMillisecond)->RangeMultiplier(2)->Range(256, MAX);
 
-void update_random_elements(State& state) noexcept
+template <typename Store> void batch_update_elements(State& state) noexcept
 {
     for (auto _ : state) {
         state.PauseTiming();
-        LevelDbStore::destroy(DB_PATH);
-        LevelDbStore store(DB_PATH);
-        LevelDbTree db(store, DEPTH);
+        Store::destroy(get_db_path<Store>());
+        Store store(get_db_path<Store>());
+        MerkleTree<Store> db(store, DEPTH);
+        std::vector<std::pair<typename MerkleTree<Store>::index_t, fr>> leaves;
+        for (size_t i = 0; i < (size_t)state.range(0); ++i) {
+            leaves.push_back({ i, VALUES[i] });
+        }
+        state.ResumeTiming();
+        db.update_elements(leaves);
+    }
+}
+BENCHMARK_TEMPLATE(batch_update_elements, LevelDbStore)
+    ->Unit(benchmark::kMillisecond)
+    ->RangeMultiplier(2)
+    ->Range(256, MAX);
+BENCHMARK_TEMPLATE(batch_update_elements, FlatFileStore)
+    ->Unit(benchmark::kMillisecond)
+    ->RangeMultiplier(2)
+    ->Range(256, MAX);
+
+template <typename Store> void update_random_elements(State& state) noexcept
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        Store::destroy(get_db_path<Store>());
+        Store store(get_db_path<Store>());
+        MerkleTree<Store> db(store, DEPTH);
         for (size_t i = 0; i < (size_t)state.range(0); i++) {
             state.PauseTiming();
-            auto index = LevelDbTree::index_t(engine.get_random_uint256());
+            auto index = typename MerkleTree<Store>::index_t(engine.get_random_uint256());
             state.ResumeTiming();
             db.update_element(index, VALUES[i]);
         }
     }
 }
-BENCHMARK(update_random_elements)->Unit(benchmark::kMillisecond)->Range(100, 100)->Iterations(1);
+BENCHMARK_TEMPLATE(update_random_elements, LevelDbStore)->Unit(benchmark::kMillisecond)->Range(100, 100)->Iterations(1);
+BENCHMARK_TEMPLATE(update_random_elements, FlatFileStore)
+    ->Unit(benchmark::kMillisecond)
+    ->Range(100, 100)
+    ->Iterations(1);
+
+template <typename Store> void batch_update_random_elements(State& state) noexcept
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        Store::destroy(get_db_path<Store>());
+        Store store(get_db_path<Store>());
+        MerkleTree<Store> db(store, DEPTH);
+        std::vector<std::pair<typename MerkleTree<Store>::index_t, fr>> leaves;
+        for (size_t i = 0; i < (size_t)state.range(0); i++) {
+            leaves.push_back({ typename MerkleTree<Store>::index_t(engine.get_random_uint256()), VALUES[i] });
+        }
+        state.ResumeTiming();
+        db.update_elements(leaves);
+    }
+}
+BENCHMARK_TEMPLATE(batch_update_random_elements, LevelDbStore)
+    ->Unit(benchmark::kMillisecond)
+    ->Range(100, 100)
+    ->Iterations(1);
+BENCHMARK_TEMPLATE(batch_update_random_elements, FlatFileStore)
+    ->Unit(benchmark::kMillisecond)
+    ->Range(100, 100)
+    ->Iterations(1);
+
+template <typename Store> void get_random_hash_paths(State& state) noexcept
+{
+    Store::destroy(get_db_path<Store>());
+    Store store(get_db_path<Store>());
+    MerkleTree<Store> db(store, DEPTH);
+    std::vector<typename MerkleTree<Store>::index_t> indices;
+    for (size_t i = 0; i < MAX; i++) {
+        indices.push_back(typename MerkleTree<Store>::index_t(engine.get_random_uint256()));
+        db.update_element(indices.back(), VALUES[i]);
+    }
+    // Read the paths back from the database rather than the store's write buffer.
+    store.commit();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        DoNotOptimize(db.get_hash_path(indices[i++ % MAX]));
+    }
+}
+BENCHMARK_TEMPLATE(get_random_hash_paths, LevelDbStore)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(get_random_hash_paths, FlatFileStore)->Unit(benchmark::kMicrosecond);
 
 BENCHMARK_MAIN();
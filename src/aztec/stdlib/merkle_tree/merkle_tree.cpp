@@ -1,9 +1,12 @@
 #include "merkle_tree.hpp"
+#include "flat_file_store.hpp"
 #include "hash.hpp"
 #include "leveldb_store.hpp"
 #include "memory_store.hpp"
+#include <algorithm>
 #include <common/net.hpp>
 #include <iostream>
+#include <numeric>
 #include <numeric/bitop/count_leading_zeros.hpp>
 #include <numeric/bitop/keep_n_lsb.hpp>
 #include <numeric/uint128/uint128.hpp>
@@ -20,6 +23,9 @@ template <typename T> inline bool bit_set(T const& index, size_t i)
     return bool((index >> i) & 0x1);
 }
 
+// Subtrees with fewer leaves to update than this are not worth handing to another thread
+constexpr size_t MIN_PARALLEL_UPDATE_SIZE = 32;
+
 template <typename Store>
 MerkleTree<Store>::MerkleTree(Store& store, size_t depth, uint8_t tree_id)
     : store_(store)
@@ -154,6 +160,126 @@ template <typename Store> fr MerkleTree<Store>::update_element(index_t index, fr
     return r;
 }
 
+template <typename Store>
+fr MerkleTree<Store>::update_elements(std::vector<std::pair<index_t, fr>> const& values)
+{
+    if (values.empty()) {
+        return root();
+    }
+
+    // Sort the elements by index, keeping only the last value written to each index. We sort positions rather than the
+    // elements themselves, as std::stable_sort's scratch buffer does not respect the alignment of fr.
+    std::vector<size_t> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&values](size_t lhs, size_t rhs) {
+        return values[lhs].first < values[rhs].first;
+    });
+    std::vector<std::pair<index_t, fr>> leaves;
+    leaves.reserve(values.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i + 1 == order.size() || values[order[i]].first != values[order[i + 1]].first) {
+            leaves.push_back(values[order[i]]);
+        }
+    }
+
+    using serialize::write;
+    for (auto const& leaf : leaves) {
+        std::vector<uint8_t> leaf_key;
+        write(leaf_key, tree_id_);
+        write(leaf_key, leaf.first);
+        store_.put(leaf_key, to_buffer(leaf.second));
+    }
+
+    fr r;
+    const fr old_root = root();
+#ifndef NO_MULTITHREADING
+#pragma omp parallel
+#pragma omp single
+#endif
+    r = update_elements(old_root, leaves.cbegin(), leaves.cend(), depth_);
+
+    std::vector<uint8_t> meta_key = { tree_id_ };
+    std::vector<uint8_t> meta_buf;
+    write(meta_buf, r);
+    write(meta_buf, values.back().first + 1);
+    store_.put(meta_key, meta_buf);
+
+    return r;
+}
+
+template <typename Store>
+fr MerkleTree<Store>::update_elements(fr const& root, leaf_iterator begin, leaf_iterator end, size_t height)
+{
+    if (end - begin == 1) {
+        return update_element(root, begin->second, numeric::keep_n_lsb(begin->first, height), height);
+    }
+
+    std::vector<uint8_t> data;
+    const bool status = get(root, data);
+
+    // Both subtrees are empty unless we find otherwise.
+    fr left = zero_hashes_[height - 1];
+    fr right = zero_hashes_[height - 1];
+    std::vector<std::pair<index_t, fr>> merged_leaves;
+    if (status && data.size() == 65) {
+        // We've come across a stump. Unless its element is being updated, it joins the elements we are inserting, and
+        // we rebuild the subtree as if it were empty.
+        index_t subtree_offset = begin->first - numeric::keep_n_lsb(begin->first, height);
+        index_t stump_index = subtree_offset + from_buffer<index_t>(data, 32);
+        auto it = std::lower_bound(
+            begin, end, stump_index, [](auto const& leaf, index_t const& index) { return leaf.first < index; });
+        if (it == end || it->first != stump_index) {
+            merged_leaves.reserve(static_cast<size_t>(end - begin) + 1);
+            merged_leaves.insert(merged_leaves.end(), begin, it);
+            merged_leaves.push_back({ stump_index, from_buffer<fr>(data, 0) });
+            merged_leaves.insert(merged_leaves.end(), it, end);
+            begin = merged_leaves.cbegin();
+            end = merged_leaves.cend();
+        }
+    } else if (status) {
+        // If its not a stump, the data size must be 64 bytes.
+        ASSERT(data.size() == 64);
+        left = from_buffer<fr>(data, 0);
+        right = from_buffer<fr>(data, 32);
+    }
+    const fr old_left = left;
+    const fr old_right = right;
+
+    // Elements in the left subtree come first, as they are sorted by index.
+    auto middle =
+        std::partition_point(begin, end, [height](auto const& leaf) { return !bit_set(leaf.first, height - 1); });
+
+    // The two subtrees are independent, so the left one is updated by another thread if there is enough work in both.
+    [[maybe_unused]] const bool parallel =
+        begin != middle && middle != end && static_cast<size_t>(end - begin) >= MIN_PARALLEL_UPDATE_SIZE;
+    if (begin != middle) {
+#ifndef NO_MULTITHREADING
+#pragma omp task shared(left) if (parallel)
+#endif
+        left = update_elements(left, begin, middle, height - 1);
+    }
+    if (middle != end) {
+        right = update_elements(right, middle, end, height - 1);
+    }
+#ifndef NO_MULTITHREADING
+#pragma omp taskwait
+#endif
+
+    auto new_root = compress_native(left, right);
+    put(new_root, left, right);
+
+    // Remove replaced nodes, as update_element does, unless the other subtree has just been rewritten to one of them.
+    if (status && data.size() == 64) {
+        if (!(old_left == left) && !(old_left == right)) {
+            remove(old_left);
+        }
+        if (!(old_right == right) && !(old_right == left)) {
+            remove(old_right);
+        }
+    }
+    return new_root;
+}
+
 template <typename Store> fr MerkleTree<Store>::binary_put(index_t a_index, fr const& a, fr const& b, size_t height)
 {
     bool a_is_right = bit_set(a_index, height - 1);
@@ -199,7 +325,7 @@ fr MerkleTree<Store>::update_element(fr const& root, fr const& value, index_t in
     }
 
     std::vector<uint8_t> data;
-    auto status = store_.get(root.to_buffer(), data);
+    auto status = get(root, data);
 
     if (!status) {
         fr key = compute_zero_path_hash(height, index, value);
@@ -266,11 +392,18 @@ template <typename Store> fr MerkleTree<Store>::compute_zero_path_hash(size_t he
     return current;
 }
 
+template <typename Store> bool MerkleTree<Store>::get(fr const& key, std::vector<uint8_t>& value)
+{
+    std::lock_guard<std::mutex> lock(store_mutex_);
+    return store_.get(key.to_buffer(), value);
+}
+
 template <typename Store> void MerkleTree<Store>::put(fr const& key, fr const& left, fr const& right)
 {
     std::vector<uint8_t> value;
     write(value, left);
     write(value, right);
+    std::lock_guard<std::mutex> lock(store_mutex_);
     store_.put(key.to_buffer(), value);
 }
 
@@ -281,16 +414,19 @@ template <typename Store> void MerkleTree<Store>::put_stump(fr const& key, index
     write(buf, index);
     // Add an additional byte, to signify we are a stump.
     write(buf, true);
+    std::lock_guard<std::mutex> lock(store_mutex_);
     store_.put(key.to_buffer(), buf);
 }
 
 template <typename Store> void MerkleTree<Store>::remove(fr const& key)
 {
+    std::lock_guard<std::mutex> lock(store_mutex_);
     store_.del(key.to_buffer());
 }
 
 #ifndef __wasm__
 template class MerkleTree<LevelDbStore>;
+template class MerkleTree<FlatFileStore>;
 #endif
 template class MerkleTree<MemoryStore>;
 
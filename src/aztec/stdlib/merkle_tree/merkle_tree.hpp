@@ -1,5 +1,6 @@
 #pragma once
 #include "hash_path.hpp"
+#include <mutex>
 #include <stdlib/primitives/field/field.hpp>
 
 namespace plonk {
@@ -9,6 +10,7 @@ namespace merkle_tree {
 using namespace barretenberg;
 
 class LevelDbStore;
+class FlatFileStore;
 class MemoryStore;
 
 template <typename Store> class MerkleTree {
@@ -24,6 +26,14 @@ template <typename Store> class MerkleTree {
 
     fr update_element(index_t index, fr const& value);
 
+    /**
+     * Updates several elements at once, with the same result as calling `update_element` on each (index, value) pair
+     * in turn. Each internal node on the paths of the updated elements is hashed once, rather than once per element
+     * below it, and disjoint subtrees are updated in parallel. All nodes are written to the store, which writes them
+     * to the database in a single batch when committed.
+     */
+    fr update_elements(std::vector<std::pair<index_t, fr>> const& values);
+
     fr root() const;
 
     size_t depth() const { return depth_; }
@@ -44,6 +54,17 @@ template <typename Store> class MerkleTree {
      */
     fr update_element(fr const& root, fr const& value, index_t index, size_t height);
 
+    typedef std::vector<std::pair<index_t, fr>>::const_iterator leaf_iterator;
+
+    /**
+     * Updates the elements in [begin, end) of the subtree of `height` with the given `root`, and returns its new root.
+     *
+     * @param begin, end: the (index, value) pairs to update, sorted by index and with unique indices
+     */
+    fr update_elements(fr const& root, leaf_iterator begin, leaf_iterator end, size_t height);
+
+    bool get(fr const& key, std::vector<uint8_t>& value);
+
     fr get_element(fr const& root, index_t index, size_t height);
 
     /**
@@ -94,12 +115,16 @@ template <typename Store> class MerkleTree {
     std::vector<fr> zero_hashes_;
     size_t depth_;
     uint8_t tree_id_;
+    // Serialises access to the store while subtrees are updated in parallel
+    std::mutex store_mutex_;
 };
 
 extern template class MerkleTree<LevelDbStore>;
+extern template class MerkleTree<FlatFileStore>;
 extern template class MerkleTree<MemoryStore>;
 
 typedef MerkleTree<LevelDbStore> LevelDbTree;
+typedef MerkleTree<FlatFileStore> FlatFileTree;
 
 } // namespace merkle_tree
 } // namespace stdlib
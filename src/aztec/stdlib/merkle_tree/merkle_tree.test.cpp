@@ -1,9 +1,11 @@
+#include "flat_file_store.hpp"
 #include "leveldb_store.hpp"
 #include "merkle_tree.hpp"
 #include "memory_store.hpp"
 #include "memory_tree.hpp"
 #include <common/streams.hpp>
 #include <common/test.hpp>
+#include <fstream>
 #include <numeric/random/engine.hpp>
 #include <stdlib/types/turbo.hpp>
 
@@ -79,6 +81,42 @@ TEST(stdlib_merkle_tree, test_size)
     EXPECT_EQ(db.size(), 3ULL);
 }
 
+TEST(stdlib_merkle_tree, test_update_elements_vs_update_element_consistency)
+{
+    constexpr size_t depth = 32;
+    MemoryStore store;
+    MerkleTree db(store, depth);
+    MemoryStore batch_store;
+    MerkleTree batch_db(batch_store, depth);
+
+    // Each round lands on the stumps and subtrees left by the previous ones, and writes some indices more than once.
+    std::vector<MerkleTree<MemoryStore>::index_t> indices;
+    for (size_t round = 0; round < 4; ++round) {
+        std::vector<std::pair<MerkleTree<MemoryStore>::index_t, fr>> values;
+        for (size_t i = 0; i < 128; ++i) {
+            auto index = MerkleTree<MemoryStore>::index_t(engine.get_random_uint32() & 0x3ff);
+            if (i % 4 == 0) {
+                index = MerkleTree<MemoryStore>::index_t(engine.get_random_uint32());
+            }
+            values.push_back({ index, fr::random_element() });
+            indices.push_back(index);
+        }
+        values.push_back(values[0]);
+        values.push_back({ values[1].first, fr::random_element() });
+
+        for (auto& value : values) {
+            db.update_element(value.first, value.second);
+        }
+        EXPECT_EQ(batch_db.update_elements(values), db.root());
+        EXPECT_EQ(batch_db.root(), db.root());
+        EXPECT_EQ(batch_db.size(), db.size());
+    }
+
+    for (auto index : indices) {
+        EXPECT_EQ(batch_db.get_hash_path(index), db.get_hash_path(index));
+    }
+}
+
 TEST(stdlib_merkle_tree, test_get_hash_path)
 {
     MemoryTree memdb(10);
@@ -191,4 +229,267 @@ TEST(stdlib_merkle_tree, test_leveldb_persistence)
 
     LevelDbStore::destroy(DB_PATH);
 }
-#endif
\ No newline at end of file
+
+TEST(stdlib_merkle_tree, test_leveldb_async_commit)
+{
+    LevelDbStore::destroy(DB_PATH);
+
+    fr root;
+    fr_hash_path path;
+    {
+        LevelDbStore store(DB_PATH);
+        LevelDbTree db(store, 32);
+        for (size_t i = 0; i < 8; ++i) {
+            db.update_element(i * 3, VALUES[i]);
+            // Keep updating the tree while the previous batch is written in the background.
+            store.commit();
+        }
+        root = db.root();
+        path = db.get_hash_path(21);
+        store.flush();
+
+        auto metrics = store.get_metrics();
+        EXPECT_EQ(metrics.flushes, 8ULL);
+        EXPECT_GT(metrics.flushed_bytes, 0ULL);
+    }
+    {
+        LevelDbStore store(DB_PATH);
+        LevelDbTree db(store, 32);
+
+        EXPECT_EQ(db.root(), root);
+        EXPECT_EQ(db.size(), 22ULL);
+        EXPECT_EQ(db.get_hash_path(21), path);
+
+        // The first read of each node goes to the database, a repeated read is served by the cache.
+        auto misses = store.get_metrics().cache_misses;
+        EXPECT_GT(misses, 0ULL);
+        EXPECT_EQ(db.get_hash_path(21), path);
+        EXPECT_EQ(store.get_metrics().cache_misses, misses);
+        EXPECT_GT(store.get_metrics().cache_hits, 0ULL);
+    }
+
+    LevelDbStore::destroy(DB_PATH);
+}
+
+std::string FLAT_FILE_PATH = format("/tmp/flat_file_test_", random_engine.get_random_uint128());
+
+TEST(stdlib_merkle_tree, test_flat_file_vs_memory_consistency)
+{
+    constexpr size_t depth = 10;
+    MemoryTree memdb(depth);
+
+    FlatFileStore::destroy(FLAT_FILE_PATH);
+    // Small segments, so the nodes are spread over several of them.
+    FlatFileStore store(FLAT_FILE_PATH, 1 << 16);
+    FlatFileTree db(store, depth);
+
+    std::vector<size_t> indicies(1 << depth);
+    std::iota(indicies.begin(), indicies.end(), 0);
+    std::random_device rd;
+    std::mt19937 g(rd());
+    std::shuffle(indicies.begin(), indicies.end(), g);
+
+    for (size_t i = 0; i < indicies.size(); ++i) {
+        size_t idx = indicies[i];
+        memdb.update_element(idx, VALUES[idx]);
+        db.update_element(idx, VALUES[idx]);
+        if (i % 64 == 0) {
+            store.commit();
+        }
+    }
+    store.commit();
+
+    for (size_t i = 0; i < indicies.size(); ++i) {
+        size_t idx = indicies[i];
+        EXPECT_EQ(db.get_hash_path(idx), memdb.get_hash_path(idx));
+    }
+
+    EXPECT_EQ(db.root(), memdb.root());
+
+    FlatFileStore::destroy(FLAT_FILE_PATH);
+}
+
+TEST(stdlib_merkle_tree, test_flat_file_persistence)
+{
+    FlatFileStore::destroy(FLAT_FILE_PATH);
+
+    fr root;
+    fr_hash_path path;
+    {
+        FlatFileStore store(FLAT_FILE_PATH);
+        FlatFileTree db(store, 256);
+        db.update_element(0, VALUES[1]);
+        db.update_element(1, VALUES[2]);
+        db.update_element(2, VALUES[3]);
+        root = db.root();
+        path = db.get_hash_path(2);
+        store.commit();
+
+        // Rolled back and uncommitted updates are not persisted.
+        db.update_element(3, VALUES[4]);
+        store.rollback();
+        EXPECT_EQ(db.root(), root);
+        db.update_element(4, VALUES[5]);
+    }
+    {
+        FlatFileStore store(FLAT_FILE_PATH);
+        FlatFileTree db(store, 256);
+
+        EXPECT_EQ(db.root(), root);
+        EXPECT_EQ(db.size(), 3ULL);
+        EXPECT_EQ(db.get_hash_path(2), path);
+    }
+
+    FlatFileStore::destroy(FLAT_FILE_PATH);
+}
+
+TEST(stdlib_merkle_tree, test_flat_file_torn_commit_recovery)
+{
+    FlatFileStore::destroy(FLAT_FILE_PATH);
+
+    fr root;
+    {
+        FlatFileStore store(FLAT_FILE_PATH);
+        FlatFileTree db(store, 32);
+        db.update_element(0, VALUES[1]);
+        db.update_element(1, VALUES[2]);
+        store.commit();
+        root = db.root();
+    }
+
+    // Simulate a crash part way through a commit, by writing a partial record after the last committed one.
+    {
+        std::string segment_path = FLAT_FILE_PATH + "/segment_0.dat";
+        std::vector<char> data(FlatFileStore::DEFAULT_SEGMENT_SIZE);
+        std::ifstream in(segment_path, std::ios::binary);
+        in.read(data.data(), (std::streamsize)data.size());
+        size_t end = data.size();
+        while (data[end - 1] == 0) {
+            --end;
+        }
+        std::fstream out(segment_path, std::ios::binary | std::ios::in | std::ios::out);
+        out.seekp((std::streamoff)end);
+        uint32_t partial_record[] = { 1, 32, 64, 0xdeadbeef };
+        out.write((char*)partial_record, sizeof(partial_record));
+    }
+
+    fr_hash_path path;
+    {
+        FlatFileStore store(FLAT_FILE_PATH);
+        FlatFileTree db(store, 32);
+        EXPECT_EQ(db.root(), root);
+        EXPECT_EQ(db.size(), 2ULL);
+
+        // The torn record has been discarded, so the log can be appended to again.
+        db.update_element(2, VALUES[3]);
+        store.commit();
+        root = db.root();
+        path = db.get_hash_path(2);
+    }
+    {
+        FlatFileStore store(FLAT_FILE_PATH);
+        FlatFileTree db(store, 32);
+        EXPECT_EQ(db.root(), root);
+        EXPECT_EQ(db.size(), 3ULL);
+        EXPECT_EQ(db.get_hash_path(2), path);
+    }
+
+    FlatFileStore::destroy(FLAT_FILE_PATH);
+}
+
+TEST(stdlib_merkle_tree, test_flat_file_headerless_segment_recovery)
+{
+    FlatFileStore::destroy(FLAT_FILE_PATH);
+
+    fr root;
+    {
+        FlatFileStore store(FLAT_FILE_PATH);
+        FlatFileTree db(store, 32);
+        db.update_element(0, VALUES[1]);
+        store.commit();
+        root = db.root();
+    }
+
+    // Simulate a crash after a new segment was created, but before its header reached the disk.
+    std::string segment_path = FLAT_FILE_PATH + "/segment_1.dat";
+    {
+        std::ofstream out(segment_path, std::ios::binary);
+        std::vector<char> zeroes(4096);
+        out.write(zeroes.data(), (std::streamsize)zeroes.size());
+    }
+
+    {
+        FlatFileStore store(FLAT_FILE_PATH);
+        FlatFileTree db(store, 32);
+        EXPECT_EQ(db.root(), root);
+        EXPECT_EQ(db.size(), 1ULL);
+        EXPECT_EQ(std::ifstream(segment_path).good(), false);
+
+        db.update_element(1, VALUES[2]);
+        store.commit();
+        root = db.root();
+    }
+    {
+        FlatFileStore store(FLAT_FILE_PATH);
+        FlatFileTree db(store, 32);
+        EXPECT_EQ(db.root(), root);
+        EXPECT_EQ(db.size(), 2ULL);
+    }
+
+    FlatFileStore::destroy(FLAT_FILE_PATH);
+}
+
+TEST(stdlib_merkle_tree, test_flat_file_compaction)
+{
+    FlatFileStore::destroy(FLAT_FILE_PATH);
+
+    constexpr size_t segment_size = 1 << 16;
+    const auto get_disk_use = []() {
+        size_t num_segments = 0;
+        while (std::ifstream(FLAT_FILE_PATH + "/segment_" + std::to_string(num_segments) + ".dat").good()) {
+            ++num_segments;
+        }
+        return num_segments * segment_size;
+    };
+
+    // Each update rewrites the 33 nodes on the leaf's path, about 3.5KB, so without compaction the log would grow to
+    // around 100 segments.
+    fr root;
+    fr_hash_path path;
+    size_t max_disk_use = 0;
+    {
+        FlatFileStore store(FLAT_FILE_PATH, segment_size);
+        FlatFileTree db(store, 32);
+        for (size_t i = 0; i < 2048; ++i) {
+            db.update_element(5, VALUES[i % 1024]);
+            store.commit();
+            max_disk_use = std::max(max_disk_use, get_disk_use());
+        }
+        root = db.root();
+        path = db.get_hash_path(5);
+    }
+    EXPECT_LE(max_disk_use, 4 * segment_size);
+
+    {
+        FlatFileStore store(FLAT_FILE_PATH, segment_size);
+        FlatFileTree db(store, 32);
+        EXPECT_EQ(db.root(), root);
+        EXPECT_EQ(db.get_hash_path(5), path);
+    }
+
+    // Simulate a crash between moving the old segments out of the way and the compacted ones into place.
+    EXPECT_EQ(rename(FLAT_FILE_PATH.c_str(), (FLAT_FILE_PATH + ".compact").c_str()), 0);
+    EXPECT_EQ(mkdir((FLAT_FILE_PATH + ".old").c_str(), 0700), 0);
+    {
+        FlatFileStore store(FLAT_FILE_PATH, segment_size);
+        FlatFileTree db(store, 32);
+        EXPECT_EQ(db.root(), root);
+        EXPECT_EQ(db.get_hash_path(5), path);
+    }
+    struct stat st;
+    EXPECT_NE(stat((FLAT_FILE_PATH + ".compact").c_str(), &st), 0);
+    EXPECT_NE(stat((FLAT_FILE_PATH + ".old").c_str(), &st), 0);
+
+    FlatFileStore::destroy(FLAT_FILE_PATH);
+}
+#endif
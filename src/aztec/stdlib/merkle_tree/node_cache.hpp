@@ -0,0 +1,95 @@
+#pragma once
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace plonk {
+namespace stdlib {
+namespace merkle_tree {
+
+/**
+ * A bounded cache of recently read tree nodes, for stores whose reads are expensive.
+ *
+ * Keys are spread over a number of shards by hash, each with its own lock, hash table and least recently used list, so
+ * lookups from different threads rarely contend. A shard evicts its least recently used nodes once their keys and
+ * values take up more than its share of the memory budget.
+ */
+class NodeCache {
+  public:
+    NodeCache(size_t max_bytes, size_t num_shards = 16)
+        : shards_(num_shards)
+        , max_shard_bytes_(max_bytes / num_shards)
+    {}
+
+    bool get(std::string const& key, std::string& value)
+    {
+        Shard& shard = get_shard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return false;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        value = it->second->second;
+        return true;
+    }
+
+    void put(std::string const& key, std::string const& value)
+    {
+        if (max_shard_bytes_ == 0) {
+            return;
+        }
+        Shard& shard = get_shard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            shard.bytes -= it->second->second.size();
+            it->second->second = value;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        } else {
+            shard.lru.emplace_front(key, value);
+            shard.entries[key] = shard.lru.begin();
+            shard.bytes += key.size();
+        }
+        shard.bytes += value.size();
+
+        while (shard.bytes > max_shard_bytes_) {
+            auto const& oldest = shard.lru.back();
+            shard.bytes -= oldest.first.size() + oldest.second.size();
+            shard.entries.erase(oldest.first);
+            shard.lru.pop_back();
+        }
+    }
+
+    void erase(std::string const& key)
+    {
+        Shard& shard = get_shard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            shard.bytes -= key.size() + it->second->second.size();
+            shard.lru.erase(it->second);
+            shard.entries.erase(it);
+        }
+    }
+
+  private:
+    struct Shard {
+        std::mutex mutex;
+        std::list<std::pair<std::string, std::string>> lru;
+        std::unordered_map<std::string, std::list<std::pair<std::string, std::string>>::iterator> entries;
+        size_t bytes = 0;
+    };
+
+    Shard& get_shard(std::string const& key) { return shards_[std::hash<std::string>{}(key) % shards_.size()]; }
+
+    std::vector<Shard> shards_;
+    size_t max_shard_bytes_;
+};
+
+} // namespace merkle_tree
+} // namespace stdlib
+} // namespace plonk